@@ -0,0 +1,157 @@
+/*
+  Copyright (c) 2015-2017 Lester Hedges <lester.hedges+slsm@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "slsm.h"
+
+/*! \file fast_sweeping.cpp
+
+    \brief A benchmark comparing the fast marching and fast sweeping methods.
+
+    For a range of mesh sizes and numbers of randomly placed holes, the
+    level set is initialised from the holes and the signed distance function
+    is scaled so that it is no longer a distance function. We then time
+    reinitialisation using the fast marching method and the (parallel) fast
+    sweeping method, reporting the number of sweep cycles, the speed-up, and
+    the maximum and mean difference between the two solutions within the
+    narrow band.
+
+    Usage:
+
+        fast_sweeping [repeats]
+
+    The default is 3 repeats of each solver. The number of threads used by
+    the fast sweeping method can be set with the OMP_NUM_THREADS environment
+    variable.
+ */
+
+// Return the elapsed wall-clock time in milliseconds.
+double elapsed(const std::chrono::steady_clock::time_point& start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Compare the solvers for a given mesh size and number of holes.
+void benchmark(unsigned int size, unsigned int nHoles, unsigned int repeats)
+{
+    // Initialise random number generator.
+    slsm::MersenneTwister rng;
+
+    // Place holes at random.
+    std::vector<slsm::Hole> holes;
+    for (unsigned int i=0;i<nHoles;i++)
+    {
+        double radius = size / (4.0 * sqrt(double(nHoles)));
+        holes.push_back(slsm::Hole(rng()*size, rng()*size, radius));
+    }
+
+    // Initialise the level set domain.
+    slsm::LevelSet levelSet(size, size, holes);
+
+    // Scale the signed distance function.
+    std::vector<double> initial = levelSet.signedDistance;
+    for (unsigned int i=0;i<initial.size();i++)
+        initial[i] *= 1.5;
+
+    // Initialise the solvers.
+    slsm::FastMarchingMethod fmm(levelSet.mesh);
+    slsm::FastSweepingMethod fsm(levelSet.mesh);
+
+    std::vector<double> marching;
+    std::vector<double> sweeping;
+    double tMarching = 0;
+    double tSweeping = 0;
+    unsigned int nCycles = 0;
+
+    for (unsigned int i=0;i<repeats;i++)
+    {
+        marching = initial;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        fmm.march(marching);
+        tMarching += elapsed(start);
+
+        sweeping = initial;
+        start = std::chrono::steady_clock::now();
+        nCycles = fsm.march(sweeping);
+        tSweeping += elapsed(start);
+    }
+
+    tMarching /= repeats;
+    tSweeping /= repeats;
+
+    // Compute the difference between the solutions within the narrow band.
+    double maxDiff = 0;
+    double meanDiff = 0;
+    unsigned int nBand = 0;
+    for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
+    {
+        if (std::abs(marching[i]) < 6)
+        {
+            double diff = std::abs(sweeping[i] - marching[i]);
+            maxDiff = std::max(maxDiff, diff);
+            meanDiff += diff;
+            nBand++;
+        }
+    }
+    if (nBand > 0) meanDiff /= nBand;
+
+    printf("%6u %6u %12.3f %12.3f %7u %10.2f %12.3e %12.3e\n", size, nHoles,
+        tMarching, tSweeping, nCycles, tMarching / tSweeping, maxDiff, meanDiff);
+}
+
+int main(int argc, char** argv)
+{
+    // Print git commit info, if present.
+#ifdef COMMIT
+    printf("Git commit: %s\n", COMMIT);
+#endif
+
+    // Print git branch info, if present.
+#ifdef BRANCH
+    printf("Git branch: %s\n", BRANCH);
+#endif
+
+    // Parse command-line arguments.
+    unsigned int repeats = (argc > 1) ? atoi(argv[1]) : 3;
+
+#ifdef _OPENMP
+    printf("Threads: %d, repeats: %u\n\n", omp_get_max_threads(), repeats);
+#else
+    printf("Threads: 1, repeats: %u\n\n", repeats);
+#endif
+
+    printf("%6s %6s %12s %12s %7s %10s %12s %12s\n", "Size", "Holes", "Marching", "Sweeping", "Cycles", "Speed-up", "Max diff", "Mean diff");
+    printf("%6s %6s %12s %12s %7s %10s %12s %12s\n", "", "", "(ms)", "(ms)", "", "", "", "");
+
+    unsigned int sizes[] = {250, 1000, 2000};
+    unsigned int holes[] = {1, 16, 256};
+
+    for (unsigned int i=0;i<3;i++)
+        for (unsigned int j=0;j<3;j++)
+            benchmark(sizes[i], holes[j], repeats);
+
+    return 0;
+}
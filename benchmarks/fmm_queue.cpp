@@ -0,0 +1,131 @@
+/*
+  Copyright (c) 2015-2017 Lester Hedges <lester.hedges+slsm@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "slsm.h"
+
+/*! \file fmm_queue.cpp
+
+    \brief A benchmark comparing priority queues for the fast marching method.
+
+    The level set is initialised with the default "Swiss cheese" structure,
+    then the signed distance function is scaled so that it is no longer a
+    distance function. We time reinitialisation using the fast marching method
+    with the binary heap and with the untidy (bucketed) priority queue for a
+    range of bucket widths. For the untidy queue we report the speed-up and
+    the maximum and mean absolute difference from the heap solution.
+
+    Usage:
+
+        fmm_queue [width] [height] [repeats]
+
+    The default is a 2000 x 2000 mesh with 5 repeats of each march.
+ */
+
+// Return the elapsed wall-clock time in milliseconds.
+double elapsed(const std::chrono::steady_clock::time_point& start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Time reinitialisation for a given priority queue.
+double benchmark(const slsm::Mesh& mesh, const std::vector<double>& initial, unsigned int repeats,
+    slsm::FMM_QueueType::FMM_QueueType queueType, double bucketWidth, std::vector<double>& signedDistance)
+{
+    // Initialise the fast marching method object.
+    slsm::FastMarchingMethod fmm(mesh, false, queueType, bucketWidth);
+
+    // Time reinitialisation, excluding the cost of restoring the initial
+    // signed distance function.
+    double time = 0;
+    for (unsigned int i=0;i<repeats;i++)
+    {
+        signedDistance = initial;
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        fmm.march(signedDistance);
+        time += elapsed(start);
+    }
+
+    return time / repeats;
+}
+
+int main(int argc, char** argv)
+{
+    // Print git commit info, if present.
+#ifdef COMMIT
+    printf("Git commit: %s\n", COMMIT);
+#endif
+
+    // Print git branch info, if present.
+#ifdef BRANCH
+    printf("Git branch: %s\n", BRANCH);
+#endif
+
+    // Parse command-line arguments.
+    unsigned int width   = (argc > 1) ? atoi(argv[1]) : 2000;
+    unsigned int height  = (argc > 2) ? atoi(argv[2]) : 2000;
+    unsigned int repeats = (argc > 3) ? atoi(argv[3]) : 5;
+
+    // Initialise the level set domain.
+    slsm::LevelSet levelSet(width, height);
+
+    // Scale the signed distance function.
+    std::vector<double> initial = levelSet.signedDistance;
+    for (unsigned int i=0;i<initial.size();i++)
+        initial[i] *= 1.5;
+
+    printf("Mesh: %u x %u, repeats: %u\n\n", width, height, repeats);
+    printf("%-8s %8s %12s %10s %12s %12s\n", "Queue", "Width", "Reinitialise", "Speed-up", "Max diff", "Mean diff");
+    printf("%-8s %8s %12s %10s %12s %12s\n", "", "", "(ms)", "", "", "");
+
+    // The reference solution.
+    std::vector<double> reference;
+    double tHeap = benchmark(levelSet.mesh, initial, repeats, slsm::FMM_QueueType::HEAP, 0, reference);
+
+    printf("%-8s %8s %12.3f %10.2f %12.3e %12.3e\n", "Heap", "-", tHeap, 1.0, 0.0, 0.0);
+
+    // The bucket widths.
+    double bucketWidths[] = {0.01, 0.05, 0.1, 0.25, 0.5, 1.0};
+
+    for (unsigned int i=0;i<6;i++)
+    {
+        std::vector<double> signedDistance;
+        double tUntidy = benchmark(levelSet.mesh, initial, repeats,
+            slsm::FMM_QueueType::UNTIDY, bucketWidths[i], signedDistance);
+
+        // Compute the difference from the reference solution.
+        double maxDiff = 0;
+        double meanDiff = 0;
+        for (unsigned int j=0;j<levelSet.mesh.nNodes;j++)
+        {
+            double diff = std::abs(signedDistance[j] - reference[j]);
+            maxDiff = std::max(maxDiff, diff);
+            meanDiff += diff;
+        }
+        meanDiff /= levelSet.mesh.nNodes;
+
+        printf("%-8s %8.2f %12.3f %10.2f %12.3e %12.3e\n", "Untidy",
+            bucketWidths[i], tUntidy, tHeap / tUntidy, maxDiff, meanDiff);
+    }
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+/*
+  Copyright (c) 2015-2017 Lester Hedges <lester.hedges+slsm@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "slsm.h"
+
+/*! \file mesh_ordering.cpp
+
+    \brief A benchmark comparing row-major and tiled node ordering.
+
+    The level set is initialised with the default "Swiss cheese" structure
+    on a wide mesh, for which the vertical stencils of the gradient and
+    fast marching kernels span a full row of nodes when using row-major
+    ordering. For each ordering we time boundary discretisation, computation
+    of the nodal gradients over the narrow band, and reinitialisation of the
+    signed distance function using the fast marching method.
+
+    Usage:
+
+        mesh_ordering [width] [height] [repeats]
+
+    The default is a 4000 x 200 mesh with 10 repeats of each kernel.
+ */
+
+// Return the elapsed wall-clock time in milliseconds.
+double elapsed(const std::chrono::steady_clock::time_point& start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Time the kernels for a given node ordering.
+void benchmark(unsigned int width, unsigned int height, unsigned int repeats,
+    slsm::NodeOrdering::NodeOrdering ordering, const char* name)
+{
+    // Initialise the level set domain.
+    slsm::LevelSet levelSet(width, height, 0.5, 6, false, false, ordering);
+
+    // Initialise the boundary object.
+    slsm::Boundary boundary;
+
+    // Time boundary discretisation.
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned int i=0;i<repeats;i++)
+        boundary.discretise(levelSet);
+    double tDiscretise = elapsed(start) / repeats;
+
+    // Assign a unit velocity to all boundary points.
+    levelSet.computeAreaFractions(boundary);
+    for (unsigned int i=0;i<boundary.nPoints;i++)
+        boundary.points[i].velocity = 1.0;
+    levelSet.computeVelocities(boundary.points);
+
+    // Time the gradient calculation.
+    start = std::chrono::steady_clock::now();
+    for (unsigned int i=0;i<repeats;i++)
+        levelSet.computeGradients();
+    double tGradient = elapsed(start) / repeats;
+
+    // Time reinitialisation.
+    start = std::chrono::steady_clock::now();
+    for (unsigned int i=0;i<repeats;i++)
+        levelSet.reinitialise();
+    double tReinitialise = elapsed(start) / repeats;
+
+    printf("%-10s %12.3f %12.3f %12.3f\n", name, tDiscretise, tGradient, tReinitialise);
+}
+
+int main(int argc, char** argv)
+{
+    // Print git commit info, if present.
+#ifdef COMMIT
+    printf("Git commit: %s\n", COMMIT);
+#endif
+
+    // Print git branch info, if present.
+#ifdef BRANCH
+    printf("Git branch: %s\n", BRANCH);
+#endif
+
+    // Parse command-line arguments.
+    unsigned int width   = (argc > 1) ? atoi(argv[1]) : 4000;
+    unsigned int height  = (argc > 2) ? atoi(argv[2]) : 200;
+    unsigned int repeats = (argc > 3) ? atoi(argv[3]) : 10;
+
+    printf("Mesh: %u x %u, repeats: %u\n\n", width, height, repeats);
+    printf("%-10s %12s %12s %12s\n", "Ordering", "Discretise", "Gradient", "Reinitialise");
+    printf("%-10s %12s %12s %12s\n", "", "(ms)", "(ms)", "(ms)");
+
+    benchmark(width, height, repeats, slsm::NodeOrdering::ROW_MAJOR, "Row-major");
+    benchmark(width, height, repeats, slsm::NodeOrdering::TILED, "Tiled");
+
+    return 0;
+}
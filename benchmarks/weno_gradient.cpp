@@ -0,0 +1,120 @@
+/*
+  Copyright (c) 2015-2017 Lester Hedges <lester.hedges+slsm@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "slsm.h"
+
+/*! \file weno_gradient.cpp
+
+    \brief A benchmark of the vectorised HJ-WENO gradient kernel.
+
+    We first time the scalar and vectorised fifth order Hamilton-Jacobi WENO
+    approximations on a set of random stencils and report the maximum
+    difference between the two. We then time the computation of the nodal
+    gradients over the narrow band for a level set initialised with the
+    default "Swiss cheese" structure.
+
+    Usage:
+
+        weno_gradient [width] [height] [repeats]
+
+    The default is a 1000 x 1000 mesh with 10 repeats of each kernel.
+ */
+
+// Return the elapsed wall-clock time in milliseconds.
+double elapsed(const std::chrono::steady_clock::time_point& start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+    // Print git commit info, if present.
+#ifdef COMMIT
+    printf("Git commit: %s\n", COMMIT);
+#endif
+
+    // Print git branch info, if present.
+#ifdef BRANCH
+    printf("Git branch: %s\n", BRANCH);
+#endif
+
+    // Parse command-line arguments.
+    unsigned int width   = (argc > 1) ? atoi(argv[1]) : 1000;
+    unsigned int height  = (argc > 2) ? atoi(argv[2]) : 1000;
+    unsigned int repeats = (argc > 3) ? atoi(argv[3]) : 10;
+
+    printf("Mesh: %u x %u, repeats: %u\n\n", width, height, repeats);
+
+    // Initialise random number generator.
+    slsm::MersenneTwister rng;
+
+    // Generate one random stencil per node, stored by stencil point.
+    unsigned int n = (width + 1) * (height + 1);
+    std::vector<std::vector<double> > v(5, std::vector<double>(n));
+    for (unsigned int i=0;i<5;i++)
+        for (unsigned int j=0;j<n;j++)
+            v[i][j] = 6*rng() - 3;
+
+    std::vector<double> scalar(n);
+    std::vector<double> vectorised(n);
+
+    // Time the scalar kernel.
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned int i=0;i<repeats;i++)
+        for (unsigned int j=0;j<n;j++)
+            scalar[j] = slsm::LevelSet::gradHJWENO(v[0][j], v[1][j], v[2][j], v[3][j], v[4][j]);
+    double tScalar = elapsed(start) / repeats;
+
+    // Time the vectorised kernel.
+    start = std::chrono::steady_clock::now();
+    for (unsigned int i=0;i<repeats;i++)
+        slsm::LevelSet::gradHJWENO(&v[0][0], &v[1][0], &v[2][0], &v[3][0], &v[4][0], &vectorised[0], n);
+    double tVectorised = elapsed(start) / repeats;
+
+    // Find the maximum difference between the two kernels.
+    double maxDiff = 0;
+    for (unsigned int i=0;i<n;i++)
+        maxDiff = std::max(maxDiff, std::abs(scalar[i] - vectorised[i]));
+
+    printf("%-12s %12s\n", "Kernel", "Time (ms)");
+    printf("%-12s %12.3f\n", "Scalar", tScalar);
+    printf("%-12s %12.3f\n", "Vectorised", tVectorised);
+    printf("\nSpeed-up: %.2f, maximum difference: %.3e\n", tScalar / tVectorised, maxDiff);
+
+    // Initialise the level set domain.
+    slsm::LevelSet levelSet(width, height);
+
+    // Assign a unit velocity to all nodes. The gradient kernel only
+    // depends on the sign of the velocity.
+    for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
+        levelSet.velocity[i] = 1.0;
+
+    // Time the gradient calculation.
+    start = std::chrono::steady_clock::now();
+    for (unsigned int i=0;i<repeats;i++)
+        levelSet.computeGradients();
+    double tGradient = elapsed(start) / repeats;
+
+    printf("\nNarrow band nodes: %u, gradient time (ms): %.3f\n", levelSet.nNarrowBand, tGradient);
+
+    return 0;
+}
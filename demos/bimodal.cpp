@@ -279,9 +279,9 @@ int main(int argc, char** argv)
         // Assign boundary point sensitivities.
         for (unsigned int i=0;i<boundary.points.size();i++)
         {
-            boundary.points[i].sensitivities[0] =
+            boundary.sensitivity(i, 0) =
                 sensitivity.computeSensitivity(boundary.points[i], callback);
-            boundary.points[i].sensitivities[1] =
+            boundary.sensitivity(i, 1) =
                 computeConstraintSensitivity(boundary.points[i].coord, levelSet);
         }
 
@@ -301,7 +301,7 @@ int main(int argc, char** argv)
         constraintDistances.push_back(meshArea*maxMismatch - mismatch);
 
         // Initialise the optimisation object.
-        slsm::Optimise optimise(boundary.points, constraintDistances,
+        slsm::Optimise optimise(boundary, constraintDistances,
             lambdas, timeStep, levelSet.moveLimit);
 
         // Perform the optimisation.
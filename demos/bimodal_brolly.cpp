@@ -356,9 +356,9 @@ int main(int argc, char** argv)
                 // Assign boundary point sensitivities.
                 for (unsigned int i=0;i<boundary.points.size();i++)
                 {
-                    boundary.points[i].sensitivities[0] =
+                    boundary.sensitivity(i, 0) =
                         sensitivity.computeSensitivity(boundary.points[i], callback);
-                    boundary.points[i].sensitivities[1] =
+                    boundary.sensitivity(i, 1) =
                         computeConstraintSensitivity(boundary.points[i].coord, levelSet);
                 }
 
@@ -389,7 +389,7 @@ int main(int argc, char** argv)
                 to place objects in the correct scope in order to aid readability
                 and to avoid unintended name clashes, etc.
                 */
-                slsm::Optimise optimise(boundary.points, constraintDistances,
+                slsm::Optimise optimise(boundary, constraintDistances,
                     lambdas, timeStep, levelSet.moveLimit, false);
 
                 // Perform the optimisation.
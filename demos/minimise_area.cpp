@@ -131,7 +131,7 @@ int main(int argc, char** argv)
     {
         // Assign boundary point sensitivities.
         for (unsigned int i=0;i<boundary.points.size();i++)
-            boundary.points[i].sensitivities[0] = 1.0;
+            boundary.sensitivity(i, 0) = 1.0;
 
         // Time step associated with the iteration.
         double timeStep;
@@ -141,7 +141,7 @@ int main(int argc, char** argv)
            Since there are no constraints we pass an empty vector for the
            constraint distances argument.
          */
-        slsm::Optimise optimise(boundary.points, std::vector<double>(),
+        slsm::Optimise optimise(boundary, std::vector<double>(),
             lambdas, timeStep, levelSet.moveLimit);
 
         // Perform the optimisation.
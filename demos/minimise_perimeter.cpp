@@ -149,10 +149,10 @@ int main(int argc, char** argv)
         // Assign boundary point sensitivities.
         for (unsigned int i=0;i<boundary.points.size();i++)
         {
-            boundary.points[i].sensitivities[0] =
+            boundary.sensitivity(i, 0) =
                 sensitivity.computeSensitivity(boundary.points[i], callback);
 
-            curvature += boundary.points[i].sensitivities[0];
+            curvature += boundary.sensitivity(i, 0);
         }
 
         // Compute mean curvature.
@@ -166,7 +166,7 @@ int main(int argc, char** argv)
            Since there are no constraints we pass an empty vector for the
            constraint distances argument.
          */
-        slsm::Optimise optimise(boundary.points, std::vector<double>(),
+        slsm::Optimise optimise(boundary, std::vector<double>(),
             lambdas, timeStep, levelSet.moveLimit);
 
         // Perform the optimisation.
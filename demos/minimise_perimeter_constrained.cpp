@@ -151,9 +151,9 @@ int main(int argc, char** argv)
         // Assign boundary point sensitivities.
         for (unsigned int i=0;i<boundary.points.size();i++)
         {
-            boundary.points[i].sensitivities[0] =
+            boundary.sensitivity(i, 0) =
                 sensitivity.computeSensitivity(boundary.points[i], callback);
-            boundary.points[i].sensitivities[1] = -1.0;
+            boundary.sensitivity(i, 1) = -1.0;
         }
 
         // Apply deterministic Ito correction.
@@ -169,7 +169,7 @@ int main(int argc, char** argv)
         constraintDistances.push_back(meshArea*maxArea - levelSet.area);
 
         // Initialise the optimisation object.
-        slsm::Optimise optimise(boundary.points, constraintDistances,
+        slsm::Optimise optimise(boundary, constraintDistances,
             lambdas, timeStep, levelSet.moveLimit);
 
         // Perform the optimisation.
@@ -176,7 +176,7 @@ int main(int argc, char** argv)
     {
         // Assign boundary point sensitivities.
         for (unsigned int i=0;i<boundary.points.size();i++)
-            boundary.points[i].sensitivities[0] = computeSensitivity(boundary.points[i].coord, levelSet);
+            boundary.sensitivity(i, 0) = computeSensitivity(boundary.points[i].coord, levelSet);
 
         // Initialise the sensitivity object.
         slsm::Sensitivity sensitivity;
@@ -188,7 +188,7 @@ int main(int argc, char** argv)
         double timeStep;
 
         // Initialise the optimisation object.
-        slsm::Optimise optimise(boundary.points, std::vector<double>(),
+        slsm::Optimise optimise(boundary, std::vector<double>(),
             lambdas, timeStep, levelSet.moveLimit);
 
         // Perform the optimisation.
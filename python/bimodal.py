@@ -396,9 +396,9 @@ while runningTime < maxTime:
 
     # Assign boundary point sensitivities.
     for i in range(0, len(boundary.points)):
-        boundary.points[i].sensitivities[0] = \
+        boundary.sensitivities[i, 0] = \
             sensitivity.computeSensitivity(boundary.points[i], cb.callback)
-        boundary.points[i].sensitivities[1] = \
+        boundary.sensitivities[i, 1] = \
             computeConstraintSensitivity(boundary.points[i].coord, levelSet)
 
     # Apply deterministic Ito correction.
@@ -417,7 +417,7 @@ while runningTime < maxTime:
     constraintDistances.append(meshArea*maxMismatch - mismatch)
 
     # Initialise the optimisation object.
-    optimise = pyslsm.Optimise(boundary.points, constraintDistances, \
+    optimise = pyslsm.Optimise(boundary, constraintDistances, \
         lambdas, timeStep, levelSet.moveLimit)
 
     # Perform the optimisation.
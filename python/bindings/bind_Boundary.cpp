@@ -21,16 +21,47 @@
 namespace py = pybind11;
 
 #include "Boundary.cpp"
+#include "Quadtree.cpp"
 
 using namespace slsm;
 
 PYBIND11_MAKE_OPAQUE(std::vector<BoundaryPoint>)
 
+// A mutable view of the boundary point sensitivity matrix, indexed by (point, function).
+struct BoundarySensitivities
+{
+    Boundary* boundary;
+};
+
 void bind_Boundary(py::module &m)
 {
     // STL containers.
     py::bind_vector<std::vector<BoundaryPoint>>(m, "VectorBoundaryPoint", py::module_local());
 
+    // Class definition.
+    py::class_<BoundarySensitivities>(m, "BoundarySensitivities", py::module_local(),
+        "A view of the boundary point sensitivities, indexed by (point, function).")
+
+        // Member functions.
+
+        .def("__getitem__", [](const BoundarySensitivities& view, py::tuple index)
+            {
+                unsigned int point = index[0].cast<unsigned int>();
+                unsigned int function = index[1].cast<unsigned int>();
+                if ((point >= view.boundary->nPoints) || (function >= view.boundary->nFunctions))
+                    throw py::index_error();
+                return view.boundary->sensitivity(point, function);
+            })
+
+        .def("__setitem__", [](BoundarySensitivities& view, py::tuple index, double value)
+            {
+                unsigned int point = index[0].cast<unsigned int>();
+                unsigned int function = index[1].cast<unsigned int>();
+                if ((point >= view.boundary->nPoints) || (function >= view.boundary->nFunctions))
+                    throw py::index_error();
+                view.boundary->sensitivity(point, function) = value;
+            });
+
     // Class definition.
     py::class_<BoundaryPoint>(m, "BoundaryPoint", py::module_local(),
         "A data structure for boundary point data.")
@@ -68,17 +99,19 @@ void bind_Boundary(py::module &m)
         .def_readonly("nSegments", &BoundaryPoint::nSegments,
             "The number of boundary segments that the point belongs to.")
 
-        .def_readonly("segments", &BoundaryPoint::segments,
-            "The indices of the two segments to which the point belongs.")
+        .def_property_readonly("segments",
+            [](const BoundaryPoint& point) { return std::vector<unsigned int>(point.segments, point.segments + point.nSegments); },
+            "The indices of the segments to which the point belongs.")
 
         .def_readonly("nNeighbours", &BoundaryPoint::nNeighbours,
             "The number of neighbouring boundary points.")
 
-        .def_readonly("neighbours", &BoundaryPoint::neighbours,
+        .def_property_readonly("neighbours",
+            [](const BoundaryPoint& point) { return std::vector<unsigned int>(point.neighbours, point.neighbours + point.nNeighbours); },
             "The indices of the neighbouring points.")
 
-        .def_readwrite("sensitivities", &BoundaryPoint::sensitivities,
-            "The objective and constraint sensitivities.");
+        .def_readonly("edge", &BoundaryPoint::edge,
+            "The mesh node or edge on which the point lies.");
 
     // Class definition.
     py::class_<BoundarySegment>(m, "BoundarySegment", py::module_local(),
@@ -111,7 +144,7 @@ void bind_Boundary(py::module &m)
 
         // Constructors.
 
-        .def(py::init<>(), "Default constructor.")
+        .def(py::init<unsigned int>(), "Constructor.", py::arg("nFunctions") = 2)
 
         // Member functions.
 
@@ -133,5 +166,12 @@ void bind_Boundary(py::module &m)
         .def_readonly("segments", &Boundary::segments, "The vector of boundary segments.")
         .def_readonly("nPoints", &Boundary::nPoints, "The number of boundary points.")
         .def_readonly("nSegments", &Boundary::nSegments, "The number of boundary segments.")
-        .def_readonly("length", &Boundary::length, "The total length of the boundary.");
+        .def_readonly("length", &Boundary::length, "The total length of the boundary.")
+        .def_readonly("nFunctions", &Boundary::nFunctions,
+            "The number of functions with sensitivities at each boundary point.")
+
+        .def_property_readonly("sensitivities",
+            py::cpp_function([](Boundary& boundary) { return BoundarySensitivities{&boundary}; },
+                py::keep_alive<0, 1>()),
+            "The objective and constraint sensitivities, indexed by (point, function).");
 }
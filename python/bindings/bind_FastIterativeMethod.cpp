@@ -0,0 +1,48 @@
+/*
+  Copyright (c) 2015-2017 Lester Hedges <lester.hedges+slsm@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl_bind.h>
+
+namespace py = pybind11;
+
+#include "FastIterativeMethod.cpp"
+
+using namespace slsm;
+
+void bind_FastIterativeMethod(py::module &m)
+{
+    // Class definition.
+    py::class_<FastIterativeMethod>(m, "FastIterativeMethod", py::module_local(),
+        "Find approximate solutions to the Eikonal equation using a parallel active list.")
+
+        // Constructors.
+
+        .def(py::init<const Mesh&, double>(),
+            "Constructor.", py::arg("mesh"), py::arg("tolerance") = 1e-10)
+
+        // Member functions.
+
+        .def("march", (unsigned int (FastIterativeMethod::*)(std::vector<double>&)) &FastIterativeMethod::march,
+            "Execute the Fast Iterative Method for reinitialisation of the signed distance function.",
+            py::arg("signedDistance"))
+
+        .def("march", (unsigned int (FastIterativeMethod::*)(std::vector<double>&,
+            std::vector<double>&)) &FastIterativeMethod::march,
+            "Execute the Fast Iterative Method for velocity extension.",
+            py::arg("signedDistance"), py::arg("velocity"));
+}
@@ -22,19 +22,28 @@ namespace py = pybind11;
 
 #include "FastMarchingMethod.cpp"
 #include "Heap.cpp"
+#include "UntidyQueue.cpp"
 
 using namespace slsm;
 
 void bind_FastMarchingMethod(py::module &m)
 {
+    // Enum definition.
+    py::enum_<FMM_QueueType::FMM_QueueType>(m, "FMM_QueueType", py::module_local(),
+        "The priority queue used to order trial nodes.")
+
+        .value("HEAP", FMM_QueueType::HEAP)
+        .value("UNTIDY", FMM_QueueType::UNTIDY);
+
     // Class definition.
     py::class_<FastMarchingMethod>(m, "FastMarchingMethod", py::module_local(),
         "Find approximate solitions to boundary value problems of the Eikonal equation.")
 
         // Constructors.
 
-        .def(py::init<const Mesh&, bool>(),
-            "Constructor.", py::arg("mesh"), py::arg("isTest") = false)
+        .def(py::init<const Mesh&, bool, FMM_QueueType::FMM_QueueType, double>(),
+            "Constructor.", py::arg("mesh"), py::arg("isTest") = false,
+            py::arg("queueType") = FMM_QueueType::HEAP, py::arg("bucketWidth") = 0.05)
 
         // Member functions.
 
@@ -33,44 +33,65 @@ void bind_LevelSet(py::module &m)
     py::bind_vector<std::vector<Coord>>(m, "VectorCoord", py::module_local());
     py::bind_vector<std::vector<Hole>>(m, "VectorHole", py::module_local());
 
+    // Enum definition.
+    py::enum_<EikonalSolver::EikonalSolver>(m, "EikonalSolver", py::module_local(),
+        "The method used to solve the Eikonal equation for reinitialisation and velocity extension.")
+
+        .value("FAST_MARCHING", EikonalSolver::FAST_MARCHING)
+        .value("FAST_SWEEPING", EikonalSolver::FAST_SWEEPING)
+        .value("FAST_ITERATIVE", EikonalSolver::FAST_ITERATIVE)
+        .value("CLOSEST_POINT", EikonalSolver::CLOSEST_POINT);
+
     // Class definition.
     py::class_<LevelSet>(m, "LevelSet", py::module_local(),
         "A two-dimensional level-set domain.")
 
         // Constructors.
 
-        .def(py::init<unsigned int, unsigned int, double, unsigned int, bool>(),
+        .def(py::init<unsigned int, unsigned int, double, unsigned int, bool, bool, NodeOrdering::NodeOrdering>(),
             "Constructor.", py::arg("width"), py::arg("height"),
             py::arg("moveLimit") = 0.5, py::arg("bandWidth") = 6,
-            py::arg("isFixedDomain") = false)
+            py::arg("isFixedDomain") = false,
+            py::arg("isImplicitMesh") = false,
+            py::arg("nodeOrdering") = NodeOrdering::ROW_MAJOR)
 
         .def(py::init<unsigned int, unsigned int, const std::vector<Hole>&, double,
-            unsigned int, bool>(), "Constructor.", py::arg("width"),
+            unsigned int, bool, bool, NodeOrdering::NodeOrdering>(), "Constructor.", py::arg("width"),
             py::arg("height"), py::arg("holes"), py::arg("moveLimit") = 0.5,
-            py::arg("bandWidth") = 6, py::arg("isFixedDomain") = false)
+            py::arg("bandWidth") = 6, py::arg("isFixedDomain") = false,
+            py::arg("isImplicitMesh") = false,
+            py::arg("nodeOrdering") = NodeOrdering::ROW_MAJOR)
 
         .def(py::init<unsigned int, unsigned int, const std::vector<Coord>&, double,
-            unsigned int, bool>(), "Constructor.", py::arg("width"),
+            unsigned int, bool, bool, NodeOrdering::NodeOrdering>(), "Constructor.", py::arg("width"),
             py::arg("height"), py::arg("points"), py::arg("moveLimit") = 0.5,
-            py::arg("bandWidth") = 6, py::arg("isFixedDomain") = false)
+            py::arg("bandWidth") = 6, py::arg("isFixedDomain") = false,
+            py::arg("isImplicitMesh") = false,
+            py::arg("nodeOrdering") = NodeOrdering::ROW_MAJOR)
 
         .def(py::init<unsigned int, unsigned int, const std::vector<Hole>&,
-            const std::vector<Hole>&, double, unsigned int, bool>(),
+            const std::vector<Hole>&, double, unsigned int, bool, bool, NodeOrdering::NodeOrdering>(),
             "Constructor.", py::arg("width"), py::arg("height"),
             py::arg("initialHoles"), py::arg("targetHoles"), py::arg("moveLimit") = 0.5,
-            py::arg("bandWidth") = 6, py::arg("isFixedDomain") = false)
+            py::arg("bandWidth") = 6, py::arg("isFixedDomain") = false,
+            py::arg("isImplicitMesh") = false,
+            py::arg("nodeOrdering") = NodeOrdering::ROW_MAJOR)
 
         .def(py::init<unsigned int, unsigned int, const std::vector<Hole>&,
-            const std::vector<Coord>&, double, unsigned int, bool>(),
+            const std::vector<Coord>&, double, unsigned int, bool, bool, NodeOrdering::NodeOrdering>(),
             "Constructor.", py::arg("width"), py::arg("height"),
             py::arg("initialHoles"), py::arg("targetPoints"), py::arg("moveLimit") = 0.5,
-            py::arg("bandWidth") = 6, py::arg("isFixedDomain") = false)
+            py::arg("bandWidth") = 6, py::arg("isFixedDomain") = false,
+            py::arg("isImplicitMesh") = false,
+            py::arg("nodeOrdering") = NodeOrdering::ROW_MAJOR)
 
         .def(py::init<unsigned int, unsigned int, const std::vector<Coord>&,
-            const std::vector<Coord>&, double, unsigned int, bool>(),
+            const std::vector<Coord>&, double, unsigned int, bool, bool, NodeOrdering::NodeOrdering>(),
             "Constructor.", py::arg("width"), py::arg("height"),
             py::arg("initialPoints"), py::arg("targetPoints"), py::arg("moveLimit") = 0.5,
-            py::arg("bandWidth") = 6, py::arg("isFixedDomain") = false)
+            py::arg("bandWidth") = 6, py::arg("isFixedDomain") = false,
+            py::arg("isImplicitMesh") = false,
+            py::arg("nodeOrdering") = NodeOrdering::ROW_MAJOR)
 
         // Member functions.
 
@@ -86,20 +107,26 @@ void bind_LevelSet(py::module &m)
             "Mask off a region of the domain.",
             py::arg("points"))
 
-        .def("reinitialise", &LevelSet::reinitialise,
+        .def("reinitialise", (void (LevelSet::*)()) &LevelSet::reinitialise,
             "Reinitialise the level set to a signed distance function.")
 
-        .def("computeVelocities", (void (LevelSet::*)(const std::vector<BoundaryPoint>&))
+        .def("reinitialise", (void (LevelSet::*)(const Boundary&)) &LevelSet::reinitialise,
+            "Reinitialise the level set to the signed distance from a discretised boundary.",
+            py::arg("boundary"))
+
+        .def("computeVelocities", (void (LevelSet::*)(const std::vector<BoundaryPoint>&, bool))
             &LevelSet::computeVelocities,
-            "Extend boundary point velocities to the level-set nodes.",
-            py::arg("boundaryPoints"))
+            "Extend boundary point velocities to the level-set nodes, optionally"
+            " reinitialising the signed distance function in the same pass.",
+            py::arg("boundaryPoints"), py::arg("isReinitialise") = false)
 
         .def("computeVelocities", (double (LevelSet::*)(std::vector<BoundaryPoint>&,
-            MutableFloat&, const double, MersenneTwister&)) &LevelSet::computeVelocities,
-            "Extend boundary point velocities to the level-set nodes."
+            MutableFloat&, const double, MersenneTwister&, bool)) &LevelSet::computeVelocities,
+            "Extend boundary point velocities to the level-set nodes, optionally"
+            " reinitialising the signed distance function in the same pass."
             " Returns the time step scaling factor.",
             py::arg("boundaryPoints"), py::arg("timeStep"), py::arg("temperature"),
-            py::arg("rng"))
+            py::arg("rng"), py::arg("isReinitialise") = false)
 
         .def("computeGradients", &LevelSet::computeGradients,
             "Compute the modulus of the gradient of the signed distance function.")
@@ -128,5 +155,20 @@ void bind_LevelSet(py::module &m)
             "The fixed-grid mesh.")
 
         .def_readonly("moveLimit", &LevelSet::moveLimit,
-            "The boundary movement limit (CFL condition).");
+            "The boundary movement limit (CFL condition).")
+
+        .def_readonly("nActiveBlocks", &LevelSet::nActiveBlocks,
+            "The number of mesh blocks intersecting the narrow band.")
+
+        .def_readwrite("isSparse", &LevelSet::isSparse,
+            "Whether to restrict updates to the active mesh blocks.")
+
+        .def_readwrite("eikonalSolver", &LevelSet::eikonalSolver,
+            "The method used to solve the Eikonal equation.")
+
+        .def_readwrite("isBandLimited", &LevelSet::isBandLimited,
+            "Whether fast marching reinitialisation stops beyond the narrow band.")
+
+        .def_readwrite("isReplay", &LevelSet::isReplay,
+            "Whether to replay the reinitialising march for velocity extension.");
 }
@@ -24,14 +24,14 @@ namespace py = pybind11;
 
 using namespace slsm;
 
-PYBIND11_MAKE_OPAQUE(std::vector<Element>)
-PYBIND11_MAKE_OPAQUE(std::vector<Node>)
-
 void bind_Mesh(py::module &m)
 {
-    // STL containers.
-    py::bind_vector<std::vector<Element>>(m, "VectorElement", py::module_local());
-    py::bind_vector<std::vector<Node>>(m, "VectorNode", py::module_local());
+    // Enum definition.
+    py::enum_<NodeOrdering::NodeOrdering>(m, "NodeOrdering", py::module_local(),
+        "The numbering scheme used for the mesh nodes.")
+
+        .value("ROW_MAJOR", NodeOrdering::ROW_MAJOR)
+        .value("TILED", NodeOrdering::TILED);
 
     // Class definition.
     py::class_<Element>(m, "Element", py::module_local(),
@@ -62,17 +62,47 @@ void bind_Mesh(py::module &m)
         .def_readonly("coord", &Node::coord,
             "The coordinates of the node.")
 
-        .def_readonly("neighbours", &Node::neighbours,
+        .def_property_readonly("neighbours",
+            [](const Node& node) { return std::vector<unsigned int>(node.neighbours, node.neighbours + 4); },
             "The indices of the neighbouring nodes.");
 
+    // Class definition.
+    py::class_<Mesh::NodeArray>(m, "NodeArray", py::module_local(),
+        "A read-only view of the nodes of the mesh.")
+
+        // Member functions.
+
+        .def("__getitem__", [](const Mesh::NodeArray& nodes, unsigned int index)
+            {
+                if (index >= nodes.size()) throw py::index_error();
+                return nodes[index];
+            })
+
+        .def("__len__", &Mesh::NodeArray::size);
+
+    // Class definition.
+    py::class_<Mesh::ElementArray>(m, "ElementArray", py::module_local(),
+        "A read-only view of the elements of the mesh.")
+
+        // Member functions.
+
+        .def("__getitem__", [](const Mesh::ElementArray& elements, unsigned int index)
+            {
+                if (index >= elements.size()) throw py::index_error();
+                return elements[index];
+            })
+
+        .def("__len__", &Mesh::ElementArray::size);
+
     // Class definition.
     py::class_<Mesh>(m, "Mesh", py::module_local(),
         "A two-dimensional fixed-grid mesh for the level-set domain.")
 
         // Constructors.
 
-        .def(py::init<unsigned int, unsigned int>(),
-            "Constructor.", py::arg("width"), py::arg("height"))
+        .def(py::init<unsigned int, unsigned int, bool, NodeOrdering::NodeOrdering>(),
+            "Constructor.", py::arg("width"), py::arg("height"),
+            py::arg("isImplicit") = false, py::arg("nodeOrdering") = NodeOrdering::ROW_MAJOR)
 
         // Member functions.
 
@@ -92,6 +122,10 @@ void bind_Mesh(py::module &m)
             "For a given coordinate, find the element that contains that point.",
             py::arg("x"), py::arg("y"))
 
+        .def("initialiseTiles", &Mesh::initialiseTiles,
+            "Partition the nodes into tiles for multi-threaded kernels.",
+            py::arg("tileWidth"), py::arg("tileHeight"), py::arg("haloWidth") = 3)
+
         // Member data.
 
         .def_readonly("nodes", &Mesh::nodes,
@@ -110,5 +144,18 @@ void bind_Mesh(py::module &m)
             "The number of elements in the mesh.")
 
         .def_readonly("nNodes", &Mesh::nNodes,
-            "The number of nodes in the mesh.");
+            "The number of nodes in the mesh.")
+
+        .def_readonly("isImplicit", &Mesh::isImplicit,
+            "Whether the mesh topology is computed on the fly.")
+
+        .def_readonly("nodeOrdering", &Mesh::nodeOrdering,
+            "The numbering scheme for the nodes.")
+
+        .def_readonly("nTiles", &Mesh::nTiles,
+            "The number of tiles used for domain decomposition.")
+
+        .def("xyToIndex", &Mesh::xyToIndex,
+            "Mapping between (x, y) coordinates and one dimensional node indices.",
+            py::arg("x"), py::arg("y"));
 }
@@ -32,9 +32,9 @@ void bind_Optimise(py::module &m)
 
         // Constructors.
 
-        .def(py::init<std::vector<BoundaryPoint>&, std::vector<double>&, std::vector<double>&,
+        .def(py::init<Boundary&, std::vector<double>&, std::vector<double>&,
             MutableFloat&, double, bool, const std::vector<bool>&>(), "Constructor.",
-            py::arg("boundaryPoints"), py::arg("constraindDistances"), py::arg("lambdas"),
+            py::arg("boundary"), py::arg("constraindDistances"), py::arg("lambdas"),
             py::arg("timeStep"), py::arg("maxDisplacement") = 0.5, py::arg("isMax") = false,
             py::arg("isEquality") = std::vector<bool>())
 
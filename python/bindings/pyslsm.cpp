@@ -26,7 +26,10 @@ PYBIND11_MAKE_OPAQUE(std::vector<double>)
 PYBIND11_MAKE_OPAQUE(std::vector<bool>)
 
 void bind_Boundary(py::module &);
+void bind_ClosestPointTransform(py::module &);
+void bind_FastIterativeMethod(py::module &);
 void bind_FastMarchingMethod(py::module &);
+void bind_FastSweepingMethod(py::module &);
 void bind_Hole(py::module &);
 void bind_InputOutput(py::module &);
 void bind_LevelSet(py::module &);
@@ -45,7 +48,10 @@ PYBIND11_MODULE(pyslsm, m)
 
     // Class bindings.
     bind_Boundary(m);
+    bind_ClosestPointTransform(m);
+    bind_FastIterativeMethod(m);
     bind_FastMarchingMethod(m);
+    bind_FastSweepingMethod(m);
     bind_Hole(m);
     bind_InputOutput(m);
     bind_LevelSet(m);
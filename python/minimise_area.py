@@ -108,7 +108,7 @@ while runningTime < maxTime:
 
     # Assign boundary point sensitivities.
     for i in range(0, len(boundary.points)):
-        boundary.points[i].sensitivities[0] = 1.0
+        boundary.sensitivities[i, 0] = 1.0
 
     # Time step associated with the iteration.
     timeStep = pyslsm.MutableFloat()
@@ -116,7 +116,7 @@ while runningTime < maxTime:
     # Initialise the optimisation object.
     #  Since there are no constraints we pass an empty vector for the
     #  constraint distances argument.
-    optimise = pyslsm.Optimise(boundary.points, pyslsm.VectorDouble(), \
+    optimise = pyslsm.Optimise(boundary, pyslsm.VectorDouble(), \
         lambdas, timeStep, moveLimit)
 
     # Perform the optimisation.
@@ -122,9 +122,9 @@ while runningTime < maxTime:
 
     # Assign boundary point sensitivities.
     for i in range(0, len(boundary.points)):
-        boundary.points[i].sensitivities[0] \
+        boundary.sensitivities[i, 0] \
             = sensitivity.computeSensitivity(boundary.points[i], cb.callback)
-        curvature += boundary.points[i].sensitivities[0]
+        curvature += boundary.sensitivities[i, 0]
 
     # Compute mean curvature.
     curvature /= len(boundary.points)
@@ -135,7 +135,7 @@ while runningTime < maxTime:
     # Initialise the optimisation object.
     #  Since there are no constraints we pass an empty vector for the
     #  constraint distances argument.
-    optimise = pyslsm.Optimise(boundary.points, pyslsm.VectorDouble(), \
+    optimise = pyslsm.Optimise(boundary, pyslsm.VectorDouble(), \
         lambdas, timeStep, moveLimit)
 
     # Perform the optimisation.
@@ -128,9 +128,9 @@ while runningTime < maxTime:
 
     # Assign boundary point sensitivities.
     for i in range(0, len(boundary.points)):
-        boundary.points[i].sensitivities[0] \
+        boundary.sensitivities[i, 0] \
             = sensitivity.computeSensitivity(boundary.points[i], cb.callback)
-        boundary.points[i].sensitivities[1] = -1.0
+        boundary.sensitivities[i, 1] = -1.0
 
     # Apply deterministic Ito correction.
     sensitivity.itoCorrection(boundary, temperature)
@@ -147,7 +147,7 @@ while runningTime < maxTime:
     # Initialise the optimisation object.
     #  Since there are no constraints we pass an empty vector for the
     #  constraint distances argument.
-    optimise = pyslsm.Optimise(boundary.points, constraintDistances, \
+    optimise = pyslsm.Optimise(boundary, constraintDistances, \
         lambdas, timeStep, moveLimit)
 
     # Perform the optimisation.
@@ -213,7 +213,7 @@ while runningTime < maxTime:
 
     # Assign boundary point sensitivities.
     for i in range(0, len(boundary.points)):
-        boundary.points[i].sensitivities[0] = computeSensitivity(boundary.points[i].coord, levelSet)
+        boundary.sensitivities[i, 0] = computeSensitivity(boundary.points[i].coord, levelSet)
 
     # Initialise the sensitivity object.
     sensitivity = pyslsm.Sensitivity()
@@ -225,7 +225,7 @@ while runningTime < maxTime:
     timeStep = pyslsm.MutableFloat()
 
     # Initialise the optimisation object.
-    optimise = pyslsm.Optimise(boundary.points, pyslsm.VectorDouble(), \
+    optimise = pyslsm.Optimise(boundary, pyslsm.VectorDouble(), \
         lambdas, timeStep, moveLimit)
 
     # Perform the optimisation.
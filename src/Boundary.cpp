@@ -15,9 +15,12 @@
   along with this program. If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include "Boundary.h"
+#include "Debug.h"
 #include "LevelSet.h"
 #include "Mesh.h"
 
@@ -27,6 +30,9 @@
 
 namespace slsm
 {
+    // Null entry flag, used to mark mesh edges without a boundary point.
+    static const unsigned int nullEntry = std::numeric_limits<unsigned int>::max();
+
     BoundaryPoint::BoundaryPoint() :
         length(0),
         velocity(0),
@@ -35,11 +41,14 @@ namespace slsm
         isDomain(false),
         isFixed(false),
         nSegments(0),
-        segments(2, 0),
         nNeighbours(0),
-        neighbours(2, 0),
-        sensitivities(2, 0)
+        edge(0)
     {
+        for (unsigned int i=0;i<4;i++)
+        {
+            segments[i] = 0;
+            neighbours[i] = 0;
+        }
     }
 
     BoundarySegment::BoundarySegment() :
@@ -50,17 +59,27 @@ namespace slsm
     {
     }
 
-    Boundary::Boundary()
+    Boundary::Boundary(unsigned int nFunctions_) :
+        nPoints(0),
+        nSegments(0),
+        length(0),
+        nFunctions(nFunctions_)
     {
+        // Check that there is at least an objective function.
+        errno = 0;
+        slsm_check(nFunctions > 0, "There must be at least one function.");
+
+        return;
+
+    error:
+        exit(EXIT_FAILURE);
     }
 
     void Boundary::discretise(LevelSet& levelSet, bool isTarget)
     {
-        // Clear and reserve vector memory.
+        // Clear vector memory. The vectors are sized when the strips are merged.
         points.clear();
         segments.clear();
-        points.reserve(levelSet.mesh.nNodes);
-        segments.reserve(levelSet.mesh.nNodes);
 
         // Reset the number of points and segments.
         nPoints = nSegments = 0;
@@ -77,14 +96,92 @@ namespace slsm
         // Point to the current signed distance function.
         else signedDistance = &levelSet.signedDistance;
 
+        // In sparse mode, the status is only updated for the active blocks,
+        // which contain all elements with a narrow band node.
+        bool isSparse = (levelSet.isSparse && !isTarget);
+
         // Compute the status of nodes and elements in level-set mesh.
-        computeMeshStatus(levelSet.mesh, signedDistance);
+        if (isSparse && levelSet.isFarFieldCurrent)
+            computeBlockStatus(levelSet);
+        else
+        {
+            computeMeshStatus(levelSet.mesh, signedDistance);
+
+            // The status outside of the active blocks is now current, unless it
+            // was computed for the target signed distance function.
+            levelSet.isFarFieldCurrent = isSparse;
+            levelSet.isFarFieldAreaCurrent = false;
+        }
+
+        // The elements are discretised in horizontal strips, one for each row
+        // of mesh tiles, in parallel. The strips are then merged so that the
+        // points and segments are numbered exactly as if the elements had
+        // been visited in ascending order, whatever the number of threads.
+        unsigned int stripHeight = levelSet.mesh.tileHeight;
+        unsigned int nStrips = (levelSet.mesh.height + stripHeight - 1) / stripHeight;
+        strips.resize(nStrips);
+
+        for (unsigned int i=0;i<nStrips;i++)
+        {
+            strips[i].yMin = i*stripHeight;
+            strips[i].yMax = std::min((i + 1)*stripHeight, levelSet.mesh.height);
+        }
+
+        // The target signed distance function has no narrow band, so the
+        // elements that may be cut are found using a quadtree.
+        if (isTarget) quadtree.build(levelSet.mesh, *signedDistance);
+
+        // The point lookup table is empty between calls, so it only needs
+        // to be initialised when the mesh changes.
+        if (pointTable.size() != 3*levelSet.mesh.nNodes)
+            pointTable.assign(3*levelSet.mesh.nNodes, nullEntry);
+
+        #pragma omp parallel for schedule(dynamic)
+        for (unsigned int i=0;i<nStrips;i++)
+            discretiseStrip(levelSet, signedDistance, strips[i], isTarget);
 
-        // Loop over all elements.
-        for (unsigned int i=0;i<levelSet.mesh.nElements;i++)
+        mergeStrips(levelSet.mesh);
+
+        // Zero the sensitivities, with a row of the matrix for each point.
+        sensitivities.assign(nPoints*nFunctions, 0);
+
+        // Work out boundary integral length associated with each boundary point.
+        computePointLengths();
+    }
+
+    void Boundary::discretiseStrip(LevelSet& levelSet, const std::vector<double>* signedDistance,
+        Strip& strip, bool isTarget)
+    {
+        // Reset the points and segments found by the strip.
+        strip.points.clear();
+        strip.segments.clear();
+        strip.nodes.clear();
+        strip.topNodes.clear();
+        strip.duplicates.clear();
+        strip.topPoints.resize(4*(levelSet.mesh.width + 1));
+        strip.nTopPoints.assign(levelSet.mesh.width + 1, 0);
+        strip.topTable.assign(2*(levelSet.mesh.width + 1), nullEntry);
+
+        // Only elements with a node in the narrow band, or a masked node, can
+        // be cut, so the remainder of the mesh is skipped. The target signed
+        // distance function has no narrow band, so the refined elements of
+        // the quadtree are visited instead.
+        const std::vector<unsigned int>& elements = isTarget ? quadtree.elements : levelSet.bandElements;
+
+        // Range of element indices in the strip.
+        unsigned int kMin = std::lower_bound(elements.begin(), elements.end(),
+            strip.yMin*levelSet.mesh.width) - elements.begin();
+        unsigned int kMax = std::lower_bound(elements.begin(), elements.end(),
+            strip.yMax*levelSet.mesh.width) - elements.begin();
+
+        // Loop over the elements (in ascending order).
+        for (unsigned int k=kMin;k<kMax;k++)
         {
+            // Element index.
+            unsigned int i = elements[k];
+
             // The element isn't outside of the structure.
-            if (levelSet.mesh.elements[i].status != ElementStatus::OUTSIDE)
+            if (levelSet.mesh.elementStatus[i] != ElementStatus::OUTSIDE)
             {
                 // Number of cut edges.
                 unsigned int nCut = 0;
@@ -97,52 +194,49 @@ namespace slsm
                 for (unsigned int j=0;j<4;j++)
                 {
                     // Index of first node on edge.
-                    unsigned int n1 = levelSet.mesh.elements[i].nodes[j];
+                    unsigned int n1 = levelSet.mesh.elementNode(i, j);
 
                     // Index of second node (reconnecting to 0th node).
                     // Edge connectivity goes: 0 --> 1, 1 --> 2, 2 --> 3, 3 --> 0
                     unsigned int n2 = (j == 3) ? 0 : (j + 1);
 
                     // Convert to node index.
-                    n2 = levelSet.mesh.elements[i].nodes[n2];
+                    n2 = levelSet.mesh.elementNode(i, n2);
 
                     // If not performing discretisation of a target structure check that at least
                     // one node lies in the narrow band region, or is masked.
                     if (isTarget                                                             ||
-                       (levelSet.mesh.nodes[n1].isActive | levelSet.mesh.nodes[n1].isMasked) ||
-                       (levelSet.mesh.nodes[n2].isActive | levelSet.mesh.nodes[n2].isMasked))
+                       (levelSet.mesh.isActive[n1] | levelSet.mesh.isMasked[n1]) ||
+                       (levelSet.mesh.isActive[n2] | levelSet.mesh.isMasked[n2]))
                     {
                         // One node is inside, the other is outside. The edge is cut.
-                        if ((levelSet.mesh.nodes[n1].status|levelSet.mesh.nodes[n2].status) == NodeStatus::CUT)
+                        if ((levelSet.mesh.nodeStatus[n1]|levelSet.mesh.nodeStatus[n2]) == NodeStatus::CUT)
                         {
                             // Compute the distance from node 1 to the intersection point (by interpolation).
                             double d = (*signedDistance)[n1]
                                      / ((*signedDistance)[n1] - (*signedDistance)[n2]);
 
-                            // Initialise boundary point coordinate.
-                            Coord coord;
+                            // Key of the mesh edge.
+                            unsigned int key = edgeKey(n1, n2, j);
 
                             // Make sure that the boundary point hasn't already been added.
-                            int index = isAdded(levelSet.mesh, coord, n1, j, d);
+                            int index = findPoint(levelSet.mesh, strip, key);
 
                             // Boundary point is new.
                             if (index < 0)
                             {
-                                levelSet.mesh.nodes[n1].boundaryPoints[levelSet.mesh.nodes[n1].nBoundaryPoints] = nPoints;
-                                levelSet.mesh.nodes[n2].boundaryPoints[levelSet.mesh.nodes[n2].nBoundaryPoints] = nPoints;
-                                levelSet.mesh.nodes[n1].nBoundaryPoints++;
-                                levelSet.mesh.nodes[n2].nBoundaryPoints++;
+                                unsigned int nPoints = strip.points.size();
+
+                                attachPoint(levelSet.mesh, strip, n1, nPoints);
+                                attachPoint(levelSet.mesh, strip, n2, nPoints);
 
                                 // Store boundary point for cut edge.
                                 boundaryPoints[nCut] = nPoints;
 
                                 // Initialise boundary point.
                                 BoundaryPoint point;
-                                initialisePoint(levelSet, point, coord);
-                                points.push_back(point);
-
-                                // Increment number of boundary points.
-                                nPoints++;
+                                initialisePoint(levelSet, point, edgeCoord(levelSet.mesh, n1, j, d));
+                                addPoint(levelSet.mesh, strip, point, key);
                             }
                             else
                             {
@@ -155,12 +249,9 @@ namespace slsm
                         }
 
                         // Both nodes lie on the boundary.
-                        else if ((levelSet.mesh.nodes[n1].status & NodeStatus::BOUNDARY) &&
-                                 (levelSet.mesh.nodes[n2].status & NodeStatus::BOUNDARY))
+                        else if ((levelSet.mesh.nodeStatus[n1] & NodeStatus::BOUNDARY) &&
+                                 (levelSet.mesh.nodeStatus[n2] & NodeStatus::BOUNDARY))
                         {
-                            // Initialise boundary point coordinate.
-                            Coord coord;
-
                             // Create boundary segment.
                             BoundarySegment segment;
 
@@ -168,66 +259,51 @@ namespace slsm
                             segment.element = i;
 
                             // Make sure that the start boundary point hasn't already been added.
-                            int index = isAdded(levelSet.mesh, coord, n1, 0, 0);
+                            int index = findPoint(levelSet.mesh, strip, 3*n1);
 
                             // Boundary point is new.
                             if (index < 0)
                             {
                                 // Set index equal to current number of points.
-                                index = nPoints;
+                                index = strip.points.size();
 
-                                levelSet.mesh.nodes[n1].boundaryPoints[levelSet.mesh.nodes[n1].nBoundaryPoints] = nPoints;
-                                levelSet.mesh.nodes[n1].nBoundaryPoints++;
+                                attachPoint(levelSet.mesh, strip, n1, index);
 
                                 // Initialise boundary point.
                                 BoundaryPoint point;
-                                initialisePoint(levelSet, point, coord);
-                                points.push_back(point);
-
-                                // Increment number of boundary points.
-                                nPoints++;
+                                initialisePoint(levelSet, point, levelSet.mesh.nodeCoord(n1));
+                                addPoint(levelSet.mesh, strip, point, 3*n1);
                             }
 
                             // Assign start point index.
                             segment.start = index;
 
                             // Make sure that the end boundary point hasn't already been added.
-                            index = isAdded(levelSet.mesh, coord, n2, 0, 0);
+                            index = findPoint(levelSet.mesh, strip, 3*n2);
 
                             // Boundary point is new.
                             if (index < 0)
                             {
                                 // Set index equal to current number of points.
-                                index = nPoints;
+                                index = strip.points.size();
 
-                                levelSet.mesh.nodes[n2].boundaryPoints[levelSet.mesh.nodes[n2].nBoundaryPoints] = nPoints;
-                                levelSet.mesh.nodes[n2].nBoundaryPoints++;
+                                attachPoint(levelSet.mesh, strip, n2, index);
 
                                 // Initialise boundary point.
                                 BoundaryPoint point;
-                                initialisePoint(levelSet, point, coord);
-                                points.push_back(point);
-
-                                // Increment number of boundary points.
-                                nPoints++;
+                                initialisePoint(levelSet, point, levelSet.mesh.nodeCoord(n2));
+                                addPoint(levelSet.mesh, strip, point, 3*n2);
                             }
 
                             // Assign end point index.
                             segment.end = index;
 
-                            // Compute the length of the boundary segment.
-                            segment.length = segmentLength(segment);
-
-                            // Update total boundary length.
-                            length += segment.length;
-
                             // Create element to segment lookup.
-                            levelSet.mesh.elements[i].boundarySegments[levelSet.mesh.elements[i].nBoundarySegments] = nSegments;
-                            levelSet.mesh.elements[i].nBoundarySegments++;
+                            levelSet.mesh.boundarySegments[2*i + levelSet.mesh.nBoundarySegments[i]] = strip.segments.size();
+                            levelSet.mesh.nBoundarySegments[i]++;
 
                             // Add segment to vector.
-                            segments.push_back(segment);
-                            nSegments++;
+                            strip.segments.push_back(segment);
                         }
                     }
                 }
@@ -243,19 +319,12 @@ namespace slsm
                     segment.end = boundaryPoints[1];
                     segment.element = i;
 
-                    // Compute the length of the boundary segment.
-                    segment.length = segmentLength(segment);
-
-                    // Update total boundary length.
-                    length += segment.length;
-
                     // Create element to segment lookup.
-                    levelSet.mesh.elements[i].boundarySegments[levelSet.mesh.elements[i].nBoundarySegments] = nSegments;
-                    levelSet.mesh.elements[i].nBoundarySegments++;
+                    levelSet.mesh.boundarySegments[2*i + levelSet.mesh.nBoundarySegments[i]] = strip.segments.size();
+                    levelSet.mesh.nBoundarySegments[i]++;
 
                     // Add segment to vector.
-                    segments.push_back(segment);
-                    nSegments++;
+                    strip.segments.push_back(segment);
                 }
 
                 // If there is only one cut edge, then the boundary must also cross an element node.
@@ -265,10 +334,10 @@ namespace slsm
                     for (unsigned int j=0;j<4;j++)
                     {
                         // Node index.
-                        unsigned int node = levelSet.mesh.elements[i].nodes[j];
+                        unsigned int node = levelSet.mesh.elementNode(i, j);
 
                         // Node is on the boundary, check its neighbours.
-                        if (levelSet.mesh.nodes[node].status & NodeStatus::BOUNDARY)
+                        if (levelSet.mesh.nodeStatus[node] & NodeStatus::BOUNDARY)
                         {
                             // Index of next node.
                             unsigned int nAfter = (j == 3) ? 0 : (j + 1);
@@ -277,58 +346,44 @@ namespace slsm
                             unsigned int nBefore = (j == 0) ? 3 : (j - 1);
 
                             // Convert to node indices.
-                            nAfter = levelSet.mesh.elements[i].nodes[nAfter];
-                            nBefore = levelSet.mesh.elements[i].nodes[nBefore];
+                            nAfter = levelSet.mesh.elementNode(i, nAfter);
+                            nBefore = levelSet.mesh.elementNode(i, nBefore);
 
                             // If a neighbour is outside the boundary, then add a boundary segment.
-                            if ((levelSet.mesh.nodes[nAfter].status & NodeStatus::OUTSIDE) ||
-                                (levelSet.mesh.nodes[nBefore].status & NodeStatus::OUTSIDE))
+                            if ((levelSet.mesh.nodeStatus[nAfter] & NodeStatus::OUTSIDE) ||
+                                (levelSet.mesh.nodeStatus[nBefore] & NodeStatus::OUTSIDE))
                             {
                                 // Create boundary segment.
                                 BoundarySegment segment;
                                 segment.start = boundaryPoints[0];
                                 segment.element = i;
 
-                                // Initialise boundary point coordinate.
-                                Coord coord;
-
                                 // Make sure that the end boundary point hasn't already been added.
-                                int index = isAdded(levelSet.mesh, coord, node, 0, 0);
+                                int index = findPoint(levelSet.mesh, strip, 3*node);
 
                                 // Boundary point is new.
                                 if (index < 0)
                                 {
                                     // Set index equal to current number of points.
-                                    index = nPoints;
+                                    index = strip.points.size();
 
-                                    levelSet.mesh.nodes[node].boundaryPoints[levelSet.mesh.nodes[node].nBoundaryPoints] = nPoints;
-                                    levelSet.mesh.nodes[node].nBoundaryPoints++;
+                                    attachPoint(levelSet.mesh, strip, node, index);
 
                                     // Initialise boundary point.
                                     BoundaryPoint point;
-                                    initialisePoint(levelSet, point, coord);
-                                    points.push_back(point);
-
-                                    // Increment number of boundary points.
-                                    nPoints++;
+                                    initialisePoint(levelSet, point, levelSet.mesh.nodeCoord(node));
+                                    addPoint(levelSet.mesh, strip, point, 3*node);
                                 }
 
                                 // Assign end point index.
                                 segment.end = index;
 
-                                // Compute the length of the boundary segment.
-                                segment.length = segmentLength(segment);
-
-                                // Update total boundary length.
-                                length += segment.length;
-
                                 // Create element to segment lookup.
-                                levelSet.mesh.elements[i].boundarySegments[levelSet.mesh.elements[i].nBoundarySegments] = nSegments;
-                                levelSet.mesh.elements[i].nBoundarySegments++;
+                                levelSet.mesh.boundarySegments[2*i + levelSet.mesh.nBoundarySegments[i]] = strip.segments.size();
+                                levelSet.mesh.nBoundarySegments[i]++;
 
                                 // Add segment to vector.
-                                segments.push_back(segment);
-                                nSegments++;
+                                strip.segments.push_back(segment);
                             }
                         }
                     }
@@ -344,7 +399,7 @@ namespace slsm
                     for (unsigned int j=0;j<4;j++)
                     {
                         // Node index.
-                        unsigned int node = levelSet.mesh.elements[i].nodes[j];
+                        unsigned int node = levelSet.mesh.elementNode(i, j);
 
                         lsfSum += (*signedDistance)[node];
                     }
@@ -353,8 +408,8 @@ namespace slsm
                     BoundarySegment segment;
 
                     // Store the status of the first node.
-                    unsigned int node = levelSet.mesh.elements[i].nodes[0];
-                    NodeStatus::NodeStatus status = levelSet.mesh.nodes[node].status;
+                    unsigned int node = levelSet.mesh.elementNode(i, 0);
+                    NodeStatus::NodeStatus status = levelSet.mesh.nodeStatus[node];
 
                     if (((status & NodeStatus::INSIDE) && (lsfSum > 0))  ||
                         ((status & NodeStatus::OUTSIDE) && (lsfSum < 0)))
@@ -363,37 +418,23 @@ namespace slsm
                         segment.end = boundaryPoints[1];
                         segment.element = i;
 
-                        // Compute the length of the boundary segment.
-                        segment.length = segmentLength(segment);
-
-                        // Update total boundary length.
-                        length += segment.length;
-
                         // Create element to segment lookup.
-                        levelSet.mesh.elements[i].boundarySegments[levelSet.mesh.elements[i].nBoundarySegments] = nSegments;
-                        levelSet.mesh.elements[i].nBoundarySegments++;
+                        levelSet.mesh.boundarySegments[2*i + levelSet.mesh.nBoundarySegments[i]] = strip.segments.size();
+                        levelSet.mesh.nBoundarySegments[i]++;
 
                         // Add segment to vector.
-                        segments.push_back(segment);
-                        nSegments++;
+                        strip.segments.push_back(segment);
 
                         segment.start = boundaryPoints[2];
                         segment.end = boundaryPoints[3];
                         segment.element = i;
 
-                        // Compute the length of the boundary segment.
-                        segment.length = segmentLength(segment);
-
-                        // Update total boundary length.
-                        length += segment.length;
-
                         // Create element to segment lookup.
-                        levelSet.mesh.elements[i].boundarySegments[levelSet.mesh.elements[i].nBoundarySegments] = nSegments;
-                        levelSet.mesh.elements[i].nBoundarySegments++;
+                        levelSet.mesh.boundarySegments[2*i + levelSet.mesh.nBoundarySegments[i]] = strip.segments.size();
+                        levelSet.mesh.nBoundarySegments[i]++;
 
                         // Add segment to vector.
-                        segments.push_back(segment);
-                        nSegments++;
+                        strip.segments.push_back(segment);
                     }
 
                     else
@@ -402,46 +443,32 @@ namespace slsm
                         segment.end = boundaryPoints[3];
                         segment.element = i;
 
-                        // Compute the length of the boundary segment.
-                        segment.length = segmentLength(segment);
-
-                        // Update total boundary length.
-                        length += segment.length;
-
                         // Create element to segment lookup.
-                        levelSet.mesh.elements[i].boundarySegments[levelSet.mesh.elements[i].nBoundarySegments] = nSegments;
-                        levelSet.mesh.elements[i].nBoundarySegments++;
+                        levelSet.mesh.boundarySegments[2*i + levelSet.mesh.nBoundarySegments[i]] = strip.segments.size();
+                        levelSet.mesh.nBoundarySegments[i]++;
 
                         // Add segment to vector.
-                        segments.push_back(segment);
-                        nSegments++;
+                        strip.segments.push_back(segment);
 
                         segment.start = boundaryPoints[1];
                         segment.end = boundaryPoints[2];
                         segment.element = i;
 
-                        // Compute the length of the boundary segment.
-                        segment.length = segmentLength(segment);
-
-                        // Update total boundary length.
-                        length += segment.length;
-
                         // Create element to segment lookup.
-                        levelSet.mesh.elements[i].boundarySegments[levelSet.mesh.elements[i].nBoundarySegments] = nSegments;
-                        levelSet.mesh.elements[i].nBoundarySegments++;
+                        levelSet.mesh.boundarySegments[2*i + levelSet.mesh.nBoundarySegments[i]] = strip.segments.size();
+                        levelSet.mesh.nBoundarySegments[i]++;
 
                         // Add segment to vector.
-                        segments.push_back(segment);
-                        nSegments++;
+                        strip.segments.push_back(segment);
                     }
 
                     // Update element status to indicate whether centre is in or out.
-                    levelSet.mesh.elements[i].status = (lsfSum > 0) ? ElementStatus::CENTRE_INSIDE : ElementStatus::CENTRE_OUTSIDE;
+                    levelSet.mesh.elementStatus[i] = (lsfSum > 0) ? ElementStatus::CENTRE_INSIDE : ElementStatus::CENTRE_OUTSIDE;
                 }
 
                 // If no edges are cut and element is not inside structure
                 // then the boundary segment must cross the diagonal.
-                else if ((nCut == 0) && (levelSet.mesh.elements[i].status != ElementStatus::INSIDE))
+                else if ((nCut == 0) && (levelSet.mesh.elementStatus[i] != ElementStatus::INSIDE))
                 {
                     // Node index.
                     unsigned int node;
@@ -450,9 +477,9 @@ namespace slsm
                     for (unsigned int j=0;j<4;j++)
                     {
                         // Node index.
-                        node = levelSet.mesh.elements[i].nodes[j];
+                        node = levelSet.mesh.elementNode(i, j);
 
-                        if (levelSet.mesh.nodes[node].status & NodeStatus::BOUNDARY)
+                        if (levelSet.mesh.nodeStatus[node] & NodeStatus::BOUNDARY)
                         {
                             boundaryPoints[nCut] = node;
                             nCut++;
@@ -463,29 +490,22 @@ namespace slsm
                     BoundarySegment segment;
                     segment.element = i;
 
-                    // Initialise boundary point coordinate.
-                    Coord coord;
-
                     // Make sure that the start boundary point hasn't already been added.
                     node = boundaryPoints[0];
-                    int index = isAdded(levelSet.mesh, coord, node, 0, 0);
+                    int index = findPoint(levelSet.mesh, strip, 3*node);
 
                     // Boundary point is new.
                     if (index < 0)
                     {
                         // Set index equal to current number of points.
-                        index = nPoints;
+                        index = strip.points.size();
 
-                        levelSet.mesh.nodes[node].boundaryPoints[levelSet.mesh.nodes[node].nBoundaryPoints] = nPoints;
-                        levelSet.mesh.nodes[node].nBoundaryPoints++;
+                        attachPoint(levelSet.mesh, strip, node, index);
 
                         // Initialise boundary point.
                         BoundaryPoint point;
-                        initialisePoint(levelSet, point, coord);
-                        points.push_back(point);
-
-                        // Increment number of boundary points.
-                        nPoints++;
+                        initialisePoint(levelSet, point, levelSet.mesh.nodeCoord(node));
+                        addPoint(levelSet.mesh, strip, point, 3*node);
                     }
 
                     // Assign start point index.
@@ -493,63 +513,273 @@ namespace slsm
 
                     // Make sure that the end boundary point hasn't already been added.
                     node = boundaryPoints[1];
-                    index = isAdded(levelSet.mesh, coord, node, 0, 0);
+                    index = findPoint(levelSet.mesh, strip, 3*node);
 
                     // Boundary point is new.
                     if (index < 0)
                     {
                         // Set index equal to current number of points.
-                        index = nPoints;
+                        index = strip.points.size();
 
-                        levelSet.mesh.nodes[node].boundaryPoints[levelSet.mesh.nodes[node].nBoundaryPoints] = nPoints;
-                        levelSet.mesh.nodes[node].nBoundaryPoints++;
+                        attachPoint(levelSet.mesh, strip, node, index);
 
                         // Initialise boundary point.
                         BoundaryPoint point;
-                        initialisePoint(levelSet, point, coord);
-                        points.push_back(point);
-
-                        // Increment number of boundary points.
-                        nPoints++;
+                        initialisePoint(levelSet, point, levelSet.mesh.nodeCoord(node));
+                        addPoint(levelSet.mesh, strip, point, 3*node);
                     }
 
                     // Assign end point index.
                     segment.end = index;
 
-                    // Compute the length of the boundary segment.
-                    segment.length = segmentLength(segment);
-
-                    // Update total boundary length.
-                    length += segment.length;
-
                     // Create element to segment lookup.
-                    levelSet.mesh.elements[i].boundarySegments[levelSet.mesh.elements[i].nBoundarySegments] = nSegments;
-                    levelSet.mesh.elements[i].nBoundarySegments++;
+                    levelSet.mesh.boundarySegments[2*i + levelSet.mesh.nBoundarySegments[i]] = strip.segments.size();
+                    levelSet.mesh.nBoundarySegments[i]++;
 
                     // Add segment to vector.
-                    segments.push_back(segment);
-                    nSegments++;
+                    strip.segments.push_back(segment);
                 }
             }
         }
 
-        // Work out boundary integral length associated with each boundary point.
-        computePointLengths();
+        // No point has been found by a lower strip yet.
+        strip.isDuplicate.assign(strip.points.size(), 0);
+    }
+
+    void Boundary::mergeStrips(Mesh& mesh)
+    {
+        unsigned int nStrips = strips.size();
+
+        // Points on the nodes and horizontal edges of the bottom row of a strip
+        // are also found by the strip below, which visits its elements first.
+        for (unsigned int i=1;i<nStrips;i++)
+        {
+            Strip& strip = strips[i];
+            const Strip& below = strips[i-1];
+
+            for (unsigned int j=0;j<strip.points.size();j++)
+            {
+                unsigned int key = strip.points[j].edge;
+
+                // Vertical edges aren't shared.
+                if ((key % 3) != 2)
+                {
+                    // Nodal coordinates.
+                    unsigned int x, y;
+                    mesh.indexToXY(key / 3, x, y);
+
+                    if (y == strip.yMin)
+                    {
+                        unsigned int index = below.topTable[2*x + (key % 3)];
+
+                        if (index != nullEntry)
+                        {
+                            Duplicate duplicate;
+                            duplicate.point = j;
+                            duplicate.index = index;
+
+                            strip.duplicates.push_back(duplicate);
+                            strip.isDuplicate[j] = 1;
+                        }
+                    }
+                }
+            }
+        }
+
+        // Work out the global offsets of the points and segments of each strip.
+        nPoints = nSegments = 0;
+
+        for (unsigned int i=0;i<nStrips;i++)
+        {
+            strips[i].pointOffset = nPoints;
+            strips[i].segmentOffset = nSegments;
+
+            nPoints += strips[i].points.size() - strips[i].duplicates.size();
+            nSegments += strips[i].segments.size();
+        }
+
+        points.resize(nPoints);
+        segments.resize(nSegments);
+
+        // Number the new points of each strip and move them into place.
+        #pragma omp parallel for schedule(dynamic)
+        for (unsigned int i=0;i<nStrips;i++)
+        {
+            Strip& strip = strips[i];
+            strip.pointIndex.resize(strip.points.size());
+
+            unsigned int index = strip.pointOffset;
+
+            for (unsigned int j=0;j<strip.points.size();j++)
+            {
+                // Clear the point lookup table, ready for the next call.
+                unsigned int x, y;
+                mesh.indexToXY(strip.points[j].edge / 3, x, y);
+                if (y < strip.yMax) pointTable[strip.points[j].edge] = nullEntry;
+
+                if (!strip.isDuplicate[j])
+                {
+                    strip.pointIndex[j] = index;
+                    points[index] = std::move(strip.points[j]);
+                    index++;
+                }
+            }
+        }
+
+        // Renumber the segments and the mesh lookups.
+        #pragma omp parallel for schedule(dynamic)
+        for (unsigned int i=0;i<nStrips;i++)
+        {
+            Strip& strip = strips[i];
+
+            // Duplicate points take the index of the point found first.
+            for (unsigned int j=0;j<strip.duplicates.size();j++)
+            {
+                const Duplicate& duplicate = strip.duplicates[j];
+                strip.pointIndex[duplicate.point] = strips[i-1].pointIndex[duplicate.index];
+            }
+
+            for (unsigned int j=0;j<strip.segments.size();j++)
+            {
+                BoundarySegment& segment = segments[strip.segmentOffset + j];
+
+                segment = strip.segments[j];
+                segment.start = strip.pointIndex[segment.start];
+                segment.end = strip.pointIndex[segment.end];
+
+                // Compute the length of the boundary segment.
+                segment.length = segmentLength(segment);
+
+                // Update the element to segment lookup (once per element).
+                if ((j == 0) || (strip.segments[j-1].element != segment.element))
+                {
+                    for (unsigned int k=0;k<mesh.nBoundarySegments[segment.element];k++)
+                        mesh.boundarySegments[2*segment.element + k] += strip.segmentOffset;
+                }
+            }
+
+            // Update the node to point lookup, dropping duplicate points.
+            for (unsigned int j=0;j<strip.nodes.size();j++)
+            {
+                unsigned int node = strip.nodes[j];
+                unsigned int nAttached = 0;
+
+                for (unsigned int k=0;k<mesh.nBoundaryPoints[node];k++)
+                {
+                    unsigned int point = mesh.boundaryPoints[4*node + k];
+
+                    if (!strip.isDuplicate[point])
+                    {
+                        mesh.boundaryPoints[4*node + nAttached] = strip.pointIndex[point];
+                        nAttached++;
+                    }
+                }
+
+                mesh.nBoundaryPoints[node] = nAttached;
+            }
+
+            // The bottom row of nodes is shared with the strip below, which
+            // attached its points first.
+            if (i > 0)
+            {
+                const Strip& below = strips[i-1];
+
+                for (unsigned int j=0;j<below.topNodes.size();j++)
+                {
+                    unsigned int x = below.topNodes[j];
+                    unsigned int node = mesh.xyToIndex(x, strip.yMin);
+
+                    // Points attached by the strip below.
+                    unsigned int belowPoints[4];
+                    unsigned int nBelow = 0;
+
+                    for (unsigned int k=0;k<below.nTopPoints[x];k++)
+                    {
+                        unsigned int point = below.topPoints[4*x + k];
+
+                        if (!below.isDuplicate[point])
+                        {
+                            belowPoints[nBelow] = below.pointIndex[point];
+                            nBelow++;
+                        }
+                    }
+
+                    // Make room for the points of the strip below.
+                    for (unsigned int k=mesh.nBoundaryPoints[node];k>0;k--)
+                        mesh.boundaryPoints[4*node + k - 1 + nBelow] = mesh.boundaryPoints[4*node + k - 1];
+
+                    for (unsigned int k=0;k<nBelow;k++)
+                        mesh.boundaryPoints[4*node + k] = belowPoints[k];
+
+                    mesh.nBoundaryPoints[node] += nBelow;
+                }
+            }
+
+            // The top row of nodes of the final strip isn't shared.
+            if (i == (nStrips - 1))
+            {
+                for (unsigned int j=0;j<strip.topNodes.size();j++)
+                {
+                    unsigned int x = strip.topNodes[j];
+                    unsigned int node = mesh.xyToIndex(x, strip.yMax);
+
+                    for (unsigned int k=0;k<strip.nTopPoints[x];k++)
+                    {
+                        unsigned int point = strip.topPoints[4*x + k];
+
+                        if (!strip.isDuplicate[point])
+                        {
+                            mesh.boundaryPoints[4*node + mesh.nBoundaryPoints[node]] = strip.pointIndex[point];
+                            mesh.nBoundaryPoints[node]++;
+                        }
+                    }
+                }
+            }
+        }
+
+        // Sum the segment lengths (in order).
+        length = 0;
+
+        for (unsigned int i=0;i<nSegments;i++)
+            length += segments[i].length;
+    }
+
+    void Boundary::attachPoint(Mesh& mesh, Strip& strip, unsigned int node, unsigned int point) const
+    {
+        // Nodal coordinates.
+        unsigned int x, y;
+        mesh.indexToXY(node, x, y);
+
+        // The top row of nodes is shared with the strip above.
+        if (y == strip.yMax)
+        {
+            if (strip.nTopPoints[x] == 0) strip.topNodes.push_back(x);
+
+            strip.topPoints[4*x + strip.nTopPoints[x]] = point;
+            strip.nTopPoints[x]++;
+        }
+        else
+        {
+            if (mesh.nBoundaryPoints[node] == 0) strip.nodes.push_back(node);
+
+            mesh.boundaryPoints[4*node + mesh.nBoundaryPoints[node]] = point;
+            mesh.nBoundaryPoints[node]++;
+        }
     }
 
     void Boundary::computeNormalVectors(const LevelSet& levelSet)
     {
         // Whether the normal vector at a boundary point has been set.
-        bool isSet[nPoints];
+        std::vector<bool>& isSet = isNormalSet;
+        isSet.assign(nPoints, false);
 
         // Weighting factor for each point.
-        double weight[nPoints];
+        std::vector<double>& weight = normalWeight;
+        weight.assign(nPoints, 0);
 
-        // Initialise arrays.
+        // Initialise normal vectors.
         for (unsigned int i=0;i<nPoints;i++)
         {
-            isSet[i] = false;
-            weight[i] = 0;
             points[i].normal.x = 0;
             points[i].normal.y = 0;
         }
@@ -561,11 +791,11 @@ namespace slsm
             unsigned int node = levelSet.narrowBand[i];
 
             // Make sure the node has at least one neighbouring boundary point.
-            if (levelSet.mesh.nodes[node].nBoundaryPoints > 0)
+            if (levelSet.mesh.nBoundaryPoints[node] > 0)
             {
                 // Nodal coordinates.
-                unsigned int x = levelSet.mesh.nodes[node].coord.x;
-                unsigned int y = levelSet.mesh.nodes[node].coord.y;
+                unsigned int x = levelSet.mesh.nodeCoord(node).x;
+                unsigned int y = levelSet.mesh.nodeCoord(node).y;
 
                 // The x & y gradient components.
                 double gradX, gradY;
@@ -576,24 +806,24 @@ namespace slsm
                 if (x == 0)
                 {
                     // Forward difference.
-                    gradX = levelSet.signedDistance[levelSet.mesh.xyToIndex[x+1][y]]
-                          - levelSet.signedDistance[levelSet.mesh.xyToIndex[x][y]];
+                    gradX = levelSet.signedDistance[levelSet.mesh.xyToIndex(x+1, y)]
+                          - levelSet.signedDistance[levelSet.mesh.xyToIndex(x, y)];
                 }
 
                 // Right edge of mesh.
                 else if (x == levelSet.mesh.width)
                 {
                     // Backward difference.
-                    gradX = levelSet.signedDistance[levelSet.mesh.xyToIndex[x][y]]
-                          - levelSet.signedDistance[levelSet.mesh.xyToIndex[x-1][y]];
+                    gradX = levelSet.signedDistance[levelSet.mesh.xyToIndex(x, y)]
+                          - levelSet.signedDistance[levelSet.mesh.xyToIndex(x-1, y)];
                 }
 
                 // Bulk of mesh.
                 else
                 {
                     // Central difference.
-                    gradX = 0.5*(levelSet.signedDistance[levelSet.mesh.xyToIndex[x+1][y]]
-                          - levelSet.signedDistance[levelSet.mesh.xyToIndex[x-1][y]]);
+                    gradX = 0.5*(levelSet.signedDistance[levelSet.mesh.xyToIndex(x+1, y)]
+                          - levelSet.signedDistance[levelSet.mesh.xyToIndex(x-1, y)]);
                 }
 
                 // y direction
@@ -602,24 +832,24 @@ namespace slsm
                 if (y == 0)
                 {
                     // Forward difference.
-                    gradY = levelSet.signedDistance[levelSet.mesh.xyToIndex[x][y+1]]
-                          - levelSet.signedDistance[levelSet.mesh.xyToIndex[x][y]];
+                    gradY = levelSet.signedDistance[levelSet.mesh.xyToIndex(x, y+1)]
+                          - levelSet.signedDistance[levelSet.mesh.xyToIndex(x, y)];
                 }
 
                 // Top edge of mesh.
                 else if (y == levelSet.mesh.height)
                 {
                     // Backward difference.
-                    gradY = levelSet.signedDistance[levelSet.mesh.xyToIndex[x][y]]
-                          - levelSet.signedDistance[levelSet.mesh.xyToIndex[x][y-1]];
+                    gradY = levelSet.signedDistance[levelSet.mesh.xyToIndex(x, y)]
+                          - levelSet.signedDistance[levelSet.mesh.xyToIndex(x, y-1)];
                 }
 
                 // Bulk of mesh.
                 else
                 {
                     // Central difference.
-                    gradY = 0.5*(levelSet.signedDistance[levelSet.mesh.xyToIndex[x][y+1]]
-                          - levelSet.signedDistance[levelSet.mesh.xyToIndex[x][y-1]]);
+                    gradY = 0.5*(levelSet.signedDistance[levelSet.mesh.xyToIndex(x, y+1)]
+                          - levelSet.signedDistance[levelSet.mesh.xyToIndex(x, y-1)]);
                 }
 
                 // Absolute gradient.
@@ -630,14 +860,14 @@ namespace slsm
                 double yNormal = gradY / grad;
 
                 // Loop over all boundary points.
-                for (unsigned int j=0;j<levelSet.mesh.nodes[node].nBoundaryPoints;j++)
+                for (unsigned int j=0;j<levelSet.mesh.nBoundaryPoints[node];j++)
                 {
                     // Boundary point index.
-                    unsigned int point = levelSet.mesh.nodes[node].boundaryPoints[j];
+                    unsigned int point = levelSet.mesh.boundaryPoints[4*node + j];
 
                     // Distance from the boundary point to the node.
-                    double dx = levelSet.mesh.nodes[node].coord.x - points[point].coord.x;
-                    double dy = levelSet.mesh.nodes[node].coord.y - points[point].coord.y;
+                    double dx = levelSet.mesh.nodeCoord(node).x - points[point].coord.x;
+                    double dy = levelSet.mesh.nodeCoord(node).y - points[point].coord.y;
 
                     // Squared distance.
                     double rSqd = dx*dx + dy*dy;
@@ -704,103 +934,152 @@ namespace slsm
     {
         // Calculate node status.
         for (unsigned int i=0;i<mesh.nNodes;i++)
+            computeNodeStatus(mesh, *signedDistance, i);
+
+        // Calculate element status.
+        for (unsigned int i=0;i<mesh.nElements;i++)
+            computeElementStatus(mesh, i);
+    }
+
+    void Boundary::computeBlockStatus(LevelSet& levelSet) const
+    {
+        Mesh& mesh = levelSet.mesh;
+
+        // Calculate node status.
+        for (unsigned int i=0;i<levelSet.nActiveBlocks;i++)
         {
-            // Reset the number of boundary points associated with the element.
-            mesh.nodes[i].nBoundaryPoints = 0;
+            unsigned int xMin, yMin, xMax, yMax;
+            mesh.blockBounds(levelSet.activeBlocks[i], xMin, yMin, xMax, yMax);
 
-            // Flag node as being on the boundary if the signed distance is within
-            // a small tolerance of the zero contour. This avoids problems with
-            // rounding errors when generating the discretised boundary.
-            if (std::abs((*signedDistance)[i]) < 1e-6)
-            {
-                mesh.nodes[i].status = NodeStatus::BOUNDARY;
-            }
-            else if ((*signedDistance)[i] < 0)
-            {
-                mesh.nodes[i].status = NodeStatus::OUTSIDE;
-            }
-            else mesh.nodes[i].status = NodeStatus::INSIDE;
+            // Include the top and right nodes of elements at the edge of the block.
+            xMax = std::min(xMax + 1, mesh.width + 1);
+            yMax = std::min(yMax + 1, mesh.height + 1);
+
+            for (unsigned int y=yMin;y<yMax;y++)
+                for (unsigned int x=xMin;x<xMax;x++)
+                    computeNodeStatus(mesh, levelSet.signedDistance, mesh.xyToIndex(x, y));
         }
 
         // Calculate element status.
-        for (unsigned int i=0;i<mesh.nElements;i++)
-        {
-            // Tally counters for the element's node statistics.
-            unsigned int tallyInside = 0;
-            unsigned int tallyOutside = 0;
+        for (unsigned int i=0;i<levelSet.activeElements.size();i++)
+            computeElementStatus(mesh, levelSet.activeElements[i]);
+    }
 
-            // Reset the number of boundary segments associated with the element.
-            mesh.elements[i].nBoundarySegments = 0;
+    void Boundary::computeNodeStatus(Mesh& mesh, const std::vector<double>& signedDistance, unsigned int node) const
+    {
+        // Reset the number of boundary points associated with the node.
+        mesh.nBoundaryPoints[node] = 0;
 
-            // Loop over each node of the element.
-            for (unsigned int j=0;j<4;j++)
-            {
-                unsigned int node = mesh.elements[i].nodes[j];
+        // Flag node as being on the boundary if the signed distance is within
+        // a small tolerance of the zero contour. This avoids problems with
+        // rounding errors when generating the discretised boundary.
+        if (std::abs(signedDistance[node]) < 1e-6)
+        {
+            mesh.nodeStatus[node] = NodeStatus::BOUNDARY;
+        }
+        else if (signedDistance[node] < 0)
+        {
+            mesh.nodeStatus[node] = NodeStatus::OUTSIDE;
+        }
+        else mesh.nodeStatus[node] = NodeStatus::INSIDE;
+    }
 
-                if (mesh.nodes[node].status & NodeStatus::INSIDE) tallyInside++;
-                else if (mesh.nodes[node].status & NodeStatus::OUTSIDE) tallyOutside++;
-            }
+    void Boundary::computeElementStatus(Mesh& mesh, unsigned int element) const
+    {
+        // Tally counters for the element's node statistics.
+        unsigned int tallyInside = 0;
+        unsigned int tallyOutside = 0;
 
-            // No nodes are outside: element is inside the structure.
-            if (tallyOutside == 0) mesh.elements[i].status = ElementStatus::INSIDE;
+        // Reset the number of boundary segments associated with the element.
+        mesh.nBoundarySegments[element] = 0;
 
-            // No nodes are inside: element is outside the structure.
-            else if (tallyInside == 0) mesh.elements[i].status = ElementStatus::OUTSIDE;
+        // Loop over each node of the element.
+        for (unsigned int j=0;j<4;j++)
+        {
+            unsigned int node = mesh.elementNode(element, j);
 
-            // Otherwise no status.
-            else mesh.elements[i].status = ElementStatus::NONE;
+            if (mesh.nodeStatus[node] & NodeStatus::INSIDE) tallyInside++;
+            else if (mesh.nodeStatus[node] & NodeStatus::OUTSIDE) tallyOutside++;
         }
+
+        // No nodes are outside: element is inside the structure.
+        if (tallyOutside == 0) mesh.elementStatus[element] = ElementStatus::INSIDE;
+
+        // No nodes are inside: element is outside the structure.
+        else if (tallyInside == 0) mesh.elementStatus[element] = ElementStatus::OUTSIDE;
+
+        // Otherwise no status.
+        else mesh.elementStatus[element] = ElementStatus::NONE;
     }
 
-    int Boundary::isAdded(Mesh& mesh, Coord& point, const unsigned int& node,
-        const unsigned int& edge, const double& distance)
+    unsigned int Boundary::edgeKey(unsigned int n1, unsigned int n2, unsigned int edge) const
+    {
+        // Horizontal edges are keyed by their left node, vertical edges by their bottom node.
+
+        // Bottom edge.
+        if (edge == 0) return 3*n1 + 1;
+
+        // Right edge.
+        else if (edge == 1) return 3*n1 + 2;
+
+        // Top edge.
+        else if (edge == 2) return 3*n2 + 1;
+
+        // Left edge.
+        else return 3*n2 + 2;
+    }
+
+    Coord Boundary::edgeCoord(const Mesh& mesh, unsigned int node, unsigned int edge, double distance) const
     {
         // Work out the coordinates of the point (depends on which edge we are considering).
-        // Set edge and distance equal to zero when considering boundary points lying exactly
-        // on top of a mesh node.
+        Coord coord = mesh.nodeCoord(node);
 
         // Bottom edge.
-        if (edge == 0)
-        {
-            point.x = mesh.nodes[node].coord.x + distance;
-            point.y = mesh.nodes[node].coord.y;
-        }
+        if (edge == 0) coord.x += distance;
+
         // Right edge.
-        else if (edge == 1)
-        {
-            point.x = mesh.nodes[node].coord.x;
-            point.y = mesh.nodes[node].coord.y + distance;
-        }
+        else if (edge == 1) coord.y += distance;
+
         // Top edge.
-        else if (edge == 2)
-        {
-            point.x = mesh.nodes[node].coord.x - distance;
-            point.y = mesh.nodes[node].coord.y;
-        }
+        else if (edge == 2) coord.x -= distance;
+
         // Left edge.
-        else
-        {
-            point.x = mesh.nodes[node].coord.x;
-            point.y = mesh.nodes[node].coord.y - distance;
-        }
+        else coord.y -= distance;
 
-        // Check all points adjacent to the node.
-        for (unsigned int i=0;i<mesh.nodes[node].nBoundaryPoints;i++)
-        {
-            // Index of the ith boundary point connected to the node.
-            unsigned int index = mesh.nodes[node].boundaryPoints[i];
+        return coord;
+    }
 
-            // Point already exists.
-            if ((std::abs(point.x - points[index].coord.x) < 1e-6) &&
-                (std::abs(point.y - points[index].coord.y) < 1e-6))
-            {
-                // Boundary point is already added, return index.
-                return index;
-            }
-        }
+    unsigned int& Boundary::pointEntry(const Mesh& mesh, Strip& strip, unsigned int key)
+    {
+        // Nodal coordinates.
+        unsigned int x, y;
+        mesh.indexToXY(key / 3, x, y);
+
+        // Nodes and horizontal edges on the top row are shared with the strip above.
+        if (y == strip.yMax) return strip.topTable[2*x + (key % 3)];
+
+        return pointTable[key];
+    }
+
+    int Boundary::findPoint(const Mesh& mesh, Strip& strip, unsigned int key)
+    {
+        unsigned int index = pointEntry(mesh, strip, key);
+
+        // Point is new.
+        if (index == nullEntry) return -1;
 
-        // If we've made it this far, then point is new.
-        return -1;
+        // Boundary point is already added, return index.
+        return index;
+    }
+
+    void Boundary::addPoint(const Mesh& mesh, Strip& strip, BoundaryPoint& point, unsigned int key)
+    {
+        point.edge = key;
+
+        // Record the index of the point in the strip.
+        pointEntry(mesh, strip, key) = strip.points.size();
+
+        strip.points.push_back(point);
     }
 
     void Boundary::initialisePoint(LevelSet& levelSet, BoundaryPoint& point, const Coord& coord)
@@ -839,11 +1118,11 @@ namespace slsm
         unsigned int node = levelSet.mesh.getClosestNode(coord);
 
         // Check to see if point lies on, or near, a masked region.
-        if (levelSet.mesh.nodes[node].isMasked)
+        if (levelSet.mesh.isMasked[node])
         {
             // Distance to masked node.
-            double dx = levelSet.mesh.nodes[node].coord.x - coord.x;
-            double dy = levelSet.mesh.nodes[node].coord.y - coord.y;
+            double dx = levelSet.mesh.nodeCoord(node).x - coord.x;
+            double dy = levelSet.mesh.nodeCoord(node).y - coord.y;
 
             // Lies on the masked node.
             if ((std::abs(dx) < 1e-6) && (std::abs(dy) < 1e-6))
@@ -888,21 +1167,37 @@ namespace slsm
             points[segments[i].start].length += 0.5 * segments[i].length;
             points[segments[i].end].length += 0.5 * segments[i].length;
 
+            // Points on a contour that runs along a grid line can belong to
+            // more than two segments, since the segment on a shared edge is
+            // found by both elements. Excess segments aren't recorded.
+
             // Update point to segment lookup for start point.
-            points[segments[i].start].segments[points[segments[i].start].nSegments] = i;
-            points[segments[i].start].nSegments++;
+            if (points[segments[i].start].nSegments < 4)
+            {
+                points[segments[i].start].segments[points[segments[i].start].nSegments] = i;
+                points[segments[i].start].nSegments++;
+            }
 
             // Update point to segment lookup for end point.
-            points[segments[i].end].segments[points[segments[i].end].nSegments] = i;
-            points[segments[i].end].nSegments++;
+            if (points[segments[i].end].nSegments < 4)
+            {
+                points[segments[i].end].segments[points[segments[i].end].nSegments] = i;
+                points[segments[i].end].nSegments++;
+            }
 
             // Update nearest neighbours for the start point.
-            points[segments[i].start].neighbours[points[segments[i].start].nNeighbours] = segments[i].end;
-            points[segments[i].start].nNeighbours++;
+            if (points[segments[i].start].nNeighbours < 4)
+            {
+                points[segments[i].start].neighbours[points[segments[i].start].nNeighbours] = segments[i].end;
+                points[segments[i].start].nNeighbours++;
+            }
 
             // Update nearest neighbours for the end point.
-            points[segments[i].end].neighbours[points[segments[i].end].nNeighbours] = segments[i].start;
-            points[segments[i].end].nNeighbours++;
+            if (points[segments[i].end].nNeighbours < 4)
+            {
+                points[segments[i].end].neighbours[points[segments[i].end].nNeighbours] = segments[i].start;
+                points[segments[i].end].nNeighbours++;
+            }
         }
     }
 }
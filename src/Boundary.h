@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "Common.h"
+#include "Quadtree.h"
 
 /*! \file Boundary.h
     \brief A class for the discretised boundary.
@@ -51,10 +52,10 @@ namespace slsm
         bool isDomain;                          //!< Whether the point lies close to the domain boundary.
         bool isFixed;                           //!< Whether the point is fixed.
         unsigned int nSegments;                 //!< The number of boundary segments that a point belongs to.
-        std::vector<unsigned int> segments;     //!< The indices of the two segments to which a point belongs.
+        unsigned int segments[4];               //!< The indices of the segments to which a point belongs (usually two).
         unsigned int nNeighbours;               //!< The number of neighbouring boundary points.
-        std::vector<unsigned int> neighbours;   //!< The indices of the neighbouring points.
-        std::vector<double> sensitivities;      //!< Objective and constraint sensitivities.
+        unsigned int neighbours[4];             //!< The indices of the neighbouring points (usually two).
+        unsigned int edge;                      //!< The mesh node or edge on which the point lies (see Boundary).
     };
 
     //! \brief A container for storing information associated with a boundary segment.
@@ -89,19 +90,39 @@ namespace slsm
         of the zero contour, to evaluate the perimeter of the boundary, to calculate
         the amount of material area in each of the cells of the level set domain,
         and to determine the inward pointing normal vector at each boundary point.
+
+        Each boundary point records the mesh node or edge on which it lies as
+        a single key: 3*node for a point on a node, 3*node + 1 for a point on
+        the horizontal edge from the node to its right-hand neighbour, and
+        3*node + 2 for a point on the vertical edge from the node to its
+        neighbour above. Points are de-duplicated using a lookup table that
+        is indexed by this key.
+
+        Boundary point sensitivities are stored in a single contiguous matrix,
+        with a row of nFunctions values (the objective followed by each of the
+        constraints) for each point, and are accessed through the boundary,
+        e.g. sensitivity(point, function). The matrix is resized and zeroed
+        each time that the boundary is discretised.
      */
     class Boundary
     {
     public:
         //! Constructor.
-        Boundary();
+        /*! \param nFunctions_
+                The number of functions (objective and constraints) with
+                sensitivities at each boundary point (optional).
+         */
+        Boundary(unsigned int nFunctions_ = 2);
 
         //! Use linear interpolation to compute the discretised boundary
         /*! \param levelSet
                 A reference to the level set object.
 
             \param isTarget
-                Whether to discretise the target signed distance function.
+                Whether to discretise the target signed distance function. The
+                target must be a signed distance function, as it is following
+                construction of the level set, since the elements that are cut
+                by the boundary are found using a quadtree.
          */
         void discretise(LevelSet&, bool isTarget = false);
 
@@ -120,6 +141,36 @@ namespace slsm
          */
         double computePerimeter(const BoundaryPoint&);
 
+        //! Access the sensitivity of a function at a boundary point.
+        /*! \param point
+                The boundary point index.
+
+            \param function
+                The function index (0 = objective, 1, 2, ... = constraints).
+
+            \return
+                A reference to the sensitivity.
+         */
+        double& sensitivity(unsigned int point, unsigned int function)
+        {
+            return sensitivities[point*nFunctions + function];
+        }
+
+        //! Return the sensitivity of a function at a boundary point.
+        /*! \param point
+                The boundary point index.
+
+            \param function
+                The function index (0 = objective, 1, 2, ... = constraints).
+
+            \return
+                The sensitivity.
+         */
+        double sensitivity(unsigned int point, unsigned int function) const
+        {
+            return sensitivities[point*nFunctions + function];
+        }
+
         /// Vector of boundary points.
         std::vector<BoundaryPoint> points;
 
@@ -135,7 +186,59 @@ namespace slsm
         /// The total length of the boundary.
         double length;
 
+        /// The number of functions with sensitivities at each boundary point.
+        const unsigned int nFunctions;
+
+        /// Boundary point sensitivities (nPoints x nFunctions, stored point by point).
+        std::vector<double> sensitivities;
+
     private:
+        //! A boundary point that was also found by the strip of elements below.
+        struct Duplicate
+        {
+            unsigned int point;             ///< The index of the point in its strip.
+            unsigned int index;             ///< The index of the point in the strip below.
+        };
+
+        //! The boundary points and segments found in a horizontal strip of elements.
+        /*! Points and segments are numbered locally within the strip. The
+            top row of nodes is shared with the strip above, so the points
+            attached to these nodes are recorded by the strip, rather than
+            the mesh.
+         */
+        struct Strip
+        {
+            unsigned int yMin;                          ///< The first row of elements.
+            unsigned int yMax;                          ///< One past the last row of elements.
+            unsigned int pointOffset;                   ///< The global index of the first new point.
+            unsigned int segmentOffset;                 ///< The global index of the first segment.
+            std::vector<BoundaryPoint> points;          ///< The points found by the strip.
+            std::vector<BoundarySegment> segments;      ///< The segments found by the strip.
+            std::vector<unsigned int> nodes;            ///< The nodes below the top row with attached points.
+            std::vector<unsigned int> topNodes;         ///< The x coordinates of top row nodes with attached points.
+            std::vector<unsigned int> topPoints;        ///< Indices of points attached to each top row node (stride 4).
+            std::vector<unsigned int> nTopPoints;       ///< The number of points attached to each top row node.
+            std::vector<unsigned int> topTable;         ///< The point on each top row node and horizontal edge (stride 2).
+            std::vector<Duplicate> duplicates;          ///< The points that were found by a lower strip.
+            std::vector<char> isDuplicate;              ///< Whether each point was found by a lower strip.
+            std::vector<unsigned int> pointIndex;       ///< The global index of each point.
+        };
+
+        /// The strips of elements, reused between calls.
+        std::vector<Strip> strips;
+
+        /// The index of the point (in its strip) on each mesh node and edge, indexed by key.
+        std::vector<unsigned int> pointTable;
+
+        /// Quadtree decomposition of the target signed distance function, reused between calls.
+        Quadtree quadtree;
+
+        /// Interpolation weight of each boundary point, reused between calls.
+        std::vector<double> normalWeight;
+
+        /// Whether the normal vector at each boundary point has been set, reused between calls.
+        std::vector<bool> isNormalSet;
+
         //! Determine the status of the elements and nodes of the level set mesh.
         /*! \param mesh
                 A reference to the fixed-grid mesh.
@@ -145,15 +248,93 @@ namespace slsm
          */
         void computeMeshStatus(Mesh&, const std::vector<double>* signedDistance) const;
 
-        //! Check whether a boundary point has already been added.
+        //! Determine the status of the elements and nodes in the active blocks of the level set mesh.
+        /*! \param levelSet
+                A reference to the level set object.
+         */
+        void computeBlockStatus(LevelSet&) const;
+
+        //! Determine the status of a node of the level set mesh.
         /*! \param mesh
                 A reference to the fixed-grid mesh.
 
+            \param signedDistance
+                A reference to the signed distance function vector.
+
+            \param node
+                The node index.
+         */
+        void computeNodeStatus(Mesh&, const std::vector<double>&, unsigned int) const;
+
+        //! Determine the status of an element of the level set mesh.
+        /*! \param mesh
+                A reference to the fixed-grid mesh.
+
+            \param element
+                The element index.
+         */
+        void computeElementStatus(Mesh&, unsigned int) const;
+
+        //! Discretise the zero contour within a strip of elements.
+        /*! \param levelSet
+                A reference to the level set object.
+
+            \param signedDistance
+                A pointer to the signed distance function vector.
+
+            \param strip
+                A reference to the strip.
+
+            \param isTarget
+                Whether to discretise the target signed distance function.
+         */
+        void discretiseStrip(LevelSet&, const std::vector<double>*, Strip&, bool);
+
+        //! Merge the points and segments found by the strips.
+        /*! Points and segments are numbered in the order in which they are
+            found by a single pass over the elements.
+
+            \param mesh
+                A reference to the fixed-grid mesh.
+         */
+        void mergeStrips(Mesh&);
+
+        //! Attach a boundary point to a node.
+        /*! \param mesh
+                A reference to the fixed-grid mesh.
+
+            \param strip
+                A reference to the strip that found the point.
+
+            \param node
+                The node index.
+
             \param point
-                The coordinates of the boundary point (to be determined).
+                The index of the point in the strip.
+         */
+        void attachPoint(Mesh&, Strip&, unsigned int, unsigned int) const;
+
+        //! Return the key of the mesh edge on which a boundary point lies.
+        /*! \param n1
+                The index of the first node of the element edge.
+
+            \param n2
+                The index of the second node of the element edge.
+
+            \param edge
+                The index of the element edge.
+
+            \return
+                The key of the mesh edge.
+         */
+        unsigned int edgeKey(unsigned int, unsigned int, unsigned int) const;
+
+        //! Return the coordinates of a boundary point on an element edge.
+        /*! \param mesh
+                A reference to the fixed-grid mesh.
 
             \param node
-                The index of the adjacent node.
+                The index of the first node of the element edge.
 
             \param edge
                 The index of the element edge.
@@ -162,9 +343,54 @@ namespace slsm
                 The distance from the node.
 
             \return
-                The index of the boundary point if previously added, minus one if not.
+                The coordinates of the boundary point.
+         */
+        Coord edgeCoord(const Mesh&, unsigned int, unsigned int, double) const;
+
+        //! Return the lookup table entry for a mesh node or edge.
+        /*! \param mesh
+                A reference to the fixed-grid mesh.
+
+            \param strip
+                A reference to the strip.
+
+            \param key
+                The key of the mesh node or edge.
+
+            \return
+                A reference to the table entry.
+         */
+        unsigned int& pointEntry(const Mesh&, Strip&, unsigned int);
+
+        //! Check whether a boundary point has already been added.
+        /*! \param mesh
+                A reference to the fixed-grid mesh.
+
+            \param strip
+                A reference to the strip that is searched.
+
+            \param key
+                The key of the mesh node or edge.
+
+            \return
+                The index of the boundary point in the strip if previously added, minus one if not.
+         */
+        int findPoint(const Mesh&, Strip&, unsigned int);
+
+        //! Add a boundary point to a strip.
+        /*! \param mesh
+                A reference to the fixed-grid mesh.
+
+            \param strip
+                A reference to the strip.
+
+            \param point
+                A reference to the boundary point.
+
+            \param key
+                The key of the mesh node or edge.
          */
-        int isAdded(Mesh&, Coord&, const unsigned int&, const unsigned int&, const double&);
+        void addPoint(const Mesh&, Strip&, BoundaryPoint&, unsigned int);
 
         //! Initialise a boundary point.
         /*! \param levelSet
@@ -0,0 +1,206 @@
+/*
+  Copyright (c) 2015-2017 Lester Hedges <lester.hedges+slsm@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "Boundary.h"
+#include "ClosestPointTransform.h"
+#include "Mesh.h"
+
+/*! \file ClosestPointTransform.cpp
+    \brief An implementation of the Closest Point Transform.
+ */
+
+namespace slsm
+{
+    ClosestPointTransform::ClosestPointTransform(const Mesh& mesh_) :
+        mesh(mesh_)
+    {
+        // Divide the nodes into tiles.
+        nTilesX = (mesh.width + tileSize) / tileSize;
+        nTilesY = (mesh.height + tileSize) / tileSize;
+        tileSegmentOffset.resize(nTilesX * nTilesY + 1);
+    }
+
+    void ClosestPointTransform::transform(const Boundary& boundary,
+        std::vector<double>& signedDistance, double cutOff)
+    {
+        // Assign the boundary segments to the tiles.
+        initialiseTileSegments(boundary, signedDistance, cutOff);
+
+        // Each tile only writes the nodes that it owns.
+        #pragma omp parallel for schedule(dynamic)
+        for (unsigned int i=0;i<nTilesX*nTilesY;i++)
+            transformTile(signedDistance, cutOff, i);
+    }
+
+    void ClosestPointTransform::segmentBounds(unsigned int segment, double cutOff,
+        unsigned int& xMin, unsigned int& yMin, unsigned int& xMax, unsigned int& yMax) const
+    {
+        const Coord& p1 = start[segment];
+        const Coord& p2 = end[segment];
+
+        // Bounding box of the segment, extended by the cut-off distance.
+        double x1 = std::max(std::ceil(std::min(p1.x, p2.x) - cutOff), 0.0);
+        double y1 = std::max(std::ceil(std::min(p1.y, p2.y) - cutOff), 0.0);
+        double x2 = std::min(std::floor(std::max(p1.x, p2.x) + cutOff), double(mesh.width));
+        double y2 = std::min(std::floor(std::max(p1.y, p2.y) + cutOff), double(mesh.height));
+
+        xMin = (unsigned int) x1;
+        yMin = (unsigned int) y1;
+        xMax = (unsigned int) x2 + 1;
+        yMax = (unsigned int) y2 + 1;
+    }
+
+    void ClosestPointTransform::initialiseTileSegments(const Boundary& boundary,
+        const std::vector<double>& signedDistance, double cutOff)
+    {
+        start.clear();
+        end.clear();
+
+        // Store the end points of each segment.
+        for (unsigned int i=0;i<boundary.nSegments;i++)
+        {
+            start.push_back(boundary.points[boundary.segments[i].start].coord);
+            end.push_back(boundary.points[boundary.segments[i].end].coord);
+        }
+
+        // Points that don't belong to a segment are treated as segments of zero length.
+        for (unsigned int i=0;i<boundary.nPoints;i++)
+        {
+            if (boundary.points[i].nSegments == 0)
+            {
+                start.push_back(boundary.points[i].coord);
+                end.push_back(boundary.points[i].coord);
+            }
+        }
+
+        // As are nodes on the zero contour (these are frozen by the fast marching method).
+        for (unsigned int i=0;i<mesh.nNodes;i++)
+        {
+            if (signedDistance[i] == 0)
+            {
+                start.push_back(mesh.nodeCoord(i));
+                end.push_back(mesh.nodeCoord(i));
+            }
+        }
+
+        // Count the number of segments influencing each tile.
+        std::fill(tileSegmentOffset.begin(), tileSegmentOffset.end(), 0);
+
+        for (unsigned int i=0;i<start.size();i++)
+        {
+            unsigned int xMin, yMin, xMax, yMax;
+            segmentBounds(i, cutOff, xMin, yMin, xMax, yMax);
+
+            for (unsigned int y=yMin/tileSize;y<=(yMax-1)/tileSize;y++)
+                for (unsigned int x=xMin/tileSize;x<=(xMax-1)/tileSize;x++)
+                    tileSegmentOffset[x + y*nTilesX + 1]++;
+        }
+
+        // Convert the counts to offsets.
+        for (unsigned int i=0;i<nTilesX*nTilesY;i++)
+            tileSegmentOffset[i+1] += tileSegmentOffset[i];
+
+        tileSegments.resize(tileSegmentOffset.back());
+
+        // Insertion offsets, in segment order, so that the grouping is deterministic.
+        next.assign(tileSegmentOffset.begin(), tileSegmentOffset.end() - 1);
+
+        for (unsigned int i=0;i<start.size();i++)
+        {
+            unsigned int xMin, yMin, xMax, yMax;
+            segmentBounds(i, cutOff, xMin, yMin, xMax, yMax);
+
+            for (unsigned int y=yMin/tileSize;y<=(yMax-1)/tileSize;y++)
+                for (unsigned int x=xMin/tileSize;x<=(xMax-1)/tileSize;x++)
+                    tileSegments[next[x + y*nTilesX]++] = i;
+        }
+    }
+
+    void ClosestPointTransform::transformTile(std::vector<double>& signedDistance,
+        double cutOff, unsigned int tile) const
+    {
+        // Node range of the tile.
+        unsigned int tileXMin = (tile % nTilesX) * tileSize;
+        unsigned int tileYMin = (tile / nTilesX) * tileSize;
+        unsigned int tileXMax = std::min(tileXMin + tileSize, mesh.width + 1);
+        unsigned int tileYMax = std::min(tileYMin + tileSize, mesh.height + 1);
+
+        // Squared distance of each node in the tile, initialised to the cut-off.
+        double distance[tileSize*tileSize];
+        std::fill(distance, distance + tileSize*tileSize, cutOff*cutOff);
+
+        // Loop over all segments influencing the tile.
+        for (unsigned int i=tileSegmentOffset[tile];i<tileSegmentOffset[tile+1];i++)
+        {
+            unsigned int segment = tileSegments[i];
+
+            const Coord& p1 = start[segment];
+            const Coord& p2 = end[segment];
+
+            // Segment vector and squared length.
+            double dx = p2.x - p1.x;
+            double dy = p2.y - p1.y;
+            double lengthSqd = dx*dx + dy*dy;
+
+            // Restrict the region of influence to the tile.
+            unsigned int xMin, yMin, xMax, yMax;
+            segmentBounds(segment, cutOff, xMin, yMin, xMax, yMax);
+
+            xMin = std::max(xMin, tileXMin);
+            yMin = std::max(yMin, tileYMin);
+            xMax = std::min(xMax, tileXMax);
+            yMax = std::min(yMax, tileYMax);
+
+            for (unsigned int y=yMin;y<yMax;y++)
+            {
+                for (unsigned int x=xMin;x<xMax;x++)
+                {
+                    // Projection of the node onto the segment, clamped to its end points.
+                    double t = 0;
+                    if (lengthSqd > 0)
+                    {
+                        t = ((x - p1.x)*dx + (y - p1.y)*dy) / lengthSqd;
+                        t = std::min(std::max(t, 0.0), 1.0);
+                    }
+
+                    // Squared distance to the closest point.
+                    double rx = x - (p1.x + t*dx);
+                    double ry = y - (p1.y + t*dy);
+                    double d = rx*rx + ry*ry;
+
+                    unsigned int index = (x - tileXMin) + (y - tileYMin)*tileSize;
+                    if (d < distance[index]) distance[index] = d;
+                }
+            }
+        }
+
+        // Set the signed distance, taking the sign from the level set.
+        for (unsigned int y=tileYMin;y<tileYMax;y++)
+        {
+            for (unsigned int x=tileXMin;x<tileXMax;x++)
+            {
+                unsigned int node = mesh.xyToIndex(x, y);
+                double d = std::sqrt(distance[(x - tileXMin) + (y - tileYMin)*tileSize]);
+
+                signedDistance[node] = (signedDistance[node] < 0) ? -d : d;
+            }
+        }
+    }
+}
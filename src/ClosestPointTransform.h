@@ -0,0 +1,166 @@
+/*
+  Copyright (c) 2015-2017 Lester Hedges <lester.hedges+slsm@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _CLOSESTPOINTTRANSFORM_H
+#define _CLOSESTPOINTTRANSFORM_H
+
+#include <vector>
+
+#include "Common.h"
+
+/*! \file ClosestPointTransform.h
+    \brief An implementation of the Closest Point Transform.
+ */
+
+namespace slsm
+{
+    // FORWARD DECLARATIONS
+
+    class Boundary;
+    class Mesh;
+
+    // MAIN CLASS
+
+    /*! \brief An implementation of the Closest Point Transform for computing
+        the signed distance from the discretised boundary.
+
+        This object can be used to reinitialise the level set to a signed
+        distance function, as an alternative to solving the Eikonal equation.
+        Rather than approximating the distance of the nodes adjacent to the zero
+        contour, then propagating it outwards, the exact Euclidean distance from
+        the piece-wise linear boundary (see Boundary) is computed for every node
+        within a cut-off distance. Each boundary segment only influences the nodes
+        that lie within the cut-off, so, beyond a single pass over the mesh to set
+        the far field, the cost is proportional to the number of nodes close to
+        the boundary. See:
+
+            S. Mauch, "A fast algorithm for computing the closest point and
+            distance transform", Technical Report caltechASCI/2000.077,
+            California Institute of Technology (2000).
+
+        Here the region of influence of a segment is its bounding box, extended
+        by the cut-off distance. The mesh is divided into square tiles and each
+        segment is assigned to the tiles that its region overlaps. Tiles are
+        then processed in parallel, each taking the minimum distance over its
+        own segments, so the solution is independent of the number of threads.
+
+        The sign of each node is taken from the level set, so the boundary must
+        be discretised from the current signed distance function. As for the
+        Fast Marching Method, nodes with a signed distance of zero remain on the
+        zero contour, even when they don't belong to a boundary segment, e.g.
+        on the domain boundary next to a hole. Nodes beyond the cut-off are
+        assigned the cut-off distance.
+     */
+    class ClosestPointTransform
+    {
+    public:
+        //! Constructor.
+        /*! \param mesh_
+                A reference to the level set mesh.
+         */
+        ClosestPointTransform(const Mesh&);
+
+        //! Compute the signed distance from the boundary.
+        /*! \param boundary
+                A reference to the discretised boundary of the level set.
+
+            \param signedDistance
+                The nodal signed distance function (level set).
+
+            \param cutOff
+                The maximum distance from the boundary.
+         */
+        void transform(const Boundary&, std::vector<double>&, double);
+
+    private:
+        /// A const reference to the level set mesh.
+        const Mesh& mesh;
+
+        /// The number of tiles in the x direction.
+        unsigned int nTilesX;
+
+        /// The number of tiles in the y direction.
+        unsigned int nTilesY;
+
+        /// The start point of each segment (zero length for isolated points and zero nodes).
+        std::vector<Coord> start;
+
+        /// The end point of each segment.
+        std::vector<Coord> end;
+
+        /// The offset of the first segment of each tile in tileSegments.
+        std::vector<unsigned int> tileSegmentOffset;
+
+        /// Indices of segments, grouped by tile.
+        std::vector<unsigned int> tileSegments;
+
+        /// Insertion offsets used when grouping segments by tile.
+        std::vector<unsigned int> next;
+
+        /// The width (and height) of a tile.
+        static const unsigned int tileSize = 32;
+
+        //! Find the range of nodes within the cut-off distance of a segment.
+        /*! \param segment
+                The index of the segment.
+
+            \param cutOff
+                The maximum distance from the boundary.
+
+            \param xMin
+                The minimum x coordinate (filled by function).
+
+            \param yMin
+                The minimum y coordinate (filled by function).
+
+            \param xMax
+                One past the maximum x coordinate (filled by function).
+
+            \param yMax
+                One past the maximum y coordinate (filled by function).
+         */
+        void segmentBounds(unsigned int, double,
+            unsigned int&, unsigned int&, unsigned int&, unsigned int&) const;
+
+        //! Group the boundary segments, and nodes on the zero contour, by the
+        //! tiles that they influence.
+        /*! \param boundary
+                A reference to the discretised boundary of the level set.
+
+            \param signedDistance
+                The nodal signed distance function (level set).
+
+            \param cutOff
+                The maximum distance from the boundary.
+         */
+        void initialiseTileSegments(const Boundary&, const std::vector<double>&, double);
+
+        //! Compute the signed distance of the nodes in a single tile.
+        /*! \param signedDistance
+                The nodal signed distance function (level set).
+
+            \param cutOff
+                The maximum distance from the boundary.
+
+            \param tile
+                The index of the tile.
+         */
+        void transformTile(std::vector<double>&, double, unsigned int) const;
+    };
+}
+
+#endif  /* _CLOSESTPOINTTRANSFORM_H */
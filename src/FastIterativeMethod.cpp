@@ -0,0 +1,350 @@
+/*
+  Copyright (c) 2015-2017 Lester Hedges <lester.hedges+slsm@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "FastIterativeMethod.h"
+#include "Mesh.h"
+
+/*! \file FastIterativeMethod.cpp
+    \brief An implementation of the Fast Iterative Method.
+ */
+
+namespace slsm
+{
+    FastIterativeMethod::FastIterativeMethod(const Mesh& mesh_, double tolerance_) :
+        mesh(mesh_),
+        tolerance(tolerance_),
+        outOfBounds(mesh.nNodes)
+    {
+        signedDistance = nullptr;
+        velocity = nullptr;
+
+        // Resize data structures.
+        distance.resize(mesh.nNodes);
+        isFixed.resize(mesh.nNodes);
+        isListed.resize(mesh.nNodes, 0);
+    }
+
+    unsigned int FastIterativeMethod::march(std::vector<double>& signedDistance_)
+    {
+        signedDistance = &signedDistance_;
+        isVelocity = false;
+        isNarrowBand = false;
+
+        // Fix the distance of nodes adjacent to the zero contour.
+        initialise();
+
+        // Find the solution.
+        unsigned int nIterations = solve();
+
+        // Copy the solution back to the level set, restoring the sign.
+        // Nodes that weren't reached, i.e. if there is no zero contour,
+        // are left unchanged.
+        #pragma omp parallel for
+        for (unsigned int i=0;i<mesh.nNodes;i++)
+        {
+            if (distance[i] != maxDouble)
+                (*signedDistance)[i] = ((*signedDistance)[i] < 0) ? -distance[i] : distance[i];
+        }
+
+        return nIterations;
+    }
+
+    unsigned int FastIterativeMethod::march(std::vector<double>& signedDistance_, std::vector<double>& velocity_)
+    {
+        /* Extend boundary velocities to all nodes within the narrow band region.
+
+           Note that this method assumes that boundary point velocities have
+           already been mapped to the level set nodes using inverse squared
+           distance interpolation, or similar.
+         */
+
+        signedDistance = &signedDistance_;
+        velocity = &velocity_;
+        isVelocity = true;
+        isNarrowBand = true;
+
+        // Fix the distance of nodes adjacent to the zero contour.
+        initialise();
+
+        // Find the solution. The signed distance function is unchanged.
+        return solve();
+    }
+
+    void FastIterativeMethod::initialise()
+    {
+        // Check whether the neighbours of each node are on opposite sides of
+        // the zero contour. This matches the initialisation of the frozen
+        // nodes in the Fast Marching Method.
+        #pragma omp parallel for
+        for (unsigned int i=0;i<mesh.nNodes;i++)
+        {
+            double value = (*signedDistance)[i];
+
+            // Zero contour passes through node.
+            if (value == 0)
+            {
+                distance[i] = 0;
+                isFixed[i] = 1;
+                continue;
+            }
+
+            // Whether level set changes sign between a node and its neighbour.
+            bool isBorder = false;
+
+            // Initialise distance array.
+            double dist[2] = {0, 0};
+
+            // Loop over all neighbours (left, right, down, up).
+            for (unsigned int j=0;j<4;j++)
+            {
+                unsigned int neighbour = mesh.neighbour(i, j);
+
+                // Make sure neighbour lies inside domain boundary.
+                if (neighbour != outOfBounds)
+                {
+                    // Level set changes sign along direction.
+                    if ((value * (*signedDistance)[neighbour]) < 0)
+                    {
+                        isBorder = true;
+
+                        // Calculate the distance to the zero contour (linear interpolation).
+                        double d = value / (value - (*signedDistance)[neighbour]);
+
+                        // Set dimension (neighbours 0 and 1 are x dimension, 2 and 3 are y).
+                        unsigned int dim = (j < 2) ? 0 : 1;
+
+                        // Check if distance is less than current value.
+                        if (dist[dim] == 0 || dist[dim] > d)
+                            dist[dim] = d;
+                    }
+                }
+            }
+
+            // Node and neighbour span the zero contour.
+            if (isBorder)
+            {
+                double distSum = 0;
+
+                // Calculate perpendicular distance to boundary (Pythag.)
+                for (unsigned int j=0;j<2;j++)
+                {
+                    if (dist[j] > 0)
+                        distSum += 1.0 / (dist[j] * dist[j]);
+                }
+
+                distance[i] = sqrt(1.0 / distSum);
+                isFixed[i] = 1;
+            }
+            else
+            {
+                distance[i] = maxDouble;
+                isFixed[i] = 0;
+            }
+        }
+
+        // Add the neighbours of the fixed nodes to the active list.
+        activeList.clear();
+        for (unsigned int i=0;i<mesh.nNodes;i++)
+        {
+            if (!isFixed[i] && (!isNarrowBand || mesh.isActive[i]))
+            {
+                for (unsigned int j=0;j<4;j++)
+                {
+                    unsigned int neighbour = mesh.neighbour(i, j);
+
+                    if ((neighbour != outOfBounds) && isFixed[neighbour])
+                    {
+                        activeList.push_back(i);
+                        isListed[i] = 1;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    unsigned int FastIterativeMethod::solve()
+    {
+        /* This is the fast iterative method main loop. The order
+           of operations is as follows...
+
+            (1) Compute a new value for each node in the active list
+                from the values of the previous iteration.
+
+            (2) Update the nodes whose value has decreased. Nodes whose
+                value has converged are removed from the list.
+
+            (3) For each neighbour of a converged node that isn't fixed,
+                or in the list, add it to the list if its value would
+                decrease.
+         */
+
+        // The number of iterations.
+        unsigned int nIterations = 0;
+
+        while (!activeList.empty())
+        {
+            unsigned int nActive = activeList.size();
+
+            newDistance.resize(nActive);
+            newVelocity.resize(nActive);
+            isConverged.resize(nActive);
+            candidates.resize(4*nActive);
+
+            // Compute updated values.
+            #pragma omp parallel for
+            for (unsigned int i=0;i<nActive;i++)
+                newDistance[i] = updateNode(activeList[i], newVelocity[i]);
+
+            // Update values and check for convergence.
+            #pragma omp parallel for
+            for (unsigned int i=0;i<nActive;i++)
+            {
+                unsigned int node = activeList[i];
+
+                isConverged[i] = ((distance[node] - newDistance[i]) <= tolerance);
+
+                if (newDistance[i] < distance[node])
+                {
+                    distance[node] = newDistance[i];
+                    if (isVelocity) (*velocity)[node] = newVelocity[i];
+                }
+            }
+
+            // Find the neighbours of converged nodes that need updating.
+            #pragma omp parallel for
+            for (unsigned int i=0;i<nActive;i++)
+            {
+                for (unsigned int j=0;j<4;j++)
+                {
+                    unsigned int candidate = outOfBounds;
+
+                    if (isConverged[i])
+                    {
+                        unsigned int neighbour = mesh.neighbour(activeList[i], j);
+
+                        if ((neighbour != outOfBounds) && !isFixed[neighbour] && !isListed[neighbour]
+                            && (!isNarrowBand || mesh.isActive[neighbour]))
+                        {
+                            double v;
+                            if (updateNode(neighbour, v) < distance[neighbour])
+                                candidate = neighbour;
+                        }
+                    }
+
+                    candidates[4*i + j] = candidate;
+                }
+            }
+
+            // Rebuild the active list: unconverged nodes first, then new nodes.
+            nextList.clear();
+            for (unsigned int i=0;i<nActive;i++)
+            {
+                if (!isConverged[i]) nextList.push_back(activeList[i]);
+                else isListed[activeList[i]] = 0;
+            }
+            for (unsigned int i=0;i<4*nActive;i++)
+            {
+                unsigned int candidate = candidates[i];
+
+                if ((candidate != outOfBounds) && !isListed[candidate])
+                {
+                    nextList.push_back(candidate);
+                    isListed[candidate] = 1;
+                }
+            }
+            activeList.swap(nextList);
+
+            nIterations++;
+        }
+
+        return nIterations;
+    }
+
+    double FastIterativeMethod::updateNode(unsigned int node, double& nodeVelocity) const
+    {
+        // The minimum neighbouring distance in each direction, and the
+        // neighbour that it belongs to.
+        double a = maxDouble;
+        double b = maxDouble;
+        unsigned int nodeA = outOfBounds;
+        unsigned int nodeB = outOfBounds;
+
+        for (unsigned int j=0;j<4;j++)
+        {
+            unsigned int neighbour = mesh.neighbour(node, j);
+
+            if (neighbour != outOfBounds)
+            {
+                if (j < 2)
+                {
+                    if (distance[neighbour] < a)
+                    {
+                        a = distance[neighbour];
+                        nodeA = neighbour;
+                    }
+                }
+                else
+                {
+                    if (distance[neighbour] < b)
+                    {
+                        b = distance[neighbour];
+                        nodeB = neighbour;
+                    }
+                }
+            }
+        }
+
+        if (a > b)
+        {
+            std::swap(a, b);
+            std::swap(nodeA, nodeB);
+        }
+
+        // No neighbour has been reached.
+        if (a == maxDouble) return maxDouble;
+
+        // Godunov upwind solution (unit grid spacing).
+        double d;
+        if ((b - a) >= 1)
+        {
+            d = a + 1;
+
+            // The velocity is extended from the single upwind neighbour.
+            if (isVelocity) nodeVelocity = (*velocity)[nodeA];
+        }
+        else
+        {
+            d = 0.5*(a + b + sqrt(2 - (b - a)*(b - a)));
+
+            // Weight the velocity of the upwind neighbours, such that
+            // grad v . grad T = 0.
+            if (isVelocity)
+            {
+                double weightA = d - a;
+                double weightB = d - b;
+
+                nodeVelocity = (weightA*(*velocity)[nodeA] + weightB*(*velocity)[nodeB]) / (weightA + weightB);
+            }
+        }
+
+        return d;
+    }
+}
@@ -0,0 +1,174 @@
+/*
+  Copyright (c) 2015-2017 Lester Hedges <lester.hedges+slsm@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _FASTITERATIVEMETHOD_H
+#define _FASTITERATIVEMETHOD_H
+
+#include <limits>
+#include <vector>
+
+/*! \file FastIterativeMethod.h
+    \brief An implementation of the Fast Iterative Method.
+ */
+
+namespace slsm
+{
+    // FORWARD DECLARATIONS
+
+    class Mesh;
+
+    // MAIN CLASS
+
+    /*! \brief An implementation of the Fast Iterative Method for finding
+        approximate solutions to the Eikonal equation:
+
+            | grad T(x) | = 1
+
+        This object can be used to reinitialise the level set to a signed
+        distance function, or to compute extension velocities using known
+        values at the boundary, as an alternative to the Fast Marching Method.
+        Nodes adjacent to the zero contour are fixed in the same way. Rather
+        than ordering the remaining nodes with a priority queue, an active list
+        of nodes at the front of the solution is updated iteratively using a
+        first order Godunov upwind scheme. Nodes are removed from the list once
+        their value has converged, at which point any neighbours whose value
+        would decrease are added. See:
+
+            W.-K. Jeong and R. T. Whitaker, "A fast iterative method for
+            Eikonal equations", SIAM J. Sci. Comput. 30, 2512-2534 (2008).
+
+        Each iteration updates every node in the active list concurrently. New
+        values are computed from those of the previous iteration (Jacobi
+        updates) and the list is rebuilt in a fixed order, so the solution is
+        independent of the number of threads.
+
+        When extending velocities, the velocity of a node is found alongside
+        its distance, by solving grad v . grad T = 0 using the same upwind
+        neighbours. As for the Fast Marching Method, velocity extension is
+        restricted to the narrow band and the signed distance function is
+        unchanged.
+     */
+    class FastIterativeMethod
+    {
+    public:
+        //! Constructor.
+        /*! \param mesh_
+                A reference to the level set mesh.
+
+            \param tolerance_
+                The convergence tolerance: a node is removed from the active
+                list when its value changes by less than this amount.
+         */
+        FastIterativeMethod(const Mesh&, double tolerance_ = 1e-10);
+
+        //! Excecute the Fast Iterative Method for reinitialisation of the signed distance function.
+        /*! \param signedDistance_
+                The nodal signed distance function (level set).
+
+            \return
+                The number of iterations.
+         */
+        unsigned int march(std::vector<double>&);
+
+        //! Excecute the Fast Iterative Method for velocity extension.
+        /*! \param signedDistance_
+                The nodal signed distance function (level set).
+
+            \param velocity_
+                The nodal velocities.
+
+            \return
+                The number of iterations.
+         */
+        unsigned int march(std::vector<double>&, std::vector<double>&);
+
+    private:
+        /// A const reference to the level set mesh.
+        const Mesh& mesh;
+
+        /// The convergence tolerance.
+        double tolerance;
+
+        /// Out of bounds neighbour flag.
+        unsigned int outOfBounds;
+
+        /// Whether velocity extension is active (distance extension if not).
+        bool isVelocity;
+
+        /// Whether the solution is restricted to the narrow band.
+        bool isNarrowBand;
+
+        /// A pointer to the signed distance vector.
+        std::vector<double>* signedDistance;
+
+        /// A pointer to the velocity vector.
+        std::vector<double>* velocity;
+
+        /// The unsigned distance from the zero contour.
+        std::vector<double> distance;
+
+        /// Whether the distance at each node is fixed (char, so that nodes can be read concurrently).
+        std::vector<char> isFixed;
+
+        /// Whether each node is in the active list.
+        std::vector<char> isListed;
+
+        /// Indices of nodes in the active list.
+        std::vector<unsigned int> activeList;
+
+        /// Indices of nodes in the active list for the next iteration.
+        std::vector<unsigned int> nextList;
+
+        /// The updated distance of each node in the active list.
+        std::vector<double> newDistance;
+
+        /// The updated velocity of each node in the active list.
+        std::vector<double> newVelocity;
+
+        /// Whether the value of each node in the active list has converged.
+        std::vector<char> isConverged;
+
+        /// Neighbours of each converged node to add to the active list (four per node).
+        std::vector<unsigned int> candidates;
+
+        //! Fix the distance of nodes adjacent to the zero contour and initialise
+        //! the active list.
+        void initialise();
+
+        //! Iteratively update the active list until it is empty.
+        /*! \return
+                The number of iterations.
+         */
+        unsigned int solve();
+
+        //! Compute the distance (and velocity) at a node from its neighbours.
+        /*! \param node
+                The index of the node.
+
+            \param nodeVelocity
+                The extension velocity at the node (filled by function).
+
+            \return
+                The distance at the node.
+         */
+        double updateNode(unsigned int, double&) const;
+
+        const double maxDouble = std::numeric_limits<double>::max();
+    };
+}
+
+#endif  /* _FASTITERATIVEMETHOD_H */
@@ -23,6 +23,7 @@
 #include "Debug.h"
 #include "FastMarchingMethod.h"
 #include "Heap.h"
+#include "UntidyQueue.h"
 #include "Mesh.h"
 
 /*! \file FastMarchingMethod.cpp
@@ -31,28 +32,46 @@
 
 namespace slsm
 {
-    FastMarchingMethod::FastMarchingMethod(const Mesh& mesh_, bool isTest_) :
+    FastMarchingMethod::FastMarchingMethod(const Mesh& mesh_, bool isTest_,
+        FMM_QueueType::FMM_QueueType queueType_, double bucketWidth) :
         mesh(mesh_),
+        queueType(queueType_),
         isTest(isTest_),
         outOfBounds(mesh.nNodes)
     {
-        heap = nullptr;
+        band = nullptr;
+        cutOff = maxDouble;
+        isRecord = false;
 
         // Resize data structures.
         heapPtr.resize(mesh.nNodes);
         nodeStatus.resize(mesh.nNodes);
         signedDistanceCopy.resize(mesh.nNodes);
+        toFreeze.resize(mesh.nNodes);
+        frozen.reserve(mesh.nNodes);
+
+        // Initialise the priority queue. This is large enough to hold every
+        // node, so can be reused for each march.
+        heap = nullptr;
+        untidyQueue = nullptr;
+
+        if (queueType == FMM_QueueType::UNTIDY)
+            untidyQueue = new UntidyQueue(mesh.nNodes, bucketWidth);
+        else
+            heap = new Heap(mesh.nNodes, isTest);
     }
 
     FastMarchingMethod::~FastMarchingMethod()
     {
         delete heap;
+        delete untidyQueue;
     }
 
     void FastMarchingMethod::march(std::vector<double>& signedDistance_)
     {
         signedDistance = &signedDistance_;
         isVelocity = false;
+        isNarrowBand = false;
 
         // Initialise the set of frozen boundary nodes.
         initialiseFrozen();
@@ -65,6 +84,31 @@ namespace slsm
 
         // Find the fast marching solution.
         solve();
+
+        // Set the far field beyond the cut-off distance.
+        if (cutOff < maxDouble) initialiseFarField();
+
+        // Reset the status of the frozen nodes.
+        reset();
+    }
+
+    void FastMarchingMethod::march(std::vector<double>& signedDistance_,
+        double bandWidth_, std::vector<unsigned int>& band_, double cutOff_, bool isRecord_)
+    {
+        band = &band_;
+        bandWidth = bandWidth_;
+        band->clear();
+        cutOff = cutOff_;
+
+        // Any previous recording is invalidated by the march.
+        isRecord = isRecord_;
+        dependencies.clear();
+
+        march(signedDistance_);
+
+        band = nullptr;
+        cutOff = maxDouble;
+        isRecord = false;
     }
 
     void FastMarchingMethod::march(std::vector<double>& signedDistance_, std::vector<double>& velocity_)
@@ -79,6 +123,7 @@ namespace slsm
         signedDistance = &signedDistance_;
         velocity = &velocity_;
         isVelocity = true;
+        isNarrowBand = true;
 
         // Initialise the set of frozen boundary nodes.
         initialiseFrozen();
@@ -92,10 +137,59 @@ namespace slsm
         // Find the fast marching solution.
         solve();
 
+        // Reset the status of the frozen nodes.
+        reset();
+
         // Restore the original signed distance function. Only update velocities.
         (*signedDistance) = signedDistanceCopy;
     }
 
+    void FastMarchingMethod::march(std::vector<double>& signedDistance_, std::vector<double>& velocity_,
+        double bandWidth_, std::vector<unsigned int>& band_, double cutOff_)
+    {
+        /* Reinitialise the signed distance function and extend boundary
+           velocities in a single pass.
+
+           The distance is found in the same way as for reinitialisation,
+           i.e. the march covers the whole domain, and the velocity of each
+           node is set as it is frozen. As such, velocities are extended
+           beyond the narrow band, which is rebuilt from the new signed
+           distance function.
+         */
+
+        signedDistance = &signedDistance_;
+        velocity = &velocity_;
+        isVelocity = true;
+        isNarrowBand = false;
+
+        band = &band_;
+        bandWidth = bandWidth_;
+        band->clear();
+        cutOff = cutOff_;
+
+        // Initialise the set of frozen boundary nodes.
+        initialiseFrozen();
+
+        // Initialise the heap data structure.
+        initialiseHeap();
+
+        // Initialise the set of trial nodes adjacent to the boundary.
+        initialiseTrial();
+
+        // Find the fast marching solution.
+        solve();
+
+        // Set the far field beyond the cut-off distance. Velocities are
+        // left unchanged.
+        if (cutOff < maxDouble) initialiseFarField();
+
+        // Reset the status of the frozen nodes.
+        reset();
+
+        band = nullptr;
+        cutOff = maxDouble;
+    }
+
     void FastMarchingMethod::initialiseFrozen()
     {
         // The number of frozen nodes.
@@ -115,6 +209,7 @@ namespace slsm
                 {
                     // Mark node as frozen.
                     nodeStatus[i] = FMM_NodeStatus::FROZEN;
+                    recordFrozen(i);
 
                     // Increment number of frozen nodes.
                     nFrozen++;
@@ -141,7 +236,7 @@ namespace slsm
                     // Neighbours are ordered: left, right, down, up.
 
                     // Get index of neighbour.
-                    unsigned int neighbour = mesh.nodes[i].neighbours[j];
+                    unsigned int neighbour = mesh.neighbour(i, j);
 
                     // Make sure neighbour lies inside domain boundary.
                     if (neighbour != outOfBounds)
@@ -183,6 +278,7 @@ namespace slsm
 
                     // Flag node as frozen.
                     nodeStatus[i] = FMM_NodeStatus::FROZEN;
+                    recordFrozen(i);
 
                     // Increment number of frozen nodes.
                     nFrozen++;
@@ -201,18 +297,9 @@ namespace slsm
 
     void FastMarchingMethod::initialiseHeap()
     {
-        // Initialise the maximum heap size.
-        unsigned int maxHeapSize = 0;
-
-        // Loop over all nodes.
-        for (unsigned int i=0;i<mesh.nNodes;i++)
-        {
-            // Find nodes without a status (far field).
-            if (nodeStatus[i] == FMM_NodeStatus::NONE)
-                maxHeapSize++;
-        }
-
-        heap = new Heap(maxHeapSize, isTest);
+        // The queue is large enough to hold every node, so it only needs emptying.
+        if (heap) heap->clear();
+        else untidyQueue->clear();
     }
 
     void FastMarchingMethod::initialiseTrial()
@@ -228,7 +315,7 @@ namespace slsm
                 // Loop over all nearest neighbour nodes.
                 for (unsigned int j=0;j<4;j++)
                 {
-                    unsigned int neighbour = mesh.nodes[i].neighbours[j];
+                    unsigned int neighbour = mesh.neighbour(i, j);
 
                     // Neighbour lies within the domain boundary.
                     if (neighbour != outOfBounds)
@@ -239,22 +326,8 @@ namespace slsm
                             // Check that node status hasn't been updated.
                             if (nodeStatus[i] == FMM_NodeStatus::NONE)
                             {
-                                if (isVelocity)
-                                {
-                                    // Node lies inside the narrow band region.
-                                    if (mesh.nodes[i].isActive)
-                                    {
-                                        // Flag node as in trial band.
-                                        nodeStatus[i] = FMM_NodeStatus::TRIAL;
-
-                                        // Get distance from zero contour.
-                                        (*signedDistance)[i] = updateNode(i);
-
-                                        // Add to heap.
-                                        heapPtr[i] = heap->push(i, std::abs((*signedDistance)[i]));
-                                    }
-                                }
-                                else
+                                // Node lies inside the narrow band region (if restricted).
+                                if (!isNarrowBand || mesh.isActive[i])
                                 {
                                     // Flag node as in trial band.
                                     nodeStatus[i] = FMM_NodeStatus::TRIAL;
@@ -263,7 +336,7 @@ namespace slsm
                                     (*signedDistance)[i] = updateNode(i);
 
                                     // Add to heap.
-                                    heapPtr[i] = heap->push(i, std::abs((*signedDistance)[i]));
+                                    heapPtr[i] = queuePush(i, std::abs((*signedDistance)[i]));
                                 }
                             }
                         }
@@ -294,10 +367,8 @@ namespace slsm
         // Number of nodes to freeze.
         unsigned int nFrozen;
 
-        // Indices of nodes that are to be frozen.
-        std::vector<unsigned int> toFreeze(mesh.nNodes);
-
-        while (!heap->empty())
+        // Stop once the front passes the cut-off distance.
+        while (!queueEmpty() && (queuePeek() <= cutOff))
         {
             unsigned int addr;
             double value;
@@ -306,14 +377,18 @@ namespace slsm
             nFrozen = 0;
 
             // Pop top entry off heap.
-            heap->pop(addr, value);
+            queuePop(addr, value);
 
             // Mark node as frozen.
             nodeStatus[addr] = FMM_NodeStatus::FROZEN;
+            recordFrozen(addr);
 
             // Set final velocity.
             if (isVelocity) finaliseVelocity(addr);
 
+            // Record upwind dependencies.
+            if (isRecord) recordDependency(addr);
+
             // Increment number of frozen nodes.
             toFreeze[nFrozen] = addr;
             nFrozen++;
@@ -323,20 +398,24 @@ namespace slsm
 
             while (!isDone)
             {
-                if (!heap->empty() && (value == heap->peek()))
+                if (!queueEmpty() && (value == queuePeek()))
                 {
                     unsigned int l_addr;
                     double l_value;
 
                     // Pop top entry off heap.
-                    heap->pop(l_addr, l_value);
+                    queuePop(l_addr, l_value);
 
                     // Mark node as frozen.
                     nodeStatus[l_addr] = FMM_NodeStatus::FROZEN;
+                    recordFrozen(l_addr);
 
                     // Set final velocity.
                     if (isVelocity) finaliseVelocity(l_addr);
 
+                    // Record upwind dependencies.
+                    if (isRecord) recordDependency(l_addr);
+
                     // Increment number of frozen nodes.
                     toFreeze[nFrozen] = l_addr;
                     nFrozen++;
@@ -354,7 +433,7 @@ namespace slsm
                 for (unsigned int j=0;j<4;j++)
                 {
                     // Get address of neighbour.
-                    unsigned int naddr = mesh.nodes[addr].neighbours[j];
+                    unsigned int naddr = mesh.neighbour(addr, j);
 
                     // Neighbour lies within domain boundary.
                     if (naddr != outOfBounds)
@@ -370,30 +449,19 @@ namespace slsm
                             if (nodeStatus[naddr] & FMM_NodeStatus::TRIAL)
                             {
                                 // Update value in heap.
-                                heap->set(heapPtr[naddr], std::abs(d));
+                                queueSet(heapPtr[naddr], std::abs(d));
                             }
                             // Neighbour has no status (far field).
                             else if (nodeStatus[naddr] == FMM_NodeStatus::NONE)
                             {
-                                if (isVelocity)
-                                {
-                                    // Node lies inside the narrow band region.
-                                    if (mesh.nodes[naddr].isActive)
-                                    {
-                                        // Mark node as in trial band.
-                                        nodeStatus[naddr] = FMM_NodeStatus::TRIAL;
-
-                                        // Push onto heap.
-                                        heapPtr[naddr] = heap->push(naddr, std::abs(d));
-                                    }
-                                }
-                                else
+                                // Node lies inside the narrow band region (if restricted).
+                                if (!isNarrowBand || mesh.isActive[naddr])
                                 {
                                     // Mark node as in trial band.
                                     nodeStatus[naddr] = FMM_NodeStatus::TRIAL;
 
                                     // Push onto heap.
-                                    heapPtr[naddr] = heap->push(naddr, std::abs(d));
+                                    heapPtr[naddr] = queuePush(naddr, std::abs(d));
                                 }
                             }
 
@@ -401,7 +469,7 @@ namespace slsm
                             // "jump" over a frozen node if needed.
 
                             // Address of second nearest neighbour in the same direction.
-                            naddr = mesh.nodes[naddr].neighbours[j];
+                            naddr = mesh.neighbour(naddr, j);
 
                             // Next nearest neighbour lies within domain boundary.
                             if (naddr != outOfBounds)
@@ -414,7 +482,7 @@ namespace slsm
                                     (*signedDistance)[naddr] = d;
 
                                     // Update value in heap.
-                                    heap->set(heapPtr[naddr], std::abs(d));
+                                    queueSet(heapPtr[naddr], std::abs(d));
                                 }
                             }
                         }
@@ -424,6 +492,67 @@ namespace slsm
         }
     }
 
+    unsigned int FastMarchingMethod::queuePush(unsigned int node, double value)
+    {
+        if (heap) return heap->push(node, value);
+        else return untidyQueue->push(node, value);
+    }
+
+    void FastMarchingMethod::queuePop(unsigned int& node, double& value)
+    {
+        if (heap) heap->pop(node, value);
+        else untidyQueue->pop(node, value);
+    }
+
+    void FastMarchingMethod::queueSet(unsigned int index, double value)
+    {
+        if (heap) heap->set(index, value);
+        else untidyQueue->set(index, value);
+    }
+
+    double FastMarchingMethod::queuePeek() const
+    {
+        if (heap) return heap->peek();
+        else return untidyQueue->peek();
+    }
+
+    bool FastMarchingMethod::queueEmpty() const
+    {
+        if (heap) return heap->empty();
+        else return untidyQueue->empty();
+    }
+
+    void FastMarchingMethod::initialiseFarField()
+    {
+        // Empty the queue, resetting the status of the remaining trial nodes.
+        while (!queueEmpty())
+        {
+            unsigned int addr;
+            double value;
+
+            queuePop(addr, value);
+            nodeStatus[addr] = FMM_NodeStatus::NONE;
+        }
+
+        // Assign the signed cut-off distance to all nodes that weren't frozen.
+        #pragma omp parallel for
+        for (unsigned int i=0;i<mesh.nNodes;i++)
+        {
+            if (nodeStatus[i] != FMM_NodeStatus::FROZEN)
+                (*signedDistance)[i] = (signedDistanceCopy[i] < 0) ? -cutOff : cutOff;
+        }
+    }
+
+    void FastMarchingMethod::reset()
+    {
+        // Once the heap is empty every trial node has been frozen, so these
+        // are the only nodes whose status has changed.
+        for (unsigned int i=0;i<frozen.size();i++)
+            nodeStatus[frozen[i]] = FMM_NodeStatus::NONE;
+
+        frozen.clear();
+    }
+
     double FastMarchingMethod::updateNode(unsigned int node)
     {
         // Reused constants.
@@ -452,7 +581,7 @@ namespace slsm
                 unsigned int index = 2*i + j;
 
                 // First neighbour.
-                unsigned int n1 = mesh.nodes[node].neighbours[index];
+                unsigned int n1 = mesh.neighbour(node, index);
 
                 // Neighbour is within the domain boundary.
                 if (n1 != outOfBounds)
@@ -467,7 +596,7 @@ namespace slsm
                             dist1 = (*signedDistance)[n1];
 
                             // Second neighbour in same direction.
-                            unsigned int n2 = mesh.nodes[n1].neighbours[index];
+                            unsigned int n2 = mesh.neighbour(n1, index);
 
                             // Neighbour is within the domain boundary.
                             if (n2 != outOfBounds)
@@ -539,7 +668,7 @@ namespace slsm
             unsigned int dim = (i < 2) ? 0 : 1;
 
             // Get index of neighbour.
-            unsigned int neighbour = mesh.nodes[node].neighbours[i];
+            unsigned int neighbour = mesh.neighbour(node, i);
 
             // Neighbour is within domain boundary.
             if (neighbour != outOfBounds)
@@ -590,6 +719,80 @@ namespace slsm
         exit(EXIT_FAILURE);
     }
 
+    void FastMarchingMethod::recordDependency(unsigned int node)
+    {
+        // Velocities are only extended within the narrow band.
+        if (std::abs((*signedDistance)[node]) >= bandWidth) return;
+
+        // The upwind neighbours are chosen in the same way as for finaliseVelocity.
+
+        Dependency dependency;
+        dependency.node = node;
+
+        // Unset dimensions refer to the node itself, with zero weight.
+        double frontDist[2] = {0, 0};
+        bool isSet[2] = {false, false};
+
+        for (unsigned int i=0;i<2;i++)
+        {
+            dependency.neighbour[i] = node;
+            dependency.weight[i] = 0;
+        }
+
+        // Loop over all neighbours of the node.
+        for (unsigned int i=0;i<4;i++)
+        {
+            // Set dimension (neighbours 0 and 1 are x dimension, 2 and 3 are y).
+            unsigned int dim = (i < 2) ? 0 : 1;
+
+            // Get index of neighbour.
+            unsigned int neighbour = mesh.neighbour(node, i);
+
+            // Neighbour is within domain boundary and is frozen.
+            if ((neighbour != outOfBounds) && (nodeStatus[neighbour] & FMM_NodeStatus::FROZEN))
+            {
+                // Absolute signed distance of the neighbouring node.
+                double d = std::abs((*signedDistance)[neighbour]);
+
+                // Check whether the neighbour is closer to the zero contour.
+                if (!isSet[dim] || (frontDist[dim] > d))
+                {
+                    frontDist[dim] = d;
+                    isSet[dim] = true;
+
+                    dependency.neighbour[dim] = neighbour;
+                    dependency.weight[dim] = std::abs((*signedDistance)[node] - (*signedDistance)[neighbour]);
+                }
+            }
+        }
+
+        // Nodes without upwind weight keep their velocity.
+        if ((dependency.weight[0] + dependency.weight[1]) == 0) return;
+
+        dependencies.push_back(dependency);
+    }
+
+    void FastMarchingMethod::replay(std::vector<double>& velocity_) const
+    {
+        // Upwind neighbours are always replayed before the nodes that depend on them.
+        for (unsigned int i=0;i<dependencies.size();i++)
+        {
+            const Dependency& dependency = dependencies[i];
+
+            // Accumulate in the same order as finaliseVelocity.
+            double numerator = 0;
+            double denominator = 0;
+
+            for (unsigned int j=0;j<2;j++)
+            {
+                numerator += dependency.weight[j] * velocity_[dependency.neighbour[j]];
+                denominator += dependency.weight[j];
+            }
+
+            velocity_[dependency.node] = numerator / denominator;
+        }
+    }
+
     double FastMarchingMethod::solveQuadratic(unsigned int node, const double& a, const double& b, const double& c) const
     {
         // Initialise roots.
@@ -21,6 +21,7 @@
 #ifndef _FASTMARCHINGMETHOD_H
 #define _FASTMARCHINGMETHOD_H
 
+#include <cmath>
 #include <limits>
 #include <vector>
 
@@ -34,6 +35,7 @@ namespace slsm
 
     class Heap;
     class Mesh;
+    class UntidyQueue;
 
     // ASSOCIATED DATA TYPES
 
@@ -51,6 +53,16 @@ namespace slsm
         };
     }
 
+    //! The priority queue used to order trial nodes.
+    namespace FMM_QueueType
+    {
+        enum FMM_QueueType
+        {
+            HEAP   = 0,     //!< Binary heap (exact ordering, O(N log N)).
+            UNTIDY = 1,     //!< Untidy bucketed queue (approximate ordering, O(N)).
+        };
+    }
+
     // MAIN CLASS
 
     /*! \brief An implementation of the Fast Marching Method for finding
@@ -62,6 +74,28 @@ namespace slsm
         This object can be used to reinitialise the level set to a signed
         distance function, or to compute extension velocities using known
         values at the boundary.
+
+        The object can be reused for any number of marches on the same mesh.
+        All storage, including the heap, is allocated on construction, and
+        only the status of the nodes frozen during a march is reset following
+        it, so repeated marches don't allocate memory.
+
+        Trial nodes are ordered using a binary heap by default. Alternatively,
+        an untidy (bucketed) priority queue can be used, which makes the march
+        O(N) at the expense of an additional error proportional to the bucket
+        width (see UntidyQueue).
+
+        When reinitialising, the march can be stopped once the front passes a
+        cut-off distance from the zero contour, so that the cost is proportional
+        to the area within the cut-off, rather than that of the mesh. Since nodes
+        are frozen in order of increasing distance, the nodes within the cut-off
+        have the same values as for a march over the whole mesh.
+
+        A reinitialising march can also record the upwind dependencies of each
+        node within the narrow band as it is frozen. Provided that the signed
+        distance function is unchanged, velocities can then be extended by
+        replaying these in freeze order, i.e. as a single linear pass with no
+        priority queue and no quadratic solves.
      */
     class FastMarchingMethod
     {
@@ -72,12 +106,23 @@ namespace slsm
 
             \param isTest_
                 Whether to test the heap following each update.
+
+            \param queueType_
+                The type of priority queue used to order trial nodes.
+
+            \param bucketWidth
+                The bucket width of the untidy priority queue.
          */
-        FastMarchingMethod(const Mesh&, bool isTest_=false);
+        FastMarchingMethod(const Mesh&, bool isTest_=false,
+            FMM_QueueType::FMM_QueueType queueType_=FMM_QueueType::HEAP, double bucketWidth=0.05);
 
         //! Destructor.
         ~FastMarchingMethod();
 
+        // The object owns its priority queue, so can't be copied.
+        FastMarchingMethod(const FastMarchingMethod&) = delete;
+        FastMarchingMethod& operator=(const FastMarchingMethod&) = delete;
+
         //! Excecute Fast Marching for reinitialisation of the signed distance function.
         /*! \param signedDistance_
                 The nodal signed distance function (level set).
@@ -93,13 +138,96 @@ namespace slsm
          */
         void march(std::vector<double>&, std::vector<double>&);
 
+        //! Excecute Fast Marching for reinitialisation of the signed distance function,
+        //! recording the nodes that lie within a narrow band of the zero contour.
+        /*! Since nodes are frozen in order of increasing distance from the zero
+            contour, the narrow band is found without searching the whole mesh.
+
+            \param signedDistance_
+                The nodal signed distance function (level set).
+
+            \param bandWidth_
+                The width of the narrow band.
+
+            \param band_
+                Indices of nodes whose absolute signed distance is less than the
+                band width, in the order that they were frozen (filled by function).
+
+            \param cutOff_
+                The march stops once the front passes this distance from the zero
+                contour. Nodes that haven't been frozen are assigned the cut-off
+                distance, with the sign of the original level set (optional).
+
+            \param isRecord_
+                Whether to record the upwind dependencies of the narrow band
+                nodes, so that velocity extension can be replayed (optional).
+         */
+        void march(std::vector<double>&, double, std::vector<unsigned int>&,
+            double cutOff_ = std::numeric_limits<double>::max(), bool isRecord_ = false);
+
+        //! Excecute Fast Marching for reinitialisation of the signed distance function
+        //! and velocity extension in a single pass.
+        /*! The velocity of every node is set as it is frozen, so velocities are
+            extended to the whole domain rather than just the current narrow band.
+            The nodes within the new narrow band are recorded as for reinitialisation.
+
+            \param signedDistance_
+                The nodal signed distance function (level set).
+
+            \param velocity_
+                The nodal velocities.
+
+            \param bandWidth_
+                The width of the narrow band.
+
+            \param band_
+                Indices of nodes whose absolute signed distance is less than the
+                band width, in the order that they were frozen (filled by function).
+
+            \param cutOff_
+                The march stops once the front passes this distance from the zero
+                contour. Nodes that haven't been frozen are assigned the cut-off
+                distance, with the sign of the original level set, and their
+                velocities are unchanged (optional).
+         */
+        void march(std::vector<double>&, std::vector<double>&, double, std::vector<unsigned int>&,
+            double cutOff_ = std::numeric_limits<double>::max());
+
+        //! Extend velocities by replaying the upwind dependencies recorded during
+        //! the last reinitialising march.
+        /*! Each narrow band node that isn't on the boundary is assigned the
+            distance weighted average of the velocities of its upwind neighbours,
+            in the order that the nodes were frozen. The result is the same as
+            that of the single pass reinitialisation and velocity extension march
+            for these nodes. The signed distance function must not have changed
+            since the recording was made. Other velocities are unchanged.
+
+            \param velocity_
+                The nodal velocities.
+         */
+        void replay(std::vector<double>&) const;
+
     private:
+        //! The upwind dependencies of a node frozen during a recorded march.
+        struct Dependency
+        {
+            unsigned int node;              ///< The index of the node.
+            unsigned int neighbour[2];      ///< The upwind neighbour in each dimension.
+            double weight[2];               ///< The velocity weight of each neighbour (zero if unset).
+        };
+
         /// A const reference to the level set mesh.
         const Mesh& mesh;
 
         /// The ascending unsigned distance priority queue.
         Heap *heap;
 
+        /// The untidy unsigned distance priority queue (if used in place of the heap).
+        UntidyQueue *untidyQueue;
+
+        /// The type of priority queue.
+        FMM_QueueType::FMM_QueueType queueType;
+
         /// Back pointers to the heap.
         std::vector<unsigned int> heapPtr;
 
@@ -109,6 +237,9 @@ namespace slsm
         /// Whether velocity extension is active (distance extension if not).
         bool isVelocity;
 
+        /// Whether the march is restricted to the narrow band.
+        bool isNarrowBand;
+
         /// Out of bounds neighbour flag.
         unsigned int outOfBounds;
 
@@ -118,12 +249,96 @@ namespace slsm
         /// A copy of the initial signed distance function.
         std::vector<double> signedDistanceCopy;
 
+        /// Indices of nodes that are to be frozen.
+        std::vector<unsigned int> toFreeze;
+
+        /// Indices of nodes frozen during the current march.
+        std::vector<unsigned int> frozen;
+
         /// A pointer to the signed distance vector.
         std::vector<double>* signedDistance;
 
         /// A pointer to the velocity vector.
         std::vector<double>* velocity;
 
+        /// A pointer to the narrow band vector (null if the band isn't recorded).
+        std::vector<unsigned int>* band;
+
+        /// The width of the recorded narrow band.
+        double bandWidth;
+
+        /// The distance from the zero contour at which the march stops.
+        double cutOff;
+
+        /// Whether upwind dependencies are recorded during the march.
+        bool isRecord;
+
+        /// The upwind dependencies of the narrow band nodes, in freeze order.
+        std::vector<Dependency> dependencies;
+
+        //! Record a frozen node, so that its status can be reset following the
+        //! march, and add it to the narrow band if it lies within it.
+        /*! \param node
+                The index of the node.
+         */
+        void recordFrozen(unsigned int node)
+        {
+            frozen.push_back(node);
+
+            if (band && (std::abs((*signedDistance)[node]) < bandWidth))
+                band->push_back(node);
+        }
+
+        //! Push a node onto the priority queue.
+        /*! \param node
+                The index of the node.
+
+            \param value
+                The unsigned distance of the node.
+
+            \return
+                The index of the node in the queue.
+         */
+        unsigned int queuePush(unsigned int, double);
+
+        //! Pop the node with the lowest distance from the priority queue.
+        /*! \param node
+                The index of the node.
+
+            \param value
+                The unsigned distance of the node.
+         */
+        void queuePop(unsigned int&, double&);
+
+        //! Update the distance of a node in the priority queue.
+        /*! \param index
+                The index of the node in the queue.
+
+            \param value
+                The new unsigned distance of the node.
+         */
+        void queueSet(unsigned int, double);
+
+        //! Return the distance of the next node in the priority queue.
+        /*! \return
+                The unsigned distance of the next node.
+         */
+        double queuePeek() const;
+
+        //! Test whether the priority queue is empty.
+        /*! \return
+                Whether the queue is empty.
+         */
+        bool queueEmpty() const;
+
+        //! Empty the priority queue following a march that stopped at the
+        //! cut-off distance and assign the far field value to all nodes that
+        //! weren't frozen.
+        void initialiseFarField();
+
+        //! Reset the status of the nodes frozen during the march.
+        void reset();
+
         //! Find boundary nodes and flag them as frozen.
         void initialiseFrozen();
 
@@ -152,6 +367,12 @@ namespace slsm
          */
         void finaliseVelocity(unsigned int node);
 
+        //! Record the upwind dependencies of a newly frozen node.
+        /*! \param node
+                The index of the node.
+         */
+        void recordDependency(unsigned int node);
+
         //! Solve the quadratic equation.
         /*! \param node
                 The index of the node.
@@ -0,0 +1,249 @@
+/*
+  Copyright (c) 2015-2017 Lester Hedges <lester.hedges+slsm@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "FastSweepingMethod.h"
+#include "Mesh.h"
+
+/*! \file FastSweepingMethod.cpp
+    \brief An implementation of the Fast Sweeping Method.
+ */
+
+namespace slsm
+{
+    FastSweepingMethod::FastSweepingMethod(const Mesh& mesh_, double tolerance_) :
+        mesh(mesh_),
+        tolerance(tolerance_)
+    {
+        // The padded arrays have a layer of ghost nodes around the mesh.
+        stride = mesh.width + 3;
+        unsigned int nPadded = stride * (mesh.height + 3);
+
+        // Ghost nodes lie outside of the domain: they never span the zero
+        // contour and are never updated.
+        phi.resize(nPadded, 0);
+        distance.resize(nPadded, maxDouble);
+        isFixed.resize(nPadded, 1);
+
+        // Divide the nodes into tiles.
+        nTilesX = (mesh.width + tileSize) / tileSize;
+        nTilesY = (mesh.height + tileSize) / tileSize;
+        tileChange.resize(nTilesX * nTilesY);
+    }
+
+    unsigned int FastSweepingMethod::march(std::vector<double>& signedDistance)
+    {
+        // Fix the distance of nodes adjacent to the zero contour.
+        initialise(signedDistance);
+
+        // The number of cycles of sweeps.
+        unsigned int nCycles = 0;
+
+        // The maximum change in distance over a cycle.
+        double change;
+
+        // Sweep in each of the four orderings until the solution converges.
+        do
+        {
+            change = 0;
+
+            for (unsigned int i=0;i<4;i++)
+                change = std::max(change, sweep(i));
+
+            nCycles++;
+        }
+        while (change > tolerance);
+
+        // Copy the solution back to the level set, restoring the sign.
+        // Nodes that weren't reached, i.e. if there is no zero contour,
+        // are left unchanged.
+        #pragma omp parallel for
+        for (unsigned int y=0;y<=mesh.height;y++)
+        {
+            for (unsigned int x=0;x<=mesh.width;x++)
+            {
+                unsigned int p = (y + 1)*stride + x + 1;
+
+                if (distance[p] != maxDouble)
+                    signedDistance[mesh.xyToIndex(x, y)] = (phi[p] < 0) ? -distance[p] : distance[p];
+            }
+        }
+
+        return nCycles;
+    }
+
+    void FastSweepingMethod::initialise(const std::vector<double>& signedDistance)
+    {
+        // Store a copy of the level set.
+        #pragma omp parallel for
+        for (unsigned int y=0;y<=mesh.height;y++)
+        {
+            for (unsigned int x=0;x<=mesh.width;x++)
+                phi[(y + 1)*stride + x + 1] = signedDistance[mesh.xyToIndex(x, y)];
+        }
+
+        // Check whether the neighbours of each node are on opposite sides of
+        // the zero contour. This matches the initialisation of the frozen
+        // nodes in the Fast Marching Method.
+        #pragma omp parallel for
+        for (unsigned int y=0;y<=mesh.height;y++)
+        {
+            for (unsigned int x=0;x<=mesh.width;x++)
+            {
+                unsigned int p = (y + 1)*stride + x + 1;
+
+                // Zero contour passes through node.
+                if (phi[p] == 0)
+                {
+                    distance[p] = 0;
+                    isFixed[p] = 1;
+                    continue;
+                }
+
+                // Whether level set changes sign between a node and its neighbour.
+                bool isBorder = false;
+
+                // Initialise distance array.
+                double dist[2] = {0, 0};
+
+                // Neighbours are ordered: left, right, down, up.
+                unsigned int neighbours[4] = {p - 1, p + 1, p - stride, p + stride};
+
+                for (unsigned int j=0;j<4;j++)
+                {
+                    unsigned int neighbour = neighbours[j];
+
+                    // Level set changes sign along direction.
+                    if ((phi[p] * phi[neighbour]) < 0)
+                    {
+                        isBorder = true;
+
+                        // Calculate the distance to the zero contour (linear interpolation).
+                        double d = phi[p] / (phi[p] - phi[neighbour]);
+
+                        // Set dimension (neighbours 0 and 1 are x dimension, 2 and 3 are y).
+                        unsigned int dim = (j < 2) ? 0 : 1;
+
+                        // Check if distance is less than current value.
+                        if (dist[dim] == 0 || dist[dim] > d)
+                            dist[dim] = d;
+                    }
+                }
+
+                // Node and neighbour span the zero contour.
+                if (isBorder)
+                {
+                    double distSum = 0;
+
+                    // Calculate perpendicular distance to boundary (Pythag.)
+                    for (unsigned int j=0;j<2;j++)
+                    {
+                        if (dist[j] > 0)
+                            distSum += 1.0 / (dist[j] * dist[j]);
+                    }
+
+                    distance[p] = sqrt(1.0 / distSum);
+                    isFixed[p] = 1;
+                }
+                else
+                {
+                    distance[p] = maxDouble;
+                    isFixed[p] = 0;
+                }
+            }
+        }
+    }
+
+    double FastSweepingMethod::sweep(unsigned int ordering)
+    {
+        /* Tiles are visited in order of their distance from the corner at
+           which the sweep starts, i.e. along anti-diagonals of the tile grid.
+           The upwind neighbours of a tile lie on the previous anti-diagonal,
+           so the tiles on each anti-diagonal can be swept concurrently.
+         */
+
+        #pragma omp parallel
+        {
+            for (unsigned int diagonal=0;diagonal<(nTilesX + nTilesY - 1);diagonal++)
+            {
+                // The range of tile columns on the anti-diagonal.
+                unsigned int first = (diagonal < nTilesY) ? 0 : (diagonal - nTilesY + 1);
+                unsigned int last = std::min(diagonal, nTilesX - 1);
+
+                #pragma omp for schedule(dynamic, 1)
+                for (unsigned int i=first;i<=last;i++)
+                {
+                    // Tile indices relative to the starting corner.
+                    unsigned int j = diagonal - i;
+
+                    // Absolute tile indices.
+                    unsigned int tileX = (ordering & 1) ? (nTilesX - 1 - i) : i;
+                    unsigned int tileY = (ordering & 2) ? (nTilesY - 1 - j) : j;
+
+                    tileChange[tileY*nTilesX + tileX] = sweepTile(tileX, tileY, ordering);
+                }
+            }
+        }
+
+        return *std::max_element(tileChange.begin(), tileChange.end());
+    }
+
+    double FastSweepingMethod::sweepTile(unsigned int tileX, unsigned int tileY, unsigned int ordering)
+    {
+        // The node range of the tile.
+        unsigned int xMin = tileX * tileSize;
+        unsigned int yMin = tileY * tileSize;
+        unsigned int xMax = std::min(xMin + tileSize, mesh.width + 1);
+        unsigned int yMax = std::min(yMin + tileSize, mesh.height + 1);
+
+        // The maximum change in distance.
+        double maxChange = 0;
+
+        for (unsigned int k=yMin;k<yMax;k++)
+        {
+            unsigned int y = (ordering & 2) ? (yMax - 1 - (k - yMin)) : k;
+
+            for (unsigned int l=xMin;l<xMax;l++)
+            {
+                unsigned int x = (ordering & 1) ? (xMax - 1 - (l - xMin)) : l;
+                unsigned int p = (y + 1)*stride + x + 1;
+
+                if (isFixed[p]) continue;
+
+                // The minimum neighbouring distance in each direction.
+                double a = std::min(distance[p - 1], distance[p + 1]);
+                double b = std::min(distance[p - stride], distance[p + stride]);
+                if (a > b) std::swap(a, b);
+
+                // Godunov upwind solution (unit grid spacing).
+                double d;
+                if ((b - a) >= 1) d = a + 1;
+                else d = 0.5*(a + b + sqrt(2 - (b - a)*(b - a)));
+
+                if (d < distance[p])
+                {
+                    maxChange = std::max(maxChange, distance[p] - d);
+                    distance[p] = d;
+                }
+            }
+        }
+
+        return maxChange;
+    }
+}
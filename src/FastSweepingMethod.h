@@ -0,0 +1,152 @@
+/*
+  Copyright (c) 2015-2017 Lester Hedges <lester.hedges+slsm@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _FASTSWEEPINGMETHOD_H
+#define _FASTSWEEPINGMETHOD_H
+
+#include <limits>
+#include <vector>
+
+/*! \file FastSweepingMethod.h
+    \brief An implementation of the Fast Sweeping Method.
+ */
+
+namespace slsm
+{
+    // FORWARD DECLARATIONS
+
+    class Mesh;
+
+    // MAIN CLASS
+
+    /*! \brief An implementation of the Fast Sweeping Method for finding
+        approximate solutions to the Eikonal equation:
+
+            | grad T(x) | = 1
+
+        This object can be used to reinitialise the level set to a signed
+        distance function, as an alternative to the Fast Marching Method.
+        Nodes adjacent to the zero contour are fixed in the same way, then
+        the distance to the remaining nodes is found using Gauss-Seidel
+        iterations of a first order Godunov upwind scheme, sweeping the mesh
+        in each of the four diagonal orderings in turn. Cycles of sweeps are
+        repeated until the solution converges. See:
+
+            H. Zhao, "A fast sweeping method for Eikonal equations",
+            Math. Comp. 74, 603-627 (2005).
+
+        Sweeps are run in parallel by dividing the mesh into square tiles.
+        For a given ordering, a tile only depends on the upwind tiles that
+        precede it, so the tiles on each anti-diagonal of the tile grid can
+        be swept concurrently. Each tile is swept in the same order as the
+        serial algorithm, so the solution is independent of the number of
+        threads.
+
+        Unlike the Fast Marching Method, the cost doesn't depend on sorting
+        the nodes, but the number of cycles grows with the complexity of the
+        zero contour, i.e. the number of times that characteristics change
+        direction.
+     */
+    class FastSweepingMethod
+    {
+    public:
+        //! Constructor.
+        /*! \param mesh_
+                A reference to the level set mesh.
+
+            \param tolerance_
+                The convergence tolerance: sweeping stops when no node changes
+                by more than this amount over a cycle of four sweeps.
+         */
+        FastSweepingMethod(const Mesh&, double tolerance_ = 1e-10);
+
+        //! Excecute Fast Sweeping for reinitialisation of the signed distance function.
+        /*! \param signedDistance
+                The nodal signed distance function (level set).
+
+            \return
+                The number of cycles of four sweeps.
+         */
+        unsigned int march(std::vector<double>&);
+
+    private:
+        /// A const reference to the level set mesh.
+        const Mesh& mesh;
+
+        /// The convergence tolerance.
+        double tolerance;
+
+        /// The width of a row of the padded arrays.
+        unsigned int stride;
+
+        /// The number of tiles in the x direction.
+        unsigned int nTilesX;
+
+        /// The number of tiles in the y direction.
+        unsigned int nTilesY;
+
+        /// The initial level set, in row-major order, with a layer of ghost nodes.
+        std::vector<double> phi;
+
+        /// The unsigned distance, in row-major order, with a layer of ghost nodes.
+        std::vector<double> distance;
+
+        /// Whether the distance at each node is fixed (char, so tiles can be read concurrently).
+        std::vector<char> isFixed;
+
+        /// The maximum change in distance within each tile during a sweep.
+        std::vector<double> tileChange;
+
+        /// The width (and height) of a tile.
+        static const unsigned int tileSize = 64;
+
+        //! Copy the level set into the padded arrays and fix the distance
+        //! of nodes adjacent to the zero contour.
+        /*! \param signedDistance
+                The nodal signed distance function (level set).
+         */
+        void initialise(const std::vector<double>&);
+
+        //! Sweep the mesh in one of the four diagonal orderings.
+        /*! \param ordering
+                The ordering: bit 0 reverses the x direction, bit 1 reverses the y direction.
+
+            \return
+                The maximum change in distance during the sweep.
+         */
+        double sweep(unsigned int);
+
+        //! Sweep a single tile.
+        /*! \param tileX
+                The x index of the tile.
+
+            \param tileY
+                The y index of the tile.
+
+            \param ordering
+                The ordering: bit 0 reverses the x direction, bit 1 reverses the y direction.
+
+            \return
+                The maximum change in distance within the tile.
+         */
+        double sweepTile(unsigned int, unsigned int, unsigned int);
+
+        const double maxDouble = std::numeric_limits<double>::max();
+    };
+}
+
+#endif  /* _FASTSWEEPINGMETHOD_H */
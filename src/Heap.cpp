@@ -218,6 +218,12 @@ namespace slsm
         exit(EXIT_FAILURE);
     }
 
+    void Heap::clear()
+    {
+        heapLength = 0;
+        listLength = 0;
+    }
+
     const unsigned int& Heap::size() const
     {
         return heapLength;
@@ -42,9 +42,9 @@ namespace slsm
 
         For efficiency, the heap is stored as a contiguous std::vector array,
         rather than a linked list. The constructor needs to know the maximum number
-        of entries that will be added to the heap. This will number be computed in
-        the FastMarchingMethod::initialiseHeap method (which calculates the number
-        of far field nodes).
+        of entries that will be added to the heap. The FastMarchingMethod object
+        sizes its heap for every node of the mesh, then empties it using clear
+        before each march, so that the storage is reused.
      */
     class Heap
     {
@@ -88,6 +88,9 @@ namespace slsm
          */
         void set(unsigned int, double);
 
+        //! Remove all entries from the heap, keeping its storage for reuse.
+        void clear();
+
         //! Test whether the heap is empty.
         /*! \return
                 Whether the heap is empty (true) or contains entries (false).
@@ -15,6 +15,7 @@
   along with this program. If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <cmath>
 #include <fstream>
 
 #include "Boundary.h"
@@ -74,16 +75,18 @@ namespace slsm
         // Write the nodal signed distance to file.
         fprintf(pFile, "SCALARS distance float 1\n");
         fprintf(pFile, "LOOKUP_TABLE default\n");
-        for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
-            fprintf(pFile, "%lf\n", levelSet.signedDistance[i]);
+        for (unsigned int y=0;y<=levelSet.mesh.height;y++)
+            for (unsigned int x=0;x<=levelSet.mesh.width;x++)
+                fprintf(pFile, "%lf\n", levelSet.signedDistance[levelSet.mesh.xyToIndex(x, y)]);
 
         // Write the nodal velocity to file.
         if (isVelocity)
         {
             fprintf(pFile, "SCALARS velocity float 1\n");
             fprintf(pFile, "LOOKUP_TABLE default\n");
-            for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
-                fprintf(pFile, "%lf\n", levelSet.velocity[i]);
+            for (unsigned int y=0;y<=levelSet.mesh.height;y++)
+                for (unsigned int x=0;x<=levelSet.mesh.width;x++)
+                    fprintf(pFile, "%lf\n", levelSet.velocity[levelSet.mesh.xyToIndex(x, y)]);
         }
 
         // Write the nodal gradient to file.
@@ -91,8 +94,9 @@ namespace slsm
         {
             fprintf(pFile, "SCALARS gradient float 1\n");
             fprintf(pFile, "LOOKUP_TABLE default\n");
-            for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
-                fprintf(pFile, "%lf\n", levelSet.gradient[i]);
+            for (unsigned int y=0;y<=levelSet.mesh.height;y++)
+                for (unsigned int x=0;x<=levelSet.mesh.width;x++)
+                    fprintf(pFile, "%lf\n", levelSet.gradient[levelSet.mesh.xyToIndex(x, y)]);
         }
 
         fclose(pFile);
@@ -130,11 +134,16 @@ namespace slsm
         errno = ENOENT;
         slsm_check(pFile != NULL, "Cannot open file %s", fileName.c_str());
 
-        // Write the nodal signed distance to file.
-        for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
+        // Write the nodal signed distance to file (in row-major order).
+        for (unsigned int y=0;y<=levelSet.mesh.height;y++)
         {
-            if (isXY) fprintf(pFile, "%lf %lf ", levelSet.mesh.nodes[i].coord.x, levelSet.mesh.nodes[i].coord.y);
-            fprintf(pFile, "%lf %lf %lf\n", levelSet.signedDistance[i], levelSet.velocity[i], levelSet.gradient[i]);
+            for (unsigned int x=0;x<=levelSet.mesh.width;x++)
+            {
+                unsigned int i = levelSet.mesh.xyToIndex(x, y);
+
+                if (isXY) fprintf(pFile, "%lf %lf ", levelSet.mesh.nodeCoord(i).x, levelSet.mesh.nodeCoord(i).y);
+                fprintf(pFile, "%lf %lf %lf\n", levelSet.signedDistance[i], levelSet.velocity[i], levelSet.gradient[i]);
+            }
         }
 
         fclose(pFile);
@@ -171,7 +180,17 @@ namespace slsm
         errno = ENOENT;
         slsm_check(outputFile.good(), "Cannot open file %s", fileName.c_str());
 
-        outputFile.write((char*)&levelSet.signedDistance[0], levelSet.mesh.nNodes*sizeof(double));
+        // Nodes are stored contiguously in row-major order.
+        if (levelSet.mesh.nodeOrdering == NodeOrdering::ROW_MAJOR)
+            outputFile.write((char*)&levelSet.signedDistance[0], levelSet.mesh.nNodes*sizeof(double));
+
+        // Write in row-major order.
+        else
+        {
+            for (unsigned int y=0;y<=levelSet.mesh.height;y++)
+                for (unsigned int x=0;x<=levelSet.mesh.width;x++)
+                    outputFile.write((char*)&levelSet.signedDistance[levelSet.mesh.xyToIndex(x, y)], sizeof(double));
+        }
 
         return;
 
@@ -222,11 +241,13 @@ namespace slsm
         // File contains additional nodal coordinate information.
         if (isXY)
         {
-            double tmp;
-            unsigned int node = 0;
+            double x, y, tmp;
 
-            while (inputFile >> tmp >> tmp >> levelSet.signedDistance[node] >> tmp >> tmp)
-                node++;
+            while (inputFile >> x >> y >> tmp)
+            {
+                levelSet.signedDistance[levelSet.mesh.xyToIndex(std::round(x), std::round(y))] = tmp;
+                inputFile >> tmp >> tmp;
+            }
         }
 
         // File only contains signed distance data.
@@ -235,8 +256,14 @@ namespace slsm
             double tmp;
             unsigned int node = 0;
 
-            while (inputFile >> levelSet.signedDistance[node] >> tmp >> tmp)
+            // Nodes are listed in row-major order.
+            while (inputFile >> tmp)
+            {
+                levelSet.signedDistance[levelSet.mesh.xyToIndex(node % (levelSet.mesh.width + 1),
+                    node / (levelSet.mesh.width + 1))] = tmp;
+                inputFile >> tmp >> tmp;
                 node++;
+            }
         }
 
         return;
@@ -272,7 +299,17 @@ namespace slsm
         slsm_check(inputFile.good(), "Cannot open file %s", fileName.c_str());
 
         // Read the nodal signed distance fom file.
-        inputFile.read((char*)&levelSet.signedDistance[0], levelSet.mesh.nNodes*sizeof(double));
+        // Nodes are stored contiguously in row-major order.
+        if (levelSet.mesh.nodeOrdering == NodeOrdering::ROW_MAJOR)
+            inputFile.read((char*)&levelSet.signedDistance[0], levelSet.mesh.nNodes*sizeof(double));
+
+        // Read in row-major order.
+        else
+        {
+            for (unsigned int y=0;y<=levelSet.mesh.height;y++)
+                for (unsigned int x=0;x<=levelSet.mesh.width;x++)
+                    inputFile.read((char*)&levelSet.signedDistance[levelSet.mesh.xyToIndex(x, y)], sizeof(double));
+        }
 
         return;
 
@@ -422,7 +459,7 @@ namespace slsm
         fprintf(pFile, "SCALARS area float 1\n");
         fprintf(pFile, "LOOKUP_TABLE default\n");
         for (unsigned int i=0;i<mesh.nElements;i++)
-            fprintf(pFile, "%lf\n", mesh.elements[i].area);
+            fprintf(pFile, "%lf\n", mesh.area[i]);
 
         fclose(pFile);
 
@@ -461,8 +498,8 @@ namespace slsm
         // Write the element area fractions to file.
         for (unsigned int i=0;i<mesh.nElements;i++)
         {
-            if (isXY) fprintf(pFile, "%lf %lf ", mesh.elements[i].coord.x, mesh.elements[i].coord.y);
-            fprintf(pFile, "%lf\n", mesh.elements[i].area);
+            if (isXY) fprintf(pFile, "%lf %lf ", mesh.elementCoord(i).x, mesh.elementCoord(i).y);
+            fprintf(pFile, "%lf\n", mesh.area[i]);
         }
 
         fclose(pFile);
@@ -18,6 +18,7 @@
 #include <algorithm>
 #include <cmath>
 #include <functional>
+#include <limits>
 
 #include "Boundary.h"
 #include "Debug.h"
@@ -32,10 +33,141 @@
 
 namespace slsm
 {
+    const unsigned int LevelSet::gradientBatch;
+
+    // Store the WENO stencil values for one direction, with a given stride
+    // between consecutive values.
+    static inline void storeStencil(double* v, unsigned int stride,
+        double v1, double v2, double v3, double v4, double v5)
+    {
+        v[0]        = v1;
+        v[stride]   = v2;
+        v[2*stride] = v3;
+        v[3*stride] = v4;
+        v[4*stride] = v5;
+    }
+
+    // The fifth order Hamilton-Jacobi WENO approximation. This is shared by the
+    // scalar and vectorised kernels so that they give identical results.
+    static inline double hjweno(double v1, double v2, double v3, double v4, double v5)
+    {
+        // Calculate the gradient using the 5th order Hamilton-Jacobi WENO approximation.
+        // Taken from pages 34-35 of "Level Set Methods and Dynamic Implicit Surfaces".
+        // See: http://web.stanford.edu/class/cs237c/Lecture16.pdf
+
+        double oneQuarter        = 1.0  / 4.0;
+        double thirteenTwelths   = 13.0 / 12.0;
+        double eps               = 1e-6;
+
+        // Estimate the smoothness of each stencil.
+
+        double s1 = thirteenTwelths * (v1 - 2*v2 + v3)*(v1 - 2*v2 + v3)
+                  + oneQuarter * (v1 - 4*v2 + 3*v3)*(v1 - 4*v2 + 3*v3);
+
+        double s2 = thirteenTwelths * (v2 - 2*v3 + v4)*(v2 - 2*v3 + v4)
+                  + oneQuarter * (v2 - v4)*(v2 - v4);
+
+        double s3 = thirteenTwelths * (v3 - 2*v4 + v5)*(v3 - 2*v4 + v5)
+                  + oneQuarter * (3*v3 - 4*v4 + v5)*(3*v3 - 4*v4 + v5);
+
+        // Compute the alpha values for each stencil.
+
+        double alpha1 = 0.1 / ((s1 + eps)*(s1 + eps));
+        double alpha2 = 0.6 / ((s2 + eps)*(s2 + eps));
+        double alpha3 = 0.3 / ((s3 + eps)*(s3 + eps));
+
+        // Calculate the normalised weights.
+
+        double totalWeight = alpha1 + alpha2 + alpha3;
+
+        double w1 = alpha1 / totalWeight;
+        double w2 = alpha2 / totalWeight;
+        double w3 = alpha3 / totalWeight;
+
+        // Sum the three stencil components.
+        double grad = w1 * (2*v1 - 7*v2 + 11*v3)
+                    + w2 * (5*v3 - v2 + 2*v4)
+                    + w3 * (2*v3 + 5*v4 - v5);
+
+        grad *= (1.0 / 6.0);
+
+        return grad;
+    }
+
+    // A node in a bounding volume hierarchy over the segments of a
+    // piece-wise linear interface.
+    struct SegmentTreeNode
+    {
+        double xMin, yMin, xMax, yMax;          // The bounding box of the segments.
+        unsigned int first;                     // The first child, or the first segment for a leaf.
+        unsigned int count;                     // The number of segments (zero for an internal node).
+    };
+
+    // Recursively build the hierarchy over the range [begin, end) of the
+    // segment list, where segment j joins vertices j and j+1. Each node is
+    // split at the median segment centre along the longest axis of its
+    // bounding box. Children are stored contiguously.
+    static void buildSegmentTree(const std::vector<Coord>& vertices, std::vector<unsigned int>& segments,
+        unsigned int begin, unsigned int end, unsigned int index, std::vector<SegmentTreeNode>& tree)
+    {
+        SegmentTreeNode node;
+        node.xMin = node.yMin = std::numeric_limits<double>::max();
+        node.xMax = node.yMax = -std::numeric_limits<double>::max();
+
+        for (unsigned int i=begin;i<end;i++)
+        {
+            const Coord& v1 = vertices[segments[i]];
+            const Coord& v2 = vertices[segments[i] + 1];
+
+            node.xMin = std::min(node.xMin, std::min(v1.x, v2.x));
+            node.yMin = std::min(node.yMin, std::min(v1.y, v2.y));
+            node.xMax = std::max(node.xMax, std::max(v1.x, v2.x));
+            node.yMax = std::max(node.yMax, std::max(v1.y, v2.y));
+        }
+
+        // Leaf node.
+        if (end - begin <= 4)
+        {
+            node.first = begin;
+            node.count = end - begin;
+            tree[index] = node;
+            return;
+        }
+
+        // Split at the median along the longest axis.
+        bool isX = ((node.xMax - node.xMin) > (node.yMax - node.yMin));
+        unsigned int mid = (begin + end) / 2;
+
+        std::nth_element(segments.begin() + begin, segments.begin() + mid, segments.begin() + end,
+            [&](unsigned int a, unsigned int b)
+            {
+                if (isX) return (vertices[a].x + vertices[a + 1].x) < (vertices[b].x + vertices[b + 1].x);
+                else     return (vertices[a].y + vertices[a + 1].y) < (vertices[b].y + vertices[b + 1].y);
+            });
+
+        node.first = tree.size();
+        node.count = 0;
+        tree[index] = node;
+        tree.resize(tree.size() + 2);
+
+        buildSegmentTree(vertices, segments, begin, mid, node.first, tree);
+        buildSegmentTree(vertices, segments, mid, end, node.first + 1, tree);
+    }
+
+    // The squared distance from a point to a bounding box.
+    static inline double boxDistanceSqd(const SegmentTreeNode& node, const Coord& point)
+    {
+        double dx = std::max(0.0, std::max(node.xMin - point.x, point.x - node.xMax));
+        double dy = std::max(0.0, std::max(node.yMin - point.y, point.y - node.yMax));
+
+        return dx*dx + dy*dy;
+    }
+
     LevelSet::LevelSet(unsigned int width, unsigned int height,
-        double moveLimit_, unsigned int bandWidth_, bool isFixedDomain_) :
+        double moveLimit_, unsigned int bandWidth_, bool isFixedDomain_,
+        bool isImplicitMesh_, NodeOrdering::NodeOrdering nodeOrdering_) :
         moveLimit(moveLimit_),
-        mesh(Mesh(width, height)),
+        mesh(width, height, isImplicitMesh_, nodeOrdering_),
         bandWidth(bandWidth_),
         isFixedDomain(isFixedDomain_)
     {
@@ -50,6 +182,8 @@ namespace slsm
         velocity.resize(mesh.nNodes);
         gradient.resize(mesh.nNodes);
         narrowBand.resize(mesh.nNodes);
+        activeBlocks.resize(mesh.nBlocks);
+        isActiveBlock.resize(mesh.nBlocks);
 
         // Make sure that memory is sufficient (for small test systems).
         size = std::max(25, size);
@@ -68,9 +202,10 @@ namespace slsm
     }
 
     LevelSet::LevelSet(unsigned int width, unsigned int height, const std::vector<Hole>& holes,
-        double moveLimit_, unsigned int bandWidth_, bool isFixedDomain_) :
+        double moveLimit_, unsigned int bandWidth_, bool isFixedDomain_,
+        bool isImplicitMesh_, NodeOrdering::NodeOrdering nodeOrdering_) :
         moveLimit(moveLimit_),
-        mesh(Mesh(width, height)),
+        mesh(width, height, isImplicitMesh_, nodeOrdering_),
         bandWidth(bandWidth_),
         isFixedDomain(isFixedDomain_)
     {
@@ -85,6 +220,8 @@ namespace slsm
         velocity.resize(mesh.nNodes);
         gradient.resize(mesh.nNodes);
         narrowBand.resize(mesh.nNodes);
+        activeBlocks.resize(mesh.nBlocks);
+        isActiveBlock.resize(mesh.nBlocks);
 
         // Make sure that memory is sufficient (for small test systems).
         size = std::max(25, size);
@@ -103,9 +240,10 @@ namespace slsm
     }
 
     LevelSet::LevelSet(unsigned int width, unsigned int height, const std::vector<Coord>& points,
-        double moveLimit_, unsigned int bandWidth_, bool isFixedDomain_) :
+        double moveLimit_, unsigned int bandWidth_, bool isFixedDomain_,
+        bool isImplicitMesh_, NodeOrdering::NodeOrdering nodeOrdering_) :
         moveLimit(moveLimit_),
-        mesh(Mesh(width, height)),
+        mesh(width, height, isImplicitMesh_, nodeOrdering_),
         bandWidth(bandWidth_),
         isFixedDomain(isFixedDomain_)
     {
@@ -120,6 +258,8 @@ namespace slsm
         velocity.resize(mesh.nNodes);
         gradient.resize(mesh.nNodes);
         narrowBand.resize(mesh.nNodes);
+        activeBlocks.resize(mesh.nBlocks);
+        isActiveBlock.resize(mesh.nBlocks);
 
         // Make sure that memory is sufficient (for small test systems).
         size = std::max(25, size);
@@ -138,9 +278,10 @@ namespace slsm
     }
 
     LevelSet::LevelSet(unsigned int width, unsigned int height, const std::vector<Hole>& initialHoles,
-        const std::vector<Hole>& targetHoles, double moveLimit_, unsigned int bandWidth_, bool isFixedDomain_) :
+        const std::vector<Hole>& targetHoles, double moveLimit_, unsigned int bandWidth_, bool isFixedDomain_,
+        bool isImplicitMesh_, NodeOrdering::NodeOrdering nodeOrdering_) :
         moveLimit(moveLimit_),
-        mesh(Mesh(width, height)),
+        mesh(width, height, isImplicitMesh_, nodeOrdering_),
         bandWidth(bandWidth_),
         isFixedDomain(isFixedDomain_)
     {
@@ -156,6 +297,8 @@ namespace slsm
         gradient.resize(mesh.nNodes);
         target.resize(mesh.nNodes);
         narrowBand.resize(mesh.nNodes);
+        activeBlocks.resize(mesh.nBlocks);
+        isActiveBlock.resize(mesh.nBlocks);
 
         // Make sure that memory is sufficient (for small test systems).
         size = std::max(25, size);
@@ -181,9 +324,10 @@ namespace slsm
     }
 
     LevelSet::LevelSet(unsigned int width, unsigned int height, const std::vector<Hole>& holes,
-        const std::vector<Coord>& points, double moveLimit_, unsigned int bandWidth_, bool isFixedDomain_) :
+        const std::vector<Coord>& points, double moveLimit_, unsigned int bandWidth_, bool isFixedDomain_,
+        bool isImplicitMesh_, NodeOrdering::NodeOrdering nodeOrdering_) :
         moveLimit(moveLimit_),
-        mesh(Mesh(width, height)),
+        mesh(width, height, isImplicitMesh_, nodeOrdering_),
         bandWidth(bandWidth_),
         isFixedDomain(isFixedDomain_)
     {
@@ -199,6 +343,8 @@ namespace slsm
         gradient.resize(mesh.nNodes);
         target.resize(mesh.nNodes);
         narrowBand.resize(mesh.nNodes);
+        activeBlocks.resize(mesh.nBlocks);
+        isActiveBlock.resize(mesh.nBlocks);
 
         // Make sure that memory is sufficient (for small test systems).
         size = std::max(25, size);
@@ -224,9 +370,10 @@ namespace slsm
     }
 
     LevelSet::LevelSet(unsigned int width, unsigned int height, const std::vector<Coord>& initialPoints,
-        const std::vector<Coord>& targetPoints, double moveLimit_, unsigned int bandWidth_, bool isFixedDomain_) :
+        const std::vector<Coord>& targetPoints, double moveLimit_, unsigned int bandWidth_, bool isFixedDomain_,
+        bool isImplicitMesh_, NodeOrdering::NodeOrdering nodeOrdering_) :
         moveLimit(moveLimit_),
-        mesh(Mesh(width, height)),
+        mesh(width, height, isImplicitMesh_, nodeOrdering_),
         bandWidth(bandWidth_),
         isFixedDomain(isFixedDomain_)
     {
@@ -242,6 +389,8 @@ namespace slsm
         gradient.resize(mesh.nNodes);
         target.resize(mesh.nNodes);
         narrowBand.resize(mesh.nNodes);
+        activeBlocks.resize(mesh.nBlocks);
+        isActiveBlock.resize(mesh.nBlocks);
 
         // Make sure that memory is sufficient (for small test systems).
         size = std::max(25, size);
@@ -268,22 +417,33 @@ namespace slsm
 
     bool LevelSet::update(double timeStep)
     {
-        // Loop over all nodes in the narrow band.
-        for (unsigned int i=0;i<nNarrowBand;i++)
-        {
-            unsigned int node = narrowBand[i];
-            signedDistance[node] -= timeStep * gradient[node] * velocity[node];
+        // The signed distance function is about to change.
+        workspace.isReplayCurrent = false;
 
-            // If node is on domain boundary.
-            if (mesh.nodes[node].isDomain)
+        // Make sure that the narrow band is grouped by the current tiles.
+        if ((tileBandWidth != mesh.tileWidth) || (tileBandHeight != mesh.tileHeight))
+            initialiseTileBand();
+
+        // Loop over all nodes in the narrow band, tile by tile.
+        #pragma omp parallel for schedule(dynamic)
+        for (unsigned int i=0;i<mesh.nTiles;i++)
+        {
+            for (unsigned int j=tileBandOffset[i];j<tileBandOffset[i+1];j++)
             {
-                // Enforce boundary condition.
-                if (signedDistance[node] > 0)
-                    signedDistance[node] = 0;
-            }
+                unsigned int node = tileBand[j];
+                signedDistance[node] -= timeStep * gradient[node] * velocity[node];
+
+                // If node is on domain boundary.
+                if (mesh.isDomain(node))
+                {
+                    // Enforce boundary condition.
+                    if (signedDistance[node] > 0)
+                        signedDistance[node] = 0;
+                }
 
-            // Reset the number of boundary points.
-            mesh.nodes[node].nBoundaryPoints = 0;
+                // Reset the number of boundary points.
+                mesh.nBoundaryPoints[node] = 0;
+            }
         }
 
         // Check mine nodes.
@@ -304,28 +464,41 @@ namespace slsm
 
     void LevelSet::mask(const std::vector<Hole>& holes)
     {
-        // Loop over all nodes.
-        for (unsigned int i=0;i<mesh.nNodes;i++)
+        // Loop over all holes.
+        for (unsigned int j=0;j<holes.size();j++)
         {
-            // Loop over all holes.
-            for (unsigned int j=0;j<holes.size();j++)
+            // Only nodes within the bounding box of the hole can be masked.
+            int xMin = std::max(0, int(std::ceil(holes[j].coord.x - holes[j].r)));
+            int xMax = std::min(int(mesh.width), int(std::floor(holes[j].coord.x + holes[j].r)));
+            int yMin = std::max(0, int(std::ceil(holes[j].coord.y - holes[j].r)));
+            int yMax = std::min(int(mesh.height), int(std::floor(holes[j].coord.y + holes[j].r)));
+
+            for (int y=yMin;y<=yMax;y++)
             {
-                // Work out x and y distance of the node from the hole centre.
-                double dx = holes[j].coord.x - mesh.nodes[i].coord.x;
-                double dy = holes[j].coord.y - mesh.nodes[i].coord.y;
+                for (int x=xMin;x<=xMax;x++)
+                {
+                    unsigned int node = mesh.xyToIndex(x, y);
 
-                // Work out distance (Pythag).
-                double dist = sqrt(dx*dx + dy*dy);
+                    // Work out x and y distance of the node from the hole centre.
+                    double dx = holes[j].coord.x - mesh.nodeCoord(node).x;
+                    double dy = holes[j].coord.y - mesh.nodeCoord(node).y;
 
-                // Point is inside the hole.
-                if (dist < holes[j].r)
-                {
-                    signedDistance[i] = -1e-6;
-                    mesh.nodes[i].isMasked = true;
+                    // Work out distance (Pythag).
+                    double dist = sqrt(dx*dx + dy*dy);
+
+                    // Point is inside the hole.
+                    if (dist < holes[j].r)
+                    {
+                        signedDistance[node] = -1e-6;
+                        mesh.isMasked[node] = true;
+                    }
                 }
             }
         }
 
+        // Update the blocks containing masked nodes.
+        initialiseMaskedBlocks();
+
         // Reinitialise to a signed distance function.
         reinitialise();
     }
@@ -339,13 +512,13 @@ namespace slsm
             for (unsigned int i=0;i<mesh.nNodes;i++)
             {
                 // Point is inside the rectangle.
-                if (mesh.nodes[i].coord.x > points[0].x &&
-                    mesh.nodes[i].coord.y > points[0].y &&
-                    mesh.nodes[i].coord.x < points[1].x &&
-                    mesh.nodes[i].coord.y < points[1].y)
+                if (mesh.nodeCoord(i).x > points[0].x &&
+                    mesh.nodeCoord(i).y > points[0].y &&
+                    mesh.nodeCoord(i).x < points[1].x &&
+                    mesh.nodeCoord(i).y < points[1].y)
                 {
                     signedDistance[i] = -1e-6;
-                    mesh.nodes[i].isMasked = true;
+                    mesh.isMasked[i] = true;
                 }
             }
         }
@@ -353,48 +526,118 @@ namespace slsm
         // Mask off a piece-wise linear shape.
         else
         {
+            // Find the nodes that lie inside the polygon.
+            std::vector<char> isInside;
+            insidePolygon(points, isInside);
+
             // Loop over all nodes.
             for (unsigned int i=0;i<mesh.nNodes;i++)
             {
                 // Point is inside the polygon.
-                if (isInsidePolygon(mesh.nodes[i].coord, points))
+                if (isInside[i])
                 {
                     signedDistance[i] = -1e-6;
-                    mesh.nodes[i].isMasked = true;
+                    mesh.isMasked[i] = true;
                 }
             }
         }
 
+        // Update the blocks containing masked nodes.
+        initialiseMaskedBlocks();
+
         // Reinitialise to a signed distance function.
         reinitialise();
     }
 
     void LevelSet::reinitialise()
     {
-        // Initialise fast marching method object.
-        FastMarchingMethod fmm(mesh, false);
+        workspace.isReplayCurrent = false;
+
+        if (eikonalSolver == EikonalSolver::FAST_SWEEPING)
+        {
+            // Reinitialise the signed distance function in parallel.
+            fastSweepingMethod().march(signedDistance);
+
+            // The sweeps cover the whole mesh, so search it for the narrow band.
+            initialiseNarrowBand();
+
+            return;
+        }
+
+        if (eikonalSolver == EikonalSolver::FAST_ITERATIVE)
+        {
+            // Reinitialise the signed distance function in parallel.
+            fastIterativeMethod().march(signedDistance);
+
+            // The solution covers the whole mesh, so search it for the narrow band.
+            initialiseNarrowBand();
+
+            return;
+        }
+
+        if (eikonalSolver == EikonalSolver::CLOSEST_POINT)
+        {
+            // Discretise the zero contour and find the distance from it.
+            workspace.boundary.discretise(*this);
+            reinitialise(workspace.boundary);
+
+            return;
+        }
+
+        // Reinitialise the signed distance function, recording the nodes
+        // that lie within the new narrow band as they are frozen, along
+        // with their upwind dependencies if velocity extension is replayed.
+        fastMarchingMethod().march(signedDistance, bandWidth, workspace.band, reinitialiseCutOff(), isReplay);
+        workspace.isReplayCurrent = isReplay;
+
+        // Update the narrow band.
+        updateNarrowBand(workspace.band);
+    }
+
+    void LevelSet::reinitialise(const Boundary& boundary)
+    {
+        workspace.isReplayCurrent = false;
 
-        // Reinitialise the signed distance function.
-        fmm.march(signedDistance);
+        // Compute the distance from the boundary segments in parallel, up to
+        // three nodes beyond the narrow band (the reach of the gradient stencil).
+        closestPointTransform().transform(boundary, signedDistance, bandWidth + 3);
 
-        // Reinitialise the narrow band.
+        // The transform covers the whole mesh, so search it for the narrow band.
         initialiseNarrowBand();
     }
 
-    void LevelSet::computeVelocities(const std::vector<BoundaryPoint>& boundaryPoints)
+    void LevelSet::computeVelocities(const std::vector<BoundaryPoint>& boundaryPoints, bool isReinitialise)
     {
         // Initialise velocity (map boundary points to boundary nodes).
         initialiseVelocities(boundaryPoints);
 
-        // Initialise fast marching method object.
-        FastMarchingMethod fmm(mesh, false);
+        if (isReinitialise && (eikonalSolver == EikonalSolver::FAST_MARCHING))
+        {
+            // Reinitialise the signed distance function and extend velocities
+            // in the same pass, recording the nodes in the new narrow band.
+            fastMarchingMethod().march(signedDistance, velocity, bandWidth, workspace.band, reinitialiseCutOff());
+            workspace.isReplayCurrent = false;
+
+            // Update the narrow band.
+            updateNarrowBand(workspace.band);
+
+            return;
+        }
+
+        // Reinitialise first, then extend velocities over the new narrow band.
+        if (isReinitialise) reinitialise();
 
-        // Reinitialise the signed distance function.
-        fmm.march(signedDistance, velocity);
+        // Extend velocities (the signed distance function is unchanged).
+        if (eikonalSolver == EikonalSolver::FAST_ITERATIVE)
+            fastIterativeMethod().march(signedDistance, velocity);
+        else if (isReplay && workspace.isReplayCurrent)
+            fastMarchingMethod().replay(velocity);
+        else
+            fastMarchingMethod().march(signedDistance, velocity);
     }
 
     double LevelSet::computeVelocities(std::vector<BoundaryPoint>& boundaryPoints,
-        double& timeStep, const double temperature, MersenneTwister& rng)
+        double& timeStep, const double temperature, MersenneTwister& rng, bool isReinitialise)
     {
         // Square root of two times temperature, sqrt(2T).
         double sqrt2T = sqrt(2.0 * temperature);
@@ -427,16 +670,16 @@ namespace slsm
             boundaryPoints[i].velocity += (noise / sqrt(boundaryPoints[i].length)) * rng.normal(0, 1);
 
         // Perform velocity extension.
-        computeVelocities(boundaryPoints);
+        computeVelocities(boundaryPoints, isReinitialise);
 
         return scale;
     }
 
 #ifdef PYBIND
     double LevelSet::computeVelocities(std::vector<BoundaryPoint>& boundaryPoints,
-        MutableFloat& timeStep, const double temperature, MersenneTwister& rng)
+        MutableFloat& timeStep, const double temperature, MersenneTwister& rng, bool isReinitialise)
     {
-        return computeVelocities(boundaryPoints, timeStep.value, temperature, rng);
+        return computeVelocities(boundaryPoints, timeStep.value, temperature, rng, isReinitialise);
     }
 #endif
 
@@ -448,35 +691,130 @@ namespace slsm
         // Reset gradients.
         std::fill(gradient.begin(), gradient.end(), 0.0);
 
-        // Loop over all nodes in the narrow band region.
-        for (unsigned int i=0;i<nNarrowBand;i++)
+        // Make sure that the narrow band is grouped by the current tiles.
+        if ((tileBandWidth != mesh.tileWidth) || (tileBandHeight != mesh.tileHeight))
+            initialiseTileBand();
+
+        // Loop over all nodes in the narrow band region, tile by tile. The
+        // stencil only reads the signed distance, so tiles are independent.
+        #pragma omp parallel for schedule(dynamic)
+        for (unsigned int i=0;i<mesh.nTiles;i++)
+        {
+            // Stencil values for a batch of nodes, stored by direction and
+            // stencil point, so that the WENO kernel can be vectorised.
+            double v[20][gradientBatch];
+
+            // Nodes in the batch.
+            unsigned int nodes[gradientBatch];
+
+            // Interior nodes, for which the stencil lies inside the domain.
+            for (unsigned int j=tileBandOffset[i];j<tileBandEdge[i];j+=gradientBatch)
+            {
+                // Number of nodes in the batch.
+                unsigned int n = std::min(gradientBatch, tileBandEdge[i] - j);
+
+                // Gather the stencils.
+                for (unsigned int k=0;k<n;k++)
+                {
+                    nodes[k] = tileBand[j + k];
+                    Coord coord = mesh.nodeCoord(nodes[k]);
+                    interiorStencils(coord.x, coord.y, &v[0][k], gradientBatch);
+                }
+
+                batchGradients(nodes, n, v);
+            }
+
+            // Edge nodes, which use precomputed one-sided stencils.
+            for (unsigned int j=tileBandEdge[i];j<tileBandOffset[i+1];j+=gradientBatch)
+            {
+                unsigned int end = std::min(j + gradientBatch, tileBandOffset[i+1]);
+
+                // Number of nodes in the batch.
+                unsigned int n = 0;
+
+                // Gather the stencils.
+                for (unsigned int k=j;k<end;k++)
+                {
+                    unsigned int node = tileBand[k];
+                    Coord coord = mesh.nodeCoord(node);
+
+                    // Gradient at a corner node, computed using the diagonal neighbour.
+                    double grad;
+                    if (cornerGradient(coord.x, coord.y, grad)) gradient[node] = grad;
+                    else
+                    {
+                        edgeStencils(coord.x, coord.y, &v[0][n], gradientBatch);
+                        nodes[n] = node;
+                        n++;
+                    }
+                }
+
+                batchGradients(nodes, n, v);
+            }
+        }
+    }
+
+    void LevelSet::batchGradients(const unsigned int* nodes, const unsigned int n, double (*v)[gradientBatch])
+    {
+        // WENO approximations for each direction.
+        double weno[4][gradientBatch];
+
+        // Compute the WENO approximations.
+        for (unsigned int i=0;i<4;i++)
+            gradHJWENO(v[5*i], v[5*i + 1], v[5*i + 2], v[5*i + 3], v[5*i + 4], weno[i], n);
+
+        // Compute the nodal gradients.
+        for (unsigned int i=0;i<n;i++)
         {
-            // Compute the nodal gradient.
-            unsigned int node = narrowBand[i];
-            gradient[node] = computeGradient(node);
+            double w[4] = {weno[0][i], weno[1][i], weno[2][i], weno[3][i]};
+            gradient[nodes[i]] = upwindGradient(nodes[i], w);
         }
     }
 
     double LevelSet::computeAreaFractions(const Boundary& boundary)
     {
+        // In sparse mode, once the area of the far field is known, only the
+        // elements in the active blocks need to be updated.
+        bool isBlockPass = (isSparse && isFarFieldAreaCurrent);
+
+        // Number of elements to update.
+        unsigned int nUpdate = isBlockPass ? activeElements.size() : mesh.nElements;
+
         // Zero the total area fraction.
-        area = 0;
+        area = isBlockPass ? farFieldArea : 0;
 
-        for (unsigned int i=0;i<mesh.nElements;i++)
+        for (unsigned int k=0;k<nUpdate;k++)
         {
+            // Element index.
+            unsigned int i = isBlockPass ? activeElements[k] : k;
+
             // Element is inside structure.
-            if (mesh.elements[i].status & ElementStatus::INSIDE)
-                mesh.elements[i].area = 1.0;
+            if (mesh.elementStatus[i] & ElementStatus::INSIDE)
+                mesh.area[i] = 1.0;
 
             // Element is outside structure.
-            else if (mesh.elements[i].status & ElementStatus::OUTSIDE)
-                mesh.elements[i].area = 0.0;
+            else if (mesh.elementStatus[i] & ElementStatus::OUTSIDE)
+                mesh.area[i] = 0.0;
 
             // Element is cut by the boundary.
-            else mesh.elements[i].area = cutArea(mesh.elements[i], boundary);
+            else mesh.area[i] = cutArea(i, boundary);
 
             // Add the area to the running total.
-            area += mesh.elements[i].area;
+            area += mesh.area[i];
+        }
+
+        // Store the area of the elements outside of the active blocks.
+        if (isSparse && !isBlockPass)
+        {
+            farFieldArea = 0;
+
+            for (unsigned int i=0;i<mesh.nElements;i++)
+            {
+                if (!isActiveBlock[mesh.xyToBlock(i % mesh.width, i / mesh.width)])
+                    farFieldArea += mesh.area[i];
+            }
+
+            isFarFieldAreaCurrent = true;
         }
 
         return area;
@@ -554,31 +892,104 @@ namespace slsm
         // First initialise the signed distance based on domain boundary.
         closestDomainBoundary();
 
+        if (holes.empty()) return;
+
         /* Now test signed distance against the surface of each hole.
            Update signed distance function when distance to hole surface
-           is less than the current value. Since this is only done once, we
-           use the simplest implementation possible.
+           is less than the current value.
+
+           Rather than testing every node against every hole, the holes are
+           binned into a uniform grid of square cells, with roughly one hole
+           per cell. Each node then searches rings of cells of increasing
+           size around the cell that contains it, stopping once no hole in
+           the next ring could be closer than the current value. Since the
+           initial value is the distance to the domain boundary, the search
+           is always bounded, and for regular hole arrangements only the
+           neighbouring cells are visited.
          */
 
+        // Maximum hole radius.
+        double rMax = 0;
+        for (unsigned int j=0;j<holes.size();j++)
+            rMax = std::max(rMax, holes[j].r);
+
+        // Size and number of cells.
+        double cellSize = std::max(1.0, std::sqrt(double(mesh.width) * mesh.height / holes.size()));
+        int nx = std::max(1, int(std::ceil(mesh.width / cellSize)));
+        int ny = std::max(1, int(std::ceil(mesh.height / cellSize)));
+
+        // The cell containing a point. Holes outside the domain are
+        // assigned to the nearest cell.
+        auto cellX = [&](double x) { return std::min(nx - 1, std::max(0, int(std::floor(x / cellSize)))); };
+        auto cellY = [&](double y) { return std::min(ny - 1, std::max(0, int(std::floor(y / cellSize)))); };
+
+        // Count the holes in each cell.
+        std::vector<unsigned int> cellOffset(nx*ny + 1, 0);
+        for (unsigned int j=0;j<holes.size();j++)
+            cellOffset[cellX(holes[j].coord.x) + nx*cellY(holes[j].coord.y) + 1]++;
+
+        for (int i=0;i<nx*ny;i++)
+            cellOffset[i + 1] += cellOffset[i];
+
+        // Fill the cells, keeping the holes in their original order.
+        std::vector<unsigned int> cellHoles(holes.size());
+        std::vector<unsigned int> nCellHoles(nx*ny, 0);
+        for (unsigned int j=0;j<holes.size();j++)
+        {
+            unsigned int cell = cellX(holes[j].coord.x) + nx*cellY(holes[j].coord.y);
+            cellHoles[cellOffset[cell] + nCellHoles[cell]] = j;
+            nCellHoles[cell]++;
+        }
+
         // Loop over all nodes.
+        #pragma omp parallel for schedule(dynamic, 1024)
         for (unsigned int i=0;i<mesh.nNodes;i++)
         {
-            // Loop over all holes.
-            for (unsigned int j=0;j<holes.size();j++)
+            Coord coord = mesh.nodeCoord(i);
+            int cx = cellX(coord.x);
+            int cy = cellY(coord.y);
+
+            // Loop over rings of cells around the node.
+            for (int k=0;;k++)
             {
-                // Work out x and y distance of the node from the hole centre.
-                double dx = holes[j].coord.x - mesh.nodes[i].coord.x;
-                double dy = holes[j].coord.y - mesh.nodes[i].coord.y;
+                // Holes in ring k are at least (k-1) cells away from the node.
+                // (A small margin is added to allow for rounding.)
+                if ((k > 0) && ((k - 1)*cellSize >= signedDistance[i] + rMax + 1e-6)) break;
+
+                // The ring lies completely outside the grid.
+                if ((cx - k < 0) && (cy - k < 0) && (cx + k >= nx) && (cy + k >= ny)) break;
 
-                // Work out distance (Pythag).
-                double dist = sqrt(dx*dx + dy*dy);
+                for (int y=std::max(0, cy - k);y<=std::min(ny - 1, cy + k);y++)
+                {
+                    // Only the first and last rows span the whole ring.
+                    int step = ((y == cy - k) || (y == cy + k)) ? 1 : 2*k;
 
-                // Signed distance from the hole surface.
-                dist -= holes[j].r;
+                    for (int x=cx - k;x<=cx + k;x+=step)
+                    {
+                        if ((x < 0) || (x >= nx)) continue;
 
-                // If distance is less than current value, then update.
-                if (dist < signedDistance[i])
-                    signedDistance[i] = dist;
+                        // Loop over all holes in the cell.
+                        unsigned int cell = x + nx*y;
+                        for (unsigned int n=cellOffset[cell];n<cellOffset[cell + 1];n++)
+                        {
+                            const Hole& hole = holes[cellHoles[n]];
+
+                            // Work out x and y distance of the node from the hole centre.
+                            double dx = hole.coord.x - coord.x;
+                            double dy = hole.coord.y - coord.y;
+
+                            // Work out distance (Pythag).
+                            double dist = sqrt(dx*dx + dy*dy);
+
+                            // Signed distance from the hole surface.
+                            dist -= hole.r;
+
+                            // If distance is less than current value, then update.
+                            if (dist < signedDistance[i])
+                                signedDistance[i] = dist;
+                        }
+                    }
+                }
             }
         }
     }
@@ -594,28 +1005,111 @@ namespace slsm
            in the vector should be identical, i.e. we have a closed loop
            (for an n-gon there would be n+1 points).
 
-           The signed distance at each node is tested against each segment.
+           The distance from each node to the interface is found using a
+           bounding volume hierarchy over the segments, skipping any part
+           of the hierarchy that lies further from the node than its current
+           value. The nodes inside the polygon are found by scan conversion.
 
            N.B. We currently only support single closed interface.
          */
 
-        // Loop over all nodes.
-        for (unsigned int i=0;i<mesh.nNodes;i++)
+        if (points.size() < 2) return;
+
+        unsigned int nSegments = points.size() - 1;
+
+        // Build the segment hierarchy.
+        std::vector<unsigned int> segments(nSegments);
+        for (unsigned int j=0;j<nSegments;j++)
+            segments[j] = j;
+
+        std::vector<SegmentTreeNode> tree(1);
+        tree.reserve(2*nSegments);
+        buildSegmentTree(points, segments, 0, nSegments, 0, tree);
+
+        // Find the nodes that lie inside the polygon.
+        std::vector<char> isInside;
+        insidePolygon(points, isInside);
+
+        #pragma omp parallel
         {
-            // Loop over all interface segments.
-            for (unsigned int j=0;j<points.size()-1;j++)
+            // The previous node visited by this thread, and its distance from
+            // the interface. Since the distance changes by no more than the
+            // separation between nodes, this gives a tight initial bound.
+            Coord previous;
+            double previousDistance = std::numeric_limits<double>::max();
+
+            // Loop over all nodes.
+            #pragma omp for schedule(dynamic, 1024)
+            for (unsigned int i=0;i<mesh.nNodes;i++)
             {
-                // Compute the minimum distance to the line segment j --> j+1.
-                double dist = pointToLineDistance(points[j], points[j+1], mesh.nodes[i].coord);
+                Coord coord = mesh.nodeCoord(i);
+
+                // Upper bound on the distance from the node to the interface.
+                double dx = coord.x - previous.x;
+                double dy = coord.y - previous.y;
+                double bound = std::min(signedDistance[i], previousDistance + sqrt(dx*dx + dy*dy));
+
+                // Distance from the node to the interface.
+                double distance = std::numeric_limits<double>::max();
+
+                // Stack of tree nodes to visit. (The depth of the tree is
+                // logarithmic in the number of segments.)
+                unsigned int stack[64];
+                unsigned int nStack = 0;
+
+                stack[nStack++] = 0;
+
+                while (nStack > 0)
+                {
+                    const SegmentTreeNode& node = tree[stack[--nStack]];
+
+                    // No segment in the box can be closer than the bound.
+                    // (A small margin is added to allow for rounding.)
+                    double limit = std::min(bound, distance) + 1e-6;
+                    if (boxDistanceSqd(node, coord) >= limit*limit) continue;
+
+                    // Leaf node: test the node against each segment.
+                    if (node.count > 0)
+                    {
+                        for (unsigned int j=node.first;j<node.first+node.count;j++)
+                        {
+                            // Compute the minimum distance to the line segment j --> j+1.
+                            double dist = pointToLineDistance(points[segments[j]], points[segments[j] + 1], coord);
+
+                            distance = std::min(distance, dist);
+                        }
+                    }
+
+                    // Internal node: visit the closest child first.
+                    else
+                    {
+                        unsigned int near = node.first;
+                        unsigned int far = node.first + 1;
+
+                        if (boxDistanceSqd(tree[far], coord) < boxDistanceSqd(tree[near], coord))
+                            std::swap(near, far);
+
+                        stack[nStack++] = far;
+                        stack[nStack++] = near;
+                    }
+                }
 
                 // If distance is less than current value, then update.
-                if (dist < signedDistance[i])
-                    signedDistance[i] = dist;
-            }
+                if (distance < signedDistance[i])
+                    signedDistance[i] = distance;
+
+                // Invert the signed distance function if the point lies inside the polygon.
+                if (isInside[i])
+                    signedDistance[i] *= -1;
 
-            // Invert the signed distance function if the point lies inside the polygon.
-            if (isInsidePolygon(mesh.nodes[i].coord, points))
-                signedDistance[i] *= -1;
+                // Store the distance for the next node. (If the segments were
+                // pruned by the domain boundary, this is still an upper bound.)
+                if (distance < std::numeric_limits<double>::max())
+                {
+                    previous = coord;
+                    previousDistance = distance;
+                }
+            }
         }
     }
 
@@ -625,10 +1119,10 @@ namespace slsm
         for (unsigned int i=0;i<mesh.nNodes;i++)
         {
             // Closest edge in x.
-            unsigned int minX = std::min(mesh.nodes[i].coord.x, mesh.width - mesh.nodes[i].coord.x);
+            unsigned int minX = std::min(mesh.nodeCoord(i).x, mesh.width - mesh.nodeCoord(i).x);
 
             // Closest edge in y.
-            unsigned int minY = std::min(mesh.nodes[i].coord.y, mesh.height - mesh.nodes[i].coord.y);
+            unsigned int minY = std::min(mesh.nodeCoord(i).y, mesh.height - mesh.nodeCoord(i).y);
 
             // Signed distance is the minimum of minX and minY;
             signedDistance[i] = double(std::min(minX, minY));
@@ -637,606 +1131,746 @@ namespace slsm
 
     void LevelSet::initialiseNarrowBand()
     {
-        unsigned int mineWidth = bandWidth - 1;
-
         // Reset the number of nodes in the narrow band.
         nNarrowBand = 0;
 
         // Reset the number of mines.
         nMines = 0;
 
+        // Flag the blocks containing masked nodes.
+        initialiseMaskedBlocks();
+        std::fill(isActiveBlock.begin(), isActiveBlock.end(), false);
+        for (unsigned int i=0;i<maskedBlocks.size();i++)
+            isActiveBlock[maskedBlocks[i]] = true;
+
         // Loop over all nodes.
         for (unsigned int i=0;i<mesh.nNodes;i++)
         {
             // Flag node as inactive.
-            mesh.nodes[i].isActive = false;
+            mesh.isActive[i] = false;
+            mesh.isMine[i] = false;
+
+            addNarrowBandNode(i);
+        }
+
+        // Update the active blocks.
+        initialiseActiveBlocks();
+
+        // Group the narrow band nodes by tile.
+        initialiseTileBand();
+    }
+
+    void LevelSet::updateNarrowBand(std::vector<unsigned int>& nodes)
+    {
+        // The band covers a large fraction of the mesh, so it's cheaper to
+        // search the whole mesh than to sort the candidates.
+        if (nodes.size() > (mesh.nNodes / 8))
+        {
+            initialiseNarrowBand();
+            return;
+        }
+
+        // Clear the flags of the current narrow band. Mines always lie in the band.
+        for (unsigned int i=0;i<nNarrowBand;i++)
+        {
+            mesh.isActive[narrowBand[i]] = false;
+            mesh.isMine[narrowBand[i]] = false;
+        }
+
+        // Reset the number of nodes in the narrow band.
+        nNarrowBand = 0;
 
-            /* Check that the node isn't in a masked region. If it's not, then check
-               whether it lies on the domain boundary, and if it does then check that
-               the boundary isn't fixed.
-             */
-            if (!mesh.nodes[i].isMasked && (!mesh.nodes[i].isDomain || !isFixedDomain))
+        // Reset the number of mines.
+        nMines = 0;
+
+        // Flag the blocks containing masked nodes.
+        std::fill(isActiveBlock.begin(), isActiveBlock.end(), false);
+        for (unsigned int i=0;i<maskedBlocks.size();i++)
+            isActiveBlock[maskedBlocks[i]] = true;
+
+        // Visit the candidates in the same order as a loop over the whole mesh.
+        std::sort(nodes.begin(), nodes.end());
+
+        for (unsigned int i=0;i<nodes.size();i++)
+            addNarrowBandNode(nodes[i]);
+
+        // Update the active blocks.
+        initialiseActiveBlocks();
+
+        // Group the narrow band nodes by tile.
+        initialiseTileBand();
+    }
+
+    void LevelSet::addNarrowBandNode(unsigned int node)
+    {
+        unsigned int mineWidth = bandWidth - 1;
+
+        /* Check that the node isn't in a masked region. If it's not, then check
+           whether it lies on the domain boundary, and if it does then check that
+           the boundary isn't fixed.
+         */
+        if (!mesh.isMasked[node] && (!mesh.isDomain(node) || !isFixedDomain))
+        {
+            // Absolute value of the signed distance function.
+            double absoluteSignedDistance = std::abs(signedDistance[node]);
+
+            // Node lies inside band.
+            if (absoluteSignedDistance < bandWidth)
             {
-                // Absolute value of the signed distance function.
-                double absoluteSignedDistance = std::abs(signedDistance[i]);
+                // Flag node as active.
+                mesh.isActive[node] = true;
 
-                // Node lies inside band.
-                if (absoluteSignedDistance < bandWidth)
-                {
-                    // Flag node as active.
-                    mesh.nodes[i].isActive = true;
+                // Update narrow band array.
+                narrowBand[nNarrowBand] = node;
 
-                    // Update narrow band array.
-                    narrowBand[nNarrowBand] = i;
+                // Increment number of nodes.
+                nNarrowBand++;
 
-                    // Increment number of nodes.
-                    nNarrowBand++;
+                // Flag the block containing the node.
+                Coord coord = mesh.nodeCoord(node);
+                isActiveBlock[mesh.xyToBlock(coord.x, coord.y)] = true;
 
-                    // Node lines at edge of band.
-                    if (absoluteSignedDistance > mineWidth)
-                    {
-                        // Node is a mine.
-                        mesh.nodes[i].isMine = true;
+                // Node lines at edge of band.
+                if (absoluteSignedDistance > mineWidth)
+                {
+                    // Node is a mine.
+                    mesh.isMine[node] = true;
 
-                        // Update mine array.
-                        mines[nMines] = i;
+                    // Update mine array.
+                    mines[nMines] = node;
 
-                        // Increment mine count.
-                        nMines++;
+                    // Increment mine count.
+                    nMines++;
 
-                        // If needed, increase the size of the mines vector.
-                        if (nMines == mines.size())
-                        {
-                            // Double in size, unless that exceeds the number of nodes.
-                            unsigned int newSize = std::min(2*nMines, mesh.nNodes);
-                            mines.resize(newSize);
-                        }
+                    // If needed, increase the size of the mines vector.
+                    if (nMines == mines.size())
+                    {
+                        // Double in size, unless that exceeds the number of nodes.
+                        unsigned int newSize = std::min(2*nMines, mesh.nNodes);
+                        mines.resize(newSize);
                     }
                 }
             }
         }
     }
 
-    void LevelSet::initialiseVelocities(const std::vector<BoundaryPoint>& boundaryPoints)
+    void LevelSet::initialiseMaskedBlocks()
     {
-        // Map boundary point velocities to nodes of the level set domain
-        // using inverse squared distance interpolation.
+        // Whether each block has been added.
+        std::vector<bool> isAdded(mesh.nBlocks, false);
 
-        // Whether the velocity at a node has been set.
-        bool isSet[mesh.nNodes];
+        maskedBlocks.clear();
 
-        // Weighting factor for each node.
-        double weight[mesh.nNodes];
-
-        // Initialise arrays.
         for (unsigned int i=0;i<mesh.nNodes;i++)
         {
-            isSet[i] = false;
-            weight[i] = 0;
-            velocity[i] = 0;
+            if (mesh.isMasked[i])
+            {
+                Coord coord = mesh.nodeCoord(i);
+                unsigned int block = mesh.xyToBlock(coord.x, coord.y);
+
+                if (!isAdded[block])
+                {
+                    isAdded[block] = true;
+                    maskedBlocks.push_back(block);
+                }
+            }
         }
 
-        // Loop over all boundary points.
-        for (unsigned int i=0;i<boundaryPoints.size();i++)
-        {
-            // Find the closest node.
-            unsigned int node = mesh.getClosestNode(boundaryPoints[i].coord);
-
-            // Distance from the boundary point to the node.
-            double dx = mesh.nodes[node].coord.x - boundaryPoints[i].coord.x;
-            double dy = mesh.nodes[node].coord.y - boundaryPoints[i].coord.y;
-
-            // Squared distance.
-            double rSqd = dx*dx + dy*dy;
+        maskedElements.clear();
 
-            // If boundary point lies exactly on the node, then set velocity
-            // to that of the boundary point.
-            if (rSqd < 1e-6)
-            {
-                velocity[node] = boundaryPoints[i].velocity;
-                weight[node] = 1.0;
-                isSet[node] = true;
-            }
-            else
+        for (unsigned int i=0;i<mesh.nElements;i++)
+        {
+            for (unsigned int j=0;j<4;j++)
             {
-                // Update velocity estimate if not already set.
-                if (!isSet[node])
+                if (mesh.isMasked[mesh.elementNode(i, j)])
                 {
-                    velocity[node] += boundaryPoints[i].velocity / rSqd;
-                    weight[node] += 1.0 / rSqd;
+                    maskedElements.push_back(i);
+                    break;
                 }
             }
+        }
+    }
 
-            // Loop over all neighbours of the node.
-            for (unsigned int j=0;j<4;j++)
-            {
-                // Index of the neighbouring node.
-                unsigned int neighbour = mesh.nodes[node].neighbours[j];
+    void LevelSet::initialiseActiveBlocks()
+    {
+        // Blocks containing narrow band, or masked nodes.
+        std::vector<bool> isBandBlock(isActiveBlock);
 
-                // Make sure neighbour is in bounds.
-                if (neighbour < mesh.nNodes)
-                {
-                    // Distance from the boundary point to the node.
-                    double dx = mesh.nodes[neighbour].coord.x - boundaryPoints[i].coord.x;
-                    double dy = mesh.nodes[neighbour].coord.y - boundaryPoints[i].coord.y;
+        // Reset the number of active blocks.
+        nActiveBlocks = 0;
 
-                    // Squared distance.
-                    double rSqd = dx*dx + dy*dy;
+        // Activate blocks that contain, or neighbour, a narrow band block.
+        // The halo ensures that all elements with a node in the narrow band
+        // are contained in the active blocks.
+        for (unsigned int j=0;j<mesh.nBlocksY;j++)
+        {
+            for (unsigned int i=0;i<mesh.nBlocksX;i++)
+            {
+                unsigned int block = i + j*mesh.nBlocksX;
 
-                    // If boundary point lies exactly on the node, then set velocity
-                    // to that of the boundary point.
-                    if (rSqd < 1e-6)
-                    {
-                        velocity[neighbour] = boundaryPoints[i].velocity;
-                        weight[neighbour] = 1.0;
-                        isSet[neighbour] = true;
-                    }
-                    else if (rSqd <= 1.0)
+                isActiveBlock[block] = false;
+
+                for (int y=int(j)-1;y<=int(j)+1;y++)
+                {
+                    for (int x=int(i)-1;x<=int(i)+1;x++)
                     {
-                        // Update velocity estimate if not already set.
-                        if (!isSet[neighbour])
+                        if ((x >= 0) && (x < int(mesh.nBlocksX)) &&
+                            (y >= 0) && (y < int(mesh.nBlocksY)) &&
+                            isBandBlock[x + y*mesh.nBlocksX])
                         {
-                            velocity[neighbour] += boundaryPoints[i].velocity / rSqd;
-                            weight[neighbour] += 1.0 / rSqd;
+                            isActiveBlock[block] = true;
                         }
                     }
                 }
+
+                if (isActiveBlock[block])
+                {
+                    activeBlocks[nActiveBlocks] = block;
+                    nActiveBlocks++;
+                }
             }
         }
 
-        // Compute interpolated velocity.
-        for (unsigned int i=0;i<nNarrowBand;i++)
+        // Store the elements in the active blocks in row-major order, i.e. the
+        // order in which they are visited by a full loop over the mesh.
+        activeElements.clear();
+
+        // Index of the first active block in the current row of blocks.
+        unsigned int first = 0;
+
+        for (unsigned int y=0;y<mesh.height;y++)
         {
-            unsigned int node = narrowBand[i];
-            if (velocity[node]) velocity[node] /= weight[node];
+            // Index of the first block in the next row of blocks.
+            unsigned int end = ((y / Mesh::tileSize) + 1)*mesh.nBlocksX;
+
+            // Skip blocks in previous rows.
+            while ((first < nActiveBlocks) && (activeBlocks[first] < (end - mesh.nBlocksX)))
+                first++;
+
+            for (unsigned int i=first;(i<nActiveBlocks) && (activeBlocks[i] < end);i++)
+            {
+                unsigned int xMin, yMin, xMax, yMax;
+                mesh.blockBounds(activeBlocks[i], xMin, yMin, xMax, yMax);
+
+                // Elements are indexed by their bottom left node.
+                xMax = std::min(xMax, mesh.width);
+
+                for (unsigned int x=xMin;x<xMax;x++)
+                    activeElements.push_back(x + y*mesh.width);
+            }
         }
-    }
 
-    double LevelSet::computeGradient(const unsigned int node) const
-    {
-        // Nodal coordinates.
-        unsigned int x = mesh.nodes[node].coord.x;
-        unsigned int y = mesh.nodes[node].coord.y;
+        // Find the elements that can be cut by the zero contour.
+        initialiseBandElements();
 
-        // Nodal signed distance.
-        double lsf = signedDistance[node];
+        // The mesh status outside of the active blocks must be recomputed.
+        isFarFieldCurrent = false;
+        isFarFieldAreaCurrent = false;
+    }
 
-        // Whether gradient has been computed.
-        bool isGradient = false;
+    void LevelSet::initialiseBandElements()
+    {
+        std::vector<char>& isBandElement = workspace.isBandElement;
+        if (isBandElement.size() != mesh.nElements)
+            isBandElement.assign(mesh.nElements, 0);
 
-        // Zero the gradient.
-        double grad = 0;
+        bandElements.clear();
 
-        // Node is on the left edge.
-        if (x == 0)
+        // Add each element once, flagging it so that duplicates are skipped.
+        auto addElement = [&](unsigned int element)
         {
-            // Node is at bottom left corner.
-            if (y == 0)
+            if (!isBandElement[element])
             {
-                // If signed distance at nodes to right and above is the same, then use
-                // the diagonal node for computing the gradient.
-                if ((std::abs(signedDistance[mesh.xyToIndex[x+1][y]] - lsf) < 1e-6) &&
-                    (std::abs(signedDistance[mesh.xyToIndex[x][y+1]] - lsf) < 1e-6))
-                {
-                    // Calculate signed distance to diagonal node.
-                    grad = std::abs(lsf - signedDistance[mesh.xyToIndex[x+1][y+1]]);
-                    grad *= sqrt(2.0);
-                    isGradient = true;
-                }
+                isBandElement[element] = 1;
+                bandElements.push_back(element);
             }
+        };
 
-            // Node is at top left corner.
-            else if (y == mesh.height)
+        // Elements sharing a narrow band node. Elements are indexed by their
+        // bottom left node.
+        for (unsigned int i=0;i<nNarrowBand;i++)
+        {
+            Coord coord = mesh.nodeCoord(narrowBand[i]);
+            unsigned int x = coord.x;
+            unsigned int y = coord.y;
+
+            for (unsigned int j=0;j<4;j++)
             {
-                // If signed distance at nodes to right and below is the same, then use
-                // the diagonal node for computing the gradient.
-                if ((std::abs(signedDistance[mesh.xyToIndex[x+1][y]] - lsf) < 1e-6) &&
-                    (std::abs(signedDistance[mesh.xyToIndex[x][y-1]] - lsf) < 1e-6))
-                {
-                    // Calculate signed distance to diagonal node.
-                    grad = std::abs(lsf - signedDistance[mesh.xyToIndex[x+1][y-1]]);
-                    grad *= sqrt(2.0);
-                    isGradient = true;
-                }
+                // Element to the bottom left, bottom right, top left, and top right.
+                unsigned int ex = x + (j & 1) - 1;
+                unsigned int ey = y + (j >> 1) - 1;
+
+                // Unsigned wrap-around means that both tests reject elements
+                // beyond either side of the mesh.
+                if ((ex < mesh.width) && (ey < mesh.height))
+                    addElement(ex + ey*mesh.width);
             }
         }
 
-        // Node is on the right edge.
-        else if (x == mesh.width)
+        // Elements with a masked node.
+        for (unsigned int i=0;i<maskedElements.size();i++)
+            addElement(maskedElements[i]);
+
+        // Reset the flags.
+        for (unsigned int i=0;i<bandElements.size();i++)
+            isBandElement[bandElements[i]] = 0;
+
+        // Visit the elements in the same order as a loop over the whole mesh.
+        std::sort(bandElements.begin(), bandElements.end());
+    }
+
+    void LevelSet::initialiseTileBand()
+    {
+        tileBandWidth = mesh.tileWidth;
+        tileBandHeight = mesh.tileHeight;
+
+        // The tile that owns each narrow band node.
+        std::vector<unsigned int>& bandTile = workspace.bandTile;
+        bandTile.resize(nNarrowBand);
+
+        // Whether each narrow band node is an interior node.
+        std::vector<bool>& isInterior = workspace.isInterior;
+        isInterior.resize(nNarrowBand);
+
+        // Count the number of narrow band nodes (and interior nodes) in each tile.
+        tileBandOffset.assign(mesh.nTiles + 1, 0);
+        tileBandEdge.assign(mesh.nTiles, 0);
+        for (unsigned int i=0;i<nNarrowBand;i++)
         {
-            // Node is at bottom right corner.
-            if (y == 0)
-            {
-                // If signed distance at nodes to left and above is the same, then use
-                // the diagonal node for computing the gradient.
-                if ((std::abs(signedDistance[mesh.xyToIndex[x-1][y]] - lsf) < 1e-6) &&
-                    (std::abs(signedDistance[mesh.xyToIndex[x][y+1]] - lsf) < 1e-6))
-                {
-                    // Calculate signed distance to diagonal node.
-                    grad = std::abs(lsf - signedDistance[mesh.xyToIndex[x-1][y+1]]);
-                    grad *= sqrt(2.0);
-                    isGradient = true;
-                }
-            }
+            Coord coord = mesh.nodeCoord(narrowBand[i]);
+            bandTile[i] = mesh.xyToTile(coord.x, coord.y);
+            isInterior[i] = mesh.isInteriorNode(coord.x, coord.y);
+            tileBandOffset[bandTile[i] + 1]++;
+            if (isInterior[i]) tileBandEdge[bandTile[i]]++;
+        }
 
-            // Node is at top right corner.
-            else if (y == mesh.height)
-            {
-                // If signed distance at nodes to left and below is the same, then use
-                // the diagonal node for computing the gradient.
-                if ((std::abs(signedDistance[mesh.xyToIndex[x-1][y]] - lsf) < 1e-6) &&
-                    (std::abs(signedDistance[mesh.xyToIndex[x][y-1]] - lsf) < 1e-6))
-                {
-                    // Calculate signed distance to diagonal node.
-                    grad = std::abs(lsf - signedDistance[mesh.xyToIndex[x-1][y-1]]);
-                    grad *= sqrt(2.0);
-                    isGradient = true;
-                }
-            }
+        // Convert counts to offsets.
+        for (unsigned int i=0;i<mesh.nTiles;i++)
+        {
+            tileBandOffset[i + 1] += tileBandOffset[i];
+            tileBandEdge[i] += tileBandOffset[i];
         }
 
-        // Gradient hasn't already been calculated.
-        if (!isGradient)
+        // Fill the nodes, interior nodes first, preserving their order
+        // within each tile.
+        std::vector<unsigned int>& next = workspace.next;
+        std::vector<unsigned int>& nextEdge = workspace.nextEdge;
+        next.assign(tileBandOffset.begin(), tileBandOffset.end() - 1);
+        nextEdge.assign(tileBandEdge.begin(), tileBandEdge.end());
+        tileBand.resize(nNarrowBand);
+        for (unsigned int i=0;i<nNarrowBand;i++)
         {
-            // Stencil values for the WENO approximation.
-            double v1, v2, v3, v4, v5;
+            unsigned int& index = isInterior[i] ? next[bandTile[i]] : nextEdge[bandTile[i]];
+            tileBand[index] = narrowBand[i];
+            index++;
+        }
+    }
 
-            // Upwind direction.
-            int sign = velocity[node] < 0 ? -1 : 1;
+    void LevelSet::initialiseVelocities(const std::vector<BoundaryPoint>& boundaryPoints)
+    {
+        // Map boundary point velocities to nodes of the level set domain
+        // using inverse squared distance interpolation.
 
-            // Derivatives to right.
+        // Whether the velocity at a node has been set, and the weighting
+        // factor for each node. These are zero between calls.
+        if (workspace.weight.size() != mesh.nNodes)
+        {
+            workspace.isSet.assign(mesh.nNodes, 0);
+            workspace.weight.assign(mesh.nNodes, 0);
+        }
+        char* isSet = workspace.isSet.data();
+        double* weight = workspace.weight.data();
 
-            // Node on left-hand edge.
-            if (x == 0)
-            {
-                v1 = signedDistance[mesh.xyToIndex[3][y]] - signedDistance[mesh.xyToIndex[2][y]];
-                v2 = signedDistance[mesh.xyToIndex[2][y]] - signedDistance[mesh.xyToIndex[1][y]];
-                v3 = signedDistance[mesh.xyToIndex[1][y]] - signedDistance[mesh.xyToIndex[0][y]];
+        // Zero the velocities.
+        #pragma omp parallel for
+        for (unsigned int i=0;i<mesh.nNodes;i++)
+            velocity[i] = 0;
 
-                // Approximate derivatives outside of domain.
-                v4 = v3;
-                v5 = v3;
-            }
+        // Make sure that the narrow band is grouped by the current tiles.
+        if ((tileBandWidth != mesh.tileWidth) || (tileBandHeight != mesh.tileHeight))
+            initialiseTileBand();
 
-            // One node to right of left-hand edge.
-            else if (x == 1)
-            {
-                v1 = signedDistance[mesh.xyToIndex[4][y]] - signedDistance[mesh.xyToIndex[3][y]];
-                v2 = signedDistance[mesh.xyToIndex[3][y]] - signedDistance[mesh.xyToIndex[2][y]];
-                v3 = signedDistance[mesh.xyToIndex[2][y]] - signedDistance[mesh.xyToIndex[1][y]];
-                v4 = signedDistance[mesh.xyToIndex[1][y]] - signedDistance[mesh.xyToIndex[0][y]];
+        unsigned int nPoints = boundaryPoints.size();
 
-                // Approximate derivatives outside of domain.
-                v5 = v4;
-            }
+        // The node closest to each boundary point.
+        std::vector<unsigned int>& closestNode = workspace.closestNode;
+        closestNode.resize(nPoints);
 
-            // Node on right-hand edge.
-            else if (x == mesh.width)
-            {
-                v5 = signedDistance[mesh.xyToIndex[x-1][y]] - signedDistance[mesh.xyToIndex[x-2][y]];
-                v4 = signedDistance[mesh.xyToIndex[x][y]]   - signedDistance[mesh.xyToIndex[x-1][y]];
+        // The tiles that own the closest node or its neighbours, which are
+        // the nodes that a boundary point contributes to.
+        std::vector<unsigned int>& pointTiles = workspace.pointTiles;
+        std::vector<unsigned int>& nPointTiles = workspace.nPointTiles;
+        pointTiles.resize(5*nPoints);
+        nPointTiles.assign(nPoints, 0);
 
-                // Approximate derivatives outside of domain.
-                v3 = v4;
-                v2 = v4;
-                v1 = v4;
-            }
+        // Count the number of boundary points that contribute to each tile.
+        std::vector<unsigned int>& tilePointOffset = workspace.tilePointOffset;
+        tilePointOffset.assign(mesh.nTiles + 1, 0);
+
+        for (unsigned int i=0;i<nPoints;i++)
+        {
+            closestNode[i] = mesh.getClosestNode(boundaryPoints[i].coord);
 
-            // One node to left of right-hand edge.
-            else if (x == (mesh.width - 1))
+            for (unsigned int j=0;j<5;j++)
             {
-                v5 = signedDistance[mesh.xyToIndex[x-1][y]] - signedDistance[mesh.xyToIndex[x-2][y]];
-                v4 = signedDistance[mesh.xyToIndex[x][y]]   - signedDistance[mesh.xyToIndex[x-1][y]];
-                v3 = signedDistance[mesh.xyToIndex[x+1][y]] - signedDistance[mesh.xyToIndex[x][y]];
+                // The closest node, then its neighbours.
+                unsigned int node = (j == 0) ? closestNode[i] : mesh.neighbour(closestNode[i], j - 1);
 
-                // Approximate derivatives outside of domain.
-                v2 = v3;
-                v1 = v3;
-            }
+                if (node < mesh.nNodes)
+                {
+                    Coord coord = mesh.nodeCoord(node);
+                    unsigned int tile = mesh.xyToTile(coord.x, coord.y);
 
-            // Two nodes to left of right-hand edge.
-            else if (x == (mesh.width - 2))
-            {
-                v5 = signedDistance[mesh.xyToIndex[x-1][y]] - signedDistance[mesh.xyToIndex[x-2][y]];
-                v4 = signedDistance[mesh.xyToIndex[x][y]]   - signedDistance[mesh.xyToIndex[x-1][y]];
-                v3 = signedDistance[mesh.xyToIndex[x+1][y]] - signedDistance[mesh.xyToIndex[x][y]];
-                v2 = signedDistance[mesh.xyToIndex[x+2][y]] - signedDistance[mesh.xyToIndex[x+1][y]];
+                    // Check whether the tile has already been added.
+                    bool isAdded = false;
+                    for (unsigned int k=0;k<nPointTiles[i];k++)
+                        if (pointTiles[5*i + k] == tile) isAdded = true;
 
-                // Approximate derivatives outside of domain.
-                v1 = v2;
+                    if (!isAdded)
+                    {
+                        pointTiles[5*i + nPointTiles[i]] = tile;
+                        nPointTiles[i]++;
+                        tilePointOffset[tile + 1]++;
+                    }
+                }
             }
+        }
 
-            // Node lies in bulk.
-            else
+        // Convert counts to offsets.
+        for (unsigned int i=0;i<mesh.nTiles;i++)
+            tilePointOffset[i + 1] += tilePointOffset[i];
+
+        // Group the boundary points by tile, preserving their order.
+        std::vector<unsigned int>& tilePoints = workspace.tilePoints;
+        std::vector<unsigned int>& next = workspace.next;
+        tilePoints.resize(tilePointOffset[mesh.nTiles]);
+        next.assign(tilePointOffset.begin(), tilePointOffset.end() - 1);
+        for (unsigned int i=0;i<nPoints;i++)
+        {
+            for (unsigned int j=0;j<nPointTiles[i];j++)
             {
-                v1 = signedDistance[mesh.xyToIndex[x+3][y]] - signedDistance[mesh.xyToIndex[x+2][y]];
-                v2 = signedDistance[mesh.xyToIndex[x+2][y]] - signedDistance[mesh.xyToIndex[x+1][y]];
-                v3 = signedDistance[mesh.xyToIndex[x+1][y]] - signedDistance[mesh.xyToIndex[x][y]];
-                v4 = signedDistance[mesh.xyToIndex[x][y]]   - signedDistance[mesh.xyToIndex[x-1][y]];
-                v5 = signedDistance[mesh.xyToIndex[x-1][y]] - signedDistance[mesh.xyToIndex[x-2][y]];
+                unsigned int tile = pointTiles[5*i + j];
+                tilePoints[next[tile]] = i;
+                next[tile]++;
             }
+        }
 
-            double gradRight = sign * gradHJWENO(v1, v2, v3, v4, v5);
-
-            // Derivatives to left.
-
-            // Node on right-hand edge.
-            if (x == mesh.width)
+        // Map the velocities tile by tile. Each tile only updates the nodes
+        // that it owns, and visits the boundary points in the same order as
+        // a serial loop, so the result is independent of the decomposition.
+        #pragma omp parallel for schedule(dynamic)
+        for (unsigned int i=0;i<mesh.nTiles;i++)
+        {
+            for (unsigned int j=tilePointOffset[i];j<tilePointOffset[i+1];j++)
             {
-                v1 = signedDistance[mesh.xyToIndex[x-2][y]] - signedDistance[mesh.xyToIndex[x-3][y]];
-                v2 = signedDistance[mesh.xyToIndex[x-1][y]] - signedDistance[mesh.xyToIndex[x-2][y]];
-                v3 = signedDistance[mesh.xyToIndex[x][y]]   - signedDistance[mesh.xyToIndex[x-1][y]];
-
-                // Approximate derivatives outside of domain.
-                v4 = v3;
-                v5 = v3;
+                unsigned int point = tilePoints[j];
+                mapVelocity(boundaryPoints[point], closestNode[point], mesh.tiles[i], isSet, weight);
             }
 
-            // One node to left of right-hand edge.
-            else if (x == (mesh.width-1))
+            // Compute interpolated velocity.
+            for (unsigned int j=tileBandOffset[i];j<tileBandOffset[i+1];j++)
             {
-                v1 = signedDistance[mesh.xyToIndex[x-2][y]] - signedDistance[mesh.xyToIndex[x-3][y]];
-                v2 = signedDistance[mesh.xyToIndex[x-1][y]] - signedDistance[mesh.xyToIndex[x-2][y]];
-                v3 = signedDistance[mesh.xyToIndex[x][y]]   - signedDistance[mesh.xyToIndex[x-1][y]];
-                v4 = signedDistance[mesh.xyToIndex[x+1][y]] - signedDistance[mesh.xyToIndex[x][y]];
-
-                // Approximate derivatives outside of domain.
-                v5 = v4;
+                unsigned int node = tileBand[j];
+                if (velocity[node]) velocity[node] /= weight[node];
             }
 
-            // Node on left-hand edge.
-            else if (x == 0)
+            // Reset the weights of the nodes that were used.
+            for (unsigned int j=tilePointOffset[i];j<tilePointOffset[i+1];j++)
             {
-                v5 = signedDistance[mesh.xyToIndex[2][y]] - signedDistance[mesh.xyToIndex[1][y]];
-                v4 = signedDistance[mesh.xyToIndex[1][y]] - signedDistance[mesh.xyToIndex[0][y]];
+                unsigned int node = closestNode[tilePoints[j]];
 
-                // Approximate derivatives outside of domain.
-                v3 = v4;
-                v2 = v4;
-                v1 = v4;
-            }
+                for (unsigned int k=0;k<5;k++)
+                {
+                    // The closest node, then its neighbours.
+                    unsigned int n = (k == 0) ? node : mesh.neighbour(node, k - 1);
 
-            // One node to right of left-hand edge.
-            else if (x == 1)
-            {
-                v5 = signedDistance[mesh.xyToIndex[3][y]] - signedDistance[mesh.xyToIndex[2][y]];
-                v4 = signedDistance[mesh.xyToIndex[2][y]] - signedDistance[mesh.xyToIndex[1][y]];
-                v3 = signedDistance[mesh.xyToIndex[1][y]] - signedDistance[mesh.xyToIndex[0][y]];
+                    if (n < mesh.nNodes)
+                    {
+                        Coord coord = mesh.nodeCoord(n);
 
-                // Approximate derivatives outside of domain.
-                v2 = v3;
-                v1 = v3;
+                        if (mesh.tiles[i].contains(coord.x, coord.y))
+                        {
+                            isSet[n] = 0;
+                            weight[n] = 0;
+                        }
+                    }
+                }
             }
+        }
+    }
 
-            // Two nodes to right of left-hand edge.
-            else if (x == 2)
-            {
-                v5 = signedDistance[mesh.xyToIndex[4][y]] - signedDistance[mesh.xyToIndex[3][y]];
-                v4 = signedDistance[mesh.xyToIndex[3][y]] - signedDistance[mesh.xyToIndex[2][y]];
-                v3 = signedDistance[mesh.xyToIndex[2][y]] - signedDistance[mesh.xyToIndex[1][y]];
-                v2 = signedDistance[mesh.xyToIndex[1][y]] - signedDistance[mesh.xyToIndex[0][y]];
+    void LevelSet::mapVelocity(const BoundaryPoint& point, unsigned int node,
+        const Tile& tile, char* isSet, double* weight)
+    {
+        // Coordinates of the node.
+        Coord coord = mesh.nodeCoord(node);
 
-                // Approximate derivatives outside of domain.
-                v1 = v2;
-            }
+        // The node is owned by the tile.
+        if (tile.contains(coord.x, coord.y))
+        {
+            // Distance from the boundary point to the node.
+            double dx = coord.x - point.coord.x;
+            double dy = coord.y - point.coord.y;
 
-            // Node lies in bulk.
+            // Squared distance.
+            double rSqd = dx*dx + dy*dy;
+
+            // If boundary point lies exactly on the node, then set velocity
+            // to that of the boundary point.
+            if (rSqd < 1e-6)
+            {
+                velocity[node] = point.velocity;
+                weight[node] = 1.0;
+                isSet[node] = true;
+            }
             else
             {
-                v1 = signedDistance[mesh.xyToIndex[x-2][y]] - signedDistance[mesh.xyToIndex[x-3][y]];
-                v2 = signedDistance[mesh.xyToIndex[x-1][y]] - signedDistance[mesh.xyToIndex[x-2][y]];
-                v3 = signedDistance[mesh.xyToIndex[x][y]]   - signedDistance[mesh.xyToIndex[x-1][y]];
-                v4 = signedDistance[mesh.xyToIndex[x+1][y]] - signedDistance[mesh.xyToIndex[x][y]];
-                v5 = signedDistance[mesh.xyToIndex[x+2][y]] - signedDistance[mesh.xyToIndex[x+1][y]];
+                // Update velocity estimate if not already set.
+                if (!isSet[node])
+                {
+                    velocity[node] += point.velocity / rSqd;
+                    weight[node] += 1.0 / rSqd;
+                }
             }
+        }
 
-            double gradLeft = sign * gradHJWENO(v1, v2, v3, v4, v5);
-
-            // Upward derivatives.
+        // Loop over all neighbours of the node.
+        for (unsigned int j=0;j<4;j++)
+        {
+            // Index of the neighbouring node.
+            unsigned int neighbour = mesh.neighbour(node, j);
 
-            // Node on bottom edge.
-            if (y == 0)
+            // Make sure neighbour is in bounds.
+            if (neighbour < mesh.nNodes)
             {
-                v1 = signedDistance[mesh.xyToIndex[x][3]] - signedDistance[mesh.xyToIndex[x][2]];
-                v2 = signedDistance[mesh.xyToIndex[x][2]] - signedDistance[mesh.xyToIndex[x][1]];
-                v3 = signedDistance[mesh.xyToIndex[x][1]] - signedDistance[mesh.xyToIndex[x][0]];
-
-                // Approximate derivatives outside of domain.
-                v4 = v3;
-                v5 = v3;
-            }
+                // Coordinates of the neighbour.
+                coord = mesh.nodeCoord(neighbour);
 
-            // One node above bottom edge.
-            else if (y == 1)
-            {
-                v1 = signedDistance[mesh.xyToIndex[x][4]] - signedDistance[mesh.xyToIndex[x][3]];
-                v2 = signedDistance[mesh.xyToIndex[x][3]] - signedDistance[mesh.xyToIndex[x][2]];
-                v3 = signedDistance[mesh.xyToIndex[x][2]] - signedDistance[mesh.xyToIndex[x][1]];
-                v4 = signedDistance[mesh.xyToIndex[x][1]] - signedDistance[mesh.xyToIndex[x][0]];
+                // The neighbour is owned by another tile.
+                if (!tile.contains(coord.x, coord.y)) continue;
 
-                // Approximate derivatives outside of domain.
-                v5 = v4;
-            }
+                // Distance from the boundary point to the node.
+                double dx = coord.x - point.coord.x;
+                double dy = coord.y - point.coord.y;
 
-            // Node is on top edge.
-            else if (y == mesh.height)
-            {
-                v5 = signedDistance[mesh.xyToIndex[x][y-1]] - signedDistance[mesh.xyToIndex[x][y-2]];
-                v4 = signedDistance[mesh.xyToIndex[x][y]]   - signedDistance[mesh.xyToIndex[x][y-1]];
+                // Squared distance.
+                double rSqd = dx*dx + dy*dy;
 
-                // Approximate derivatives outside of domain.
-                v3 = v4;
-                v2 = v4;
-                v1 = v4;
+                // If boundary point lies exactly on the node, then set velocity
+                // to that of the boundary point.
+                if (rSqd < 1e-6)
+                {
+                    velocity[neighbour] = point.velocity;
+                    weight[neighbour] = 1.0;
+                    isSet[neighbour] = true;
+                }
+                else if (rSqd <= 1.0)
+                {
+                    // Update velocity estimate if not already set.
+                    if (!isSet[neighbour])
+                    {
+                        velocity[neighbour] += point.velocity / rSqd;
+                        weight[neighbour] += 1.0 / rSqd;
+                    }
+                }
             }
+        }
+    }
 
-            // One node below top edge.
-            else if (y == (mesh.height - 1))
-            {
-                v5 = signedDistance[mesh.xyToIndex[x][y-1]] - signedDistance[mesh.xyToIndex[x][y-2]];
-                v4 = signedDistance[mesh.xyToIndex[x][y]]   - signedDistance[mesh.xyToIndex[x][y-1]];
-                v3 = signedDistance[mesh.xyToIndex[x][y+1]] - signedDistance[mesh.xyToIndex[x][y]];
+    FastMarchingMethod& LevelSet::fastMarchingMethod()
+    {
+        // Create the fast marching method object on first use.
+        if (!workspace.fmm)
+            workspace.fmm.reset(new FastMarchingMethod(mesh, false));
 
-                // Approximate derivatives outside of domain.
-                v2 = v3;
-                v1 = v3;
-            }
+        return *workspace.fmm;
+    }
 
-            // Two nodes below top edge.
-            else if (y == (mesh.height - 2))
-            {
-                v5 = signedDistance[mesh.xyToIndex[x][y-1]] - signedDistance[mesh.xyToIndex[x][y-2]];
-                v4 = signedDistance[mesh.xyToIndex[x][y]]   - signedDistance[mesh.xyToIndex[x][y-1]];
-                v3 = signedDistance[mesh.xyToIndex[x][y+1]] - signedDistance[mesh.xyToIndex[x][y]];
-                v2 = signedDistance[mesh.xyToIndex[x][y+2]] - signedDistance[mesh.xyToIndex[x][y+1]];
+    double LevelSet::reinitialiseCutOff() const
+    {
+        if (isBandLimited) return bandWidth + 3;
+        else return std::numeric_limits<double>::max();
+    }
 
-                // Approximate derivatives outside of domain.
-                v1 = v2;
-            }
+    FastSweepingMethod& LevelSet::fastSweepingMethod()
+    {
+        // Create the fast sweeping method object on first use.
+        if (!workspace.fsm)
+            workspace.fsm.reset(new FastSweepingMethod(mesh));
 
-            // Node lies in bulk.
-            else
-            {
-                v1 = signedDistance[mesh.xyToIndex[x][y+3]] - signedDistance[mesh.xyToIndex[x][y+2]];
-                v2 = signedDistance[mesh.xyToIndex[x][y+2]] - signedDistance[mesh.xyToIndex[x][y+1]];
-                v3 = signedDistance[mesh.xyToIndex[x][y+1]] - signedDistance[mesh.xyToIndex[x][y]];
-                v4 = signedDistance[mesh.xyToIndex[x][y]]   - signedDistance[mesh.xyToIndex[x][y-1]];
-                v5 = signedDistance[mesh.xyToIndex[x][y-1]] - signedDistance[mesh.xyToIndex[x][y-2]];
-            }
+        return *workspace.fsm;
+    }
 
-            double gradUp = sign * gradHJWENO(v1, v2, v3, v4, v5);
+    FastIterativeMethod& LevelSet::fastIterativeMethod()
+    {
+        // Create the fast iterative method object on first use.
+        if (!workspace.fim)
+            workspace.fim.reset(new FastIterativeMethod(mesh));
 
-            // Downward derivative.
+        return *workspace.fim;
+    }
 
-            // Node on top edge.
-            if (y == mesh.height)
-            {
-                v1 = signedDistance[mesh.xyToIndex[x][y-2]] - signedDistance[mesh.xyToIndex[x][y-3]];
-                v2 = signedDistance[mesh.xyToIndex[x][y-1]] - signedDistance[mesh.xyToIndex[x][y-2]];
-                v3 = signedDistance[mesh.xyToIndex[x][y]]   - signedDistance[mesh.xyToIndex[x][y-1]];
+    ClosestPointTransform& LevelSet::closestPointTransform()
+    {
+        // Create the closest point transform object on first use.
+        if (!workspace.cpt)
+            workspace.cpt.reset(new ClosestPointTransform(mesh));
 
-                // Approximate derivatives outside of domain.
-                v4 = v3;
-                v5 = v3;
-            }
+        return *workspace.cpt;
+    }
 
-            // One node below top edge.
-            else if (y == (mesh.height - 1))
-            {
-                v1 = signedDistance[mesh.xyToIndex[x][y-2]] - signedDistance[mesh.xyToIndex[x][y-3]];
-                v2 = signedDistance[mesh.xyToIndex[x][y-1]] - signedDistance[mesh.xyToIndex[x][y-2]];
-                v3 = signedDistance[mesh.xyToIndex[x][y]]   - signedDistance[mesh.xyToIndex[x][y-1]];
-                v4 = signedDistance[mesh.xyToIndex[x][y+1]] - signedDistance[mesh.xyToIndex[x][y]];
+    bool LevelSet::cornerGradient(const unsigned int x, const unsigned int y, double& grad) const
+    {
+        // Nodal signed distance.
+        double lsf = signedDistance[mesh.xyToIndex(x, y)];
 
-                // Approximate derivatives outside of domain.
-                v5 = v4;
-            }
+        // Whether gradient has been computed.
+        bool isGradient = false;
 
-            // Node lies on bottom edge
-            else if (y == 0)
+        // Node is on the left edge.
+        if (x == 0)
+        {
+            // Node is at bottom left corner.
+            if (y == 0)
             {
-                v5 = signedDistance[mesh.xyToIndex[x][2]] - signedDistance[mesh.xyToIndex[x][1]];
-                v4 = signedDistance[mesh.xyToIndex[x][1]] - signedDistance[mesh.xyToIndex[x][0]];
-
-                // Approximate derivatives outside of domain.
-                v3 = v4;
-                v2 = v4;
-                v1 = v4;
+                // If signed distance at nodes to right and above is the same, then use
+                // the diagonal node for computing the gradient.
+                if ((std::abs(signedDistance[mesh.xyToIndex(x+1, y)] - lsf) < 1e-6) &&
+                    (std::abs(signedDistance[mesh.xyToIndex(x, y+1)] - lsf) < 1e-6))
+                {
+                    // Calculate signed distance to diagonal node.
+                    grad = std::abs(lsf - signedDistance[mesh.xyToIndex(x+1, y+1)]);
+                    grad *= sqrt(2.0);
+                    isGradient = true;
+                }
             }
 
-            // One node above bottom edge.
-            else if (y == 1)
+            // Node is at top left corner.
+            else if (y == mesh.height)
             {
-                v5 = signedDistance[mesh.xyToIndex[x][3]] - signedDistance[mesh.xyToIndex[x][2]];
-                v4 = signedDistance[mesh.xyToIndex[x][2]] - signedDistance[mesh.xyToIndex[x][1]];
-                v3 = signedDistance[mesh.xyToIndex[x][1]] - signedDistance[mesh.xyToIndex[x][0]];
-
-                // Approximate derivatives outside of domain.
-                v2 = v3;
-                v1 = v3;
+                // If signed distance at nodes to right and below is the same, then use
+                // the diagonal node for computing the gradient.
+                if ((std::abs(signedDistance[mesh.xyToIndex(x+1, y)] - lsf) < 1e-6) &&
+                    (std::abs(signedDistance[mesh.xyToIndex(x, y-1)] - lsf) < 1e-6))
+                {
+                    // Calculate signed distance to diagonal node.
+                    grad = std::abs(lsf - signedDistance[mesh.xyToIndex(x+1, y-1)]);
+                    grad *= sqrt(2.0);
+                    isGradient = true;
+                }
             }
+        }
 
-            // Two nodes above bottom edge.
-            else if (y == 2)
+        // Node is on the right edge.
+        else if (x == mesh.width)
+        {
+            // Node is at bottom right corner.
+            if (y == 0)
             {
-                v5 = signedDistance[mesh.xyToIndex[x][4]] - signedDistance[mesh.xyToIndex[x][3]];
-                v4 = signedDistance[mesh.xyToIndex[x][3]] - signedDistance[mesh.xyToIndex[x][2]];
-                v3 = signedDistance[mesh.xyToIndex[x][2]] - signedDistance[mesh.xyToIndex[x][1]];
-                v2 = signedDistance[mesh.xyToIndex[x][1]] - signedDistance[mesh.xyToIndex[x][0]];
-
-                // Approximate derivatives outside of domain.
-                v1 = v2;
+                // If signed distance at nodes to left and above is the same, then use
+                // the diagonal node for computing the gradient.
+                if ((std::abs(signedDistance[mesh.xyToIndex(x-1, y)] - lsf) < 1e-6) &&
+                    (std::abs(signedDistance[mesh.xyToIndex(x, y+1)] - lsf) < 1e-6))
+                {
+                    // Calculate signed distance to diagonal node.
+                    grad = std::abs(lsf - signedDistance[mesh.xyToIndex(x-1, y+1)]);
+                    grad *= sqrt(2.0);
+                    isGradient = true;
+                }
             }
 
-            // Node lies in bulk.
-            else
+            // Node is at top right corner.
+            else if (y == mesh.height)
             {
-                v1 = signedDistance[mesh.xyToIndex[x][y-2]] - signedDistance[mesh.xyToIndex[x][y-3]];
-                v2 = signedDistance[mesh.xyToIndex[x][y-1]] - signedDistance[mesh.xyToIndex[x][y-2]];
-                v3 = signedDistance[mesh.xyToIndex[x][y]]   - signedDistance[mesh.xyToIndex[x][y-1]];
-                v4 = signedDistance[mesh.xyToIndex[x][y+1]] - signedDistance[mesh.xyToIndex[x][y]];
-                v5 = signedDistance[mesh.xyToIndex[x][y+2]] - signedDistance[mesh.xyToIndex[x][y+1]];
+                // If signed distance at nodes to left and below is the same, then use
+                // the diagonal node for computing the gradient.
+                if ((std::abs(signedDistance[mesh.xyToIndex(x-1, y)] - lsf) < 1e-6) &&
+                    (std::abs(signedDistance[mesh.xyToIndex(x, y-1)] - lsf) < 1e-6))
+                {
+                    // Calculate signed distance to diagonal node.
+                    grad = std::abs(lsf - signedDistance[mesh.xyToIndex(x-1, y-1)]);
+                    grad *= sqrt(2.0);
+                    isGradient = true;
+                }
             }
-
-            double gradDown = sign * gradHJWENO(v1, v2, v3, v4, v5);
-
-            // Compute gradient using upwind scheme.
-
-            if (gradDown > 0)   grad += gradDown * gradDown;
-            if (gradLeft > 0)   grad += gradLeft * gradLeft;
-            if (gradUp < 0)     grad += gradUp * gradUp;
-            if (gradRight < 0)  grad += gradRight * gradRight;
-
-            grad = sqrt(grad);
         }
 
-        // Return gradient.
-        return grad;
+        return isGradient;
     }
 
-    double LevelSet::gradHJWENO(double v1, double v2, double v3, double v4, double v5) const
+    void LevelSet::interiorStencils(const unsigned int x, const unsigned int y, double* v, const unsigned int stride) const
     {
-        // Calculate the gradient using the 5th order Hamilton-Jacobi WENO approximation.
-        // Taken from pages 34-35 of "Level Set Methods and Dynamic Implicit Surfaces".
-        // See: http://web.stanford.edu/class/cs237c/Lecture16.pdf
+        // Nodes in the row and column through the node.
+        unsigned int row[7], column[7];
+        mesh.interiorStencil(x, y, row, column);
+
+        // Differences between neighbouring nodes in the row and column,
+        // i.e. dx[i] is the value at x+i-2 minus the value at x+i-3.
+        double dx[6], dy[6];
+        for (unsigned int i=0;i<6;i++)
+        {
+            dx[i] = signedDistance[row[i + 1]] - signedDistance[row[i]];
+            dy[i] = signedDistance[column[i + 1]] - signedDistance[column[i]];
+        }
 
-        double oneQuarter        = 1.0  / 4.0;
-        double thirteenTwelths   = 13.0 / 12.0;
-        double eps               = 1e-6;
+        // Derivatives to right.
+        storeStencil(v, stride, dx[5], dx[4], dx[3], dx[2], dx[1]);
 
-        // Estimate the smoothness of each stencil.
+        // Derivatives to left.
+        storeStencil(v + 5*stride, stride, dx[0], dx[1], dx[2], dx[3], dx[4]);
 
-        double s1 = thirteenTwelths * (v1 - 2*v2 + v3)*(v1 - 2*v2 + v3)
-                  + oneQuarter * (v1 - 4*v2 + 3*v3)*(v1 - 4*v2 + 3*v3);
+        // Upward derivatives.
+        storeStencil(v + 10*stride, stride, dy[5], dy[4], dy[3], dy[2], dy[1]);
 
-        double s2 = thirteenTwelths * (v2 - 2*v3 + v4)*(v2 - 2*v3 + v4)
-                  + oneQuarter * (v2 - v4)*(v2 - v4);
+        // Downward derivatives.
+        storeStencil(v + 15*stride, stride, dy[0], dy[1], dy[2], dy[3], dy[4]);
+    }
 
-        double s3 = thirteenTwelths * (v3 - 2*v4 + v5)*(v3 - 2*v4 + v5)
-                  + oneQuarter * (3*v3 - 4*v4 + v5)*(3*v3 - 4*v4 + v5);
+    void LevelSet::edgeStencils(const unsigned int x, const unsigned int y, double* v, const unsigned int stride) const
+    {
+        // Precomputed one-sided stencil for the node.
+        const unsigned int* pairs = mesh.edgeStencil(x, y);
 
-        // Compute the alpha values for each stencil.
+        for (unsigned int i=0;i<20;i++)
+            v[i*stride] = signedDistance[pairs[2*i]] - signedDistance[pairs[2*i + 1]];
+    }
 
-        double alpha1 = 0.1 / ((s1 + eps)*(s1 + eps));
-        double alpha2 = 0.6 / ((s2 + eps)*(s2 + eps));
-        double alpha3 = 0.3 / ((s3 + eps)*(s3 + eps));
+    double LevelSet::upwindGradient(const unsigned int node, const double* weno) const
+    {
+        // Zero the gradient.
+        double grad = 0;
 
-        // Calculate the normalised weights.
+        // Upwind direction.
+        int sign = velocity[node] < 0 ? -1 : 1;
 
-        double totalWeight = alpha1 + alpha2 + alpha3;
+        double gradRight = sign * weno[0];
+        double gradLeft  = sign * weno[1];
+        double gradUp    = sign * weno[2];
+        double gradDown  = sign * weno[3];
 
-        double w1 = alpha1 / totalWeight;
-        double w2 = alpha2 / totalWeight;
-        double w3 = alpha3 / totalWeight;
+        // Compute gradient using upwind scheme.
 
-        // Sum the three stencil components.
-        double grad = w1 * (2*v1 - 7*v2 + 11*v3)
-                    + w2 * (5*v3 - v2 + 2*v4)
-                    + w3 * (2*v3 + 5*v4 - v5);
+        if (gradDown > 0)   grad += gradDown * gradDown;
+        if (gradLeft > 0)   grad += gradLeft * gradLeft;
+        if (gradUp < 0)     grad += gradUp * gradUp;
+        if (gradRight < 0)  grad += gradRight * gradRight;
 
-        grad *= (1.0 / 6.0);
+        return sqrt(grad);
+    }
 
-        return grad;
+    double LevelSet::gradHJWENO(double v1, double v2, double v3, double v4, double v5)
+    {
+        return hjweno(v1, v2, v3, v4, v5);
+    }
+
+    void LevelSet::gradHJWENO(const double* v1, const double* v2, const double* v3,
+        const double* v4, const double* v5, double* grad, unsigned int n)
+    {
+        // The loop body is branch free, allowing the compiler to evaluate
+        // several stencils at once using SIMD instructions.
+        #pragma omp simd
+        for (unsigned int i=0;i<n;i++)
+            grad[i] = hjweno(v1[i], v2[i], v3[i], v4[i], v5[i]);
     }
 
     double LevelSet::pointToLineDistance(const Coord& vertex1, const Coord& vertex2, const Coord& point) const
@@ -1289,47 +1923,79 @@ namespace slsm
         }
     }
 
-    bool LevelSet::isInsidePolygon(const Coord& point, const std::vector<Coord>& vertices) const
+    void LevelSet::insidePolygon(const std::vector<Coord>& vertices, std::vector<char>& isInside) const
     {
-        /* Test whether a point lies inside a polygon.
+        /* Find the nodes that lie inside a polygon by scan conversion.
+
+           This gives the same result as a winding number test of every
+           node, where a node is inside unless its winding number is zero. See:
+           http://geomalgorithms.com/a03-_inclusion.html
+
+           For a row of nodes, an edge only contributes to the winding
+           number if it crosses the row, and its contribution is to the
+           nodes that lie to the left of it (upward edges) or to the right
+           of it (downward edges). Since these nodes form a contiguous run
+           at the start of the row, it is enough to find the end of the run
+           with a binary search. The winding numbers are then accumulated
+           along each row.
+         */
 
-           The polygon is defined by a vector of vertices. These must be ordered
-           and closed, i.e. there are n vertices with vertices[n] = vertices[0].
+        unsigned int rowSize = mesh.width + 2;
 
-           The test calculates the winding number of the point and returns false
-           only when it is zero.
+        // Change in winding number along each row.
+        std::vector<int> winding((mesh.height + 1) * rowSize, 0);
 
-           Adapted from: http://geomalgorithms.com/a03-_inclusion.html
-         */
+        // Loop through all edges.
+        for (unsigned int i=0;i+1<vertices.size();i++)
+        {
+            const Coord& v1 = vertices[i];
+            const Coord& v2 = vertices[i+1];
 
-        int windingNumber = 0;
+            // The edge crosses rows with y in [yMin, yMax).
+            double yMin = std::min(v1.y, v2.y);
+            double yMax = std::max(v1.y, v2.y);
 
-        // Loop through all vertices.
-        for (unsigned int i=0;i<vertices.size()-1;i++)
-        {
-            // Point lies above the vertex.
-            if (vertices[i].y <= point.y)
-            {
-                // Point lies below the next vertex.
-                if (vertices[i+1].y > point.y)
+            int rowBegin = std::max(0, int(std::ceil(yMin)));
+            int rowEnd = std::min(int(mesh.height), int(std::ceil(yMax)) - 1);
 
-                    // Point is to the left of the edge.
-                    if (isLeftOfLine(vertices[i], vertices[i+1], point) > 0)
-                        windingNumber++;
-            }
-            else
+            bool isUpward = (v2.y > v1.y);
+
+            for (int y=rowBegin;y<=rowEnd;y++)
             {
-                // Point lies above the vertex.
-                if (vertices[i+1].y <= point.y)
+                // Binary search for the first node in the row that the edge
+                // does not contribute to.
+                unsigned int lower = 0;
+                unsigned int upper = mesh.width + 1;
+
+                while (lower < upper)
+                {
+                    unsigned int x = (lower + upper) / 2;
+                    int left = isLeftOfLine(v1, v2, Coord(x, y));
+
+                    if ((isUpward && (left > 0)) || (!isUpward && (left < 0)))
+                        lower = x + 1;
+                    else
+                        upper = x;
+                }
 
-                    // Point lies to the right of the edge.
-                    if (isLeftOfLine(vertices[i], vertices[i+1], point) < 0)
-                        windingNumber--;
+                winding[y*rowSize] += (isUpward ? 1 : -1);
+                winding[y*rowSize + lower] -= (isUpward ? 1 : -1);
             }
         }
 
-        if (windingNumber == 0) return false;
-        else return true;
+        // Accumulate the winding number along each row.
+        isInside.resize(mesh.nNodes);
+
+        for (unsigned int y=0;y<=mesh.height;y++)
+        {
+            int windingNumber = 0;
+
+            for (unsigned int x=0;x<=mesh.width;x++)
+            {
+                windingNumber += winding[y*rowSize + x];
+                isInside[mesh.xyToIndex(x, y)] = (windingNumber != 0);
+            }
+        }
     }
 
     int LevelSet::isLeftOfLine(const Coord& vertex1, const Coord& vertex2, const Coord& point) const
@@ -1338,7 +2004,7 @@ namespace slsm
             - (point.x -  vertex1.x) * (vertex2.y - vertex1.y));
     }
 
-    double LevelSet::cutArea(const Element& element, const Boundary& boundary) const
+    double LevelSet::cutArea(const unsigned int element, const Boundary& boundary) const
     {
         // Number of polygon vertices.
         unsigned int nVertices = 0;
@@ -1349,45 +2015,45 @@ namespace slsm
         // Whether we're searching for nodes that are inside or outside the boundary.
         NodeStatus::NodeStatus status;
 
-        if (element.status & ElementStatus::CENTRE_OUTSIDE) status = NodeStatus::OUTSIDE;
+        if (mesh.elementStatus[element] & ElementStatus::CENTRE_OUTSIDE) status = NodeStatus::OUTSIDE;
         else status = NodeStatus::INSIDE;
 
         // Check all nodes of the element.
         for (unsigned int i=0;i<4;i++)
         {
             // Node index;
-            unsigned int node = element.nodes[i];
+            unsigned int node = mesh.elementNode(element, i);
 
             // Node matches status.
-            if (mesh.nodes[node].status & status)
+            if (mesh.nodeStatus[node] & status)
             {
                 // Add coordinates to vertex array.
-                vertices[nVertices].x = mesh.nodes[node].coord.x;
-                vertices[nVertices].y = mesh.nodes[node].coord.y;
+                vertices[nVertices].x = mesh.nodeCoord(node).x;
+                vertices[nVertices].y = mesh.nodeCoord(node).y;
 
                 // Increment number of vertices.
                 nVertices++;
             }
 
             // Node is on the boundary.
-            else if (mesh.nodes[node].status & NodeStatus::BOUNDARY)
+            else if (mesh.nodeStatus[node] & NodeStatus::BOUNDARY)
             {
                 // Next node.
                 unsigned int n1 = (i == 3) ? 0 : (i + 1);
-                n1 = element.nodes[n1];
+                n1 = mesh.elementNode(element, n1);
 
                 // Previous node.
                 unsigned int n2 = (i == 0) ? 3 : (i - 1);
-                n2 = element.nodes[n2];
+                n2 = mesh.elementNode(element, n2);
 
                 // Check that node isn't part of a boundary segment, i.e. both of its
                 // neighbours are inside the structure.
-                if ((mesh.nodes[n1].status & NodeStatus::INSIDE) &&
-                    (mesh.nodes[n2].status & NodeStatus::INSIDE))
+                if ((mesh.nodeStatus[n1] & NodeStatus::INSIDE) &&
+                    (mesh.nodeStatus[n2] & NodeStatus::INSIDE))
                 {
                     // Add coordinates to vertex array.
-                    vertices[nVertices].x = mesh.nodes[node].coord.x;
-                    vertices[nVertices].y = mesh.nodes[node].coord.y;
+                    vertices[nVertices].x = mesh.nodeCoord(node).x;
+                    vertices[nVertices].y = mesh.nodeCoord(node).y;
 
                     // Increment number of vertices.
                     nVertices++;
@@ -1396,10 +2062,10 @@ namespace slsm
         }
 
         // Add boundary segment start and end points.
-        for (unsigned int i=0;i<element.nBoundarySegments;i++)
+        for (unsigned int i=0;i<mesh.nBoundarySegments[element];i++)
         {
             // Segment index.
-            unsigned int segment = element.boundarySegments[i];
+            unsigned int segment = mesh.boundarySegments[2*element + i];
 
             // Add start point coordinates to vertices array.
             vertices[nVertices].x = boundary.points[boundary.segments[segment].start].coord.x;
@@ -1417,10 +2083,10 @@ namespace slsm
         }
 
         // Return area of the polygon.
-        if (element.status & ElementStatus::CENTRE_OUTSIDE)
-            return (1.0 - polygonArea(vertices, nVertices, element.coord));
+        if (mesh.elementStatus[element] & ElementStatus::CENTRE_OUTSIDE)
+            return (1.0 - polygonArea(vertices, nVertices, mesh.elementCoord(element)));
         else
-            return polygonArea(vertices, nVertices, element.coord);
+            return polygonArea(vertices, nVertices, mesh.elementCoord(element));
     }
 
     bool LevelSet::isClockwise(const Coord& point1, const Coord& point2, const Coord& centre) const
@@ -18,7 +18,14 @@
 #ifndef _LEVELSET_H
 #define _LEVELSET_H
 
+#include <memory>
+
+#include "Boundary.h"
+#include "ClosestPointTransform.h"
 #include "Common.h"
+#include "FastIterativeMethod.h"
+#include "FastMarchingMethod.h"
+#include "FastSweepingMethod.h"
 #include "Mesh.h"
 
 /*! \file LevelSet.h
@@ -29,11 +36,23 @@ namespace slsm
 {
     // FORWARD DECLARATIONS
 
-    class  Boundary;
-    struct BoundaryPoint;
     class  Hole;
     class  MersenneTwister;
 
+    // ASSOCIATED DATA TYPES
+
+    //! The method used to solve the Eikonal equation for reinitialisation and velocity extension.
+    namespace EikonalSolver
+    {
+        enum EikonalSolver
+        {
+            FAST_MARCHING  = 0, //!< Fast Marching Method (sequential).
+            FAST_SWEEPING  = 1, //!< Fast Sweeping Method (parallel reinitialisation, first order).
+            FAST_ITERATIVE = 2, //!< Fast Iterative Method (parallel reinitialisation and velocity extension, first order).
+            CLOSEST_POINT  = 3, //!< Closest Point Transform (parallel reinitialisation, exact distance to the boundary).
+        };
+    }
+
     /*! \brief A class for the level set function.
 
         The level set is represented as a signed distance function from the zero
@@ -55,6 +74,25 @@ namespace slsm
         Functionality is also provided for tracking nodes that are part of the
         narrow band region around the zero contour, as well as mine nodes at
         the edge of the narrow band.
+
+        The mesh blocks (see Mesh) that intersect the narrow band, along with a
+        halo of one block, are tracked in the activeBlocks array. For large domains
+        in which the structure occupies a small fraction of the area, setting
+        isSparse to true restricts the per-iteration update of the mesh status,
+        boundary discretisation, and area fraction calculation to these blocks.
+        The far field is assumed to be unchanged between narrow band
+        reinitialisations, so in this mode the signed distance function outside
+        of the narrow band should only be modified via LevelSet methods. Only
+        these passes are restricted: all per-node and per-element arrays are
+        allocated for the full mesh, and velocity initialisation and
+        reinitialisation still visit every node.
+
+        When isReplay is set, fast marching reinitialisation records the upwind
+        dependencies of the nodes in the new narrow band. If the signed distance
+        function hasn't changed by the time that velocities are next extended,
+        the recording is replayed as a linear pass, rather than marching again.
+        As for isSparse, the signed distance function should then only be
+        modified via LevelSet methods.
      */
     class LevelSet
     {
@@ -74,9 +112,16 @@ namespace slsm
 
             \param isFixedDomain_
                 Whether the domain boundary is fixed.
+
+            \param isImplicitMesh_
+                Whether to compute the mesh topology on the fly (saves memory).
+
+            \param nodeOrdering_
+                The numbering scheme for the mesh nodes.
          */
         LevelSet(unsigned int, unsigned int, double moveLimit_ = 0.5,
-            unsigned int bandWidth_ = 6, bool isFixedDomain_ = false);
+            unsigned int bandWidth_ = 6, bool isFixedDomain_ = false,
+            bool isImplicitMesh_ = false, NodeOrdering::NodeOrdering nodeOrdering_ = NodeOrdering::ROW_MAJOR);
 
         //! Constructor.
         /*! \param width
@@ -96,9 +141,16 @@ namespace slsm
 
             \param isFixedDomain_
                 Whether the domain boundary is fixed.
+
+            \param isImplicitMesh_
+                Whether to compute the mesh topology on the fly (saves memory).
+
+            \param nodeOrdering_
+                The numbering scheme for the mesh nodes.
          */
         LevelSet(unsigned int, unsigned int, const std::vector<Hole>&, double moveLimit_ = 0.5,
-            unsigned int bandWidth_ = 6, bool isFixedDomain_ = false);
+            unsigned int bandWidth_ = 6, bool isFixedDomain_ = false,
+            bool isImplicitMesh_ = false, NodeOrdering::NodeOrdering nodeOrdering_ = NodeOrdering::ROW_MAJOR);
 
         //! Constructor.
         /*! \param width
@@ -118,9 +170,16 @@ namespace slsm
 
             \param isFixedDomain_
                 Whether the domain boundary is fixed.
+
+            \param isImplicitMesh_
+                Whether to compute the mesh topology on the fly (saves memory).
+
+            \param nodeOrdering_
+                The numbering scheme for the mesh nodes.
          */
         LevelSet(unsigned int, unsigned int, const std::vector<Coord>&, double moveLimit_ = 0.5,
-            unsigned int bandWidth_ = 6, bool isFixedDomain_ = false);
+            unsigned int bandWidth_ = 6, bool isFixedDomain_ = false,
+            bool isImplicitMesh_ = false, NodeOrdering::NodeOrdering nodeOrdering_ = NodeOrdering::ROW_MAJOR);
 
         //! Constructor.
         /*! \param width
@@ -143,9 +202,16 @@ namespace slsm
 
             \param isFixedDomain_
                 Whether the domain boundary is fixed.
+
+            \param isImplicitMesh_
+                Whether to compute the mesh topology on the fly (saves memory).
+
+            \param nodeOrdering_
+                The numbering scheme for the mesh nodes.
          */
         LevelSet(unsigned int, unsigned int, const std::vector<Hole>&, const std::vector<Hole>&,
-            double moveLimit_ = 0.5, unsigned int bandWidth_ = 6, bool isFixedDomain_ = false);
+            double moveLimit_ = 0.5, unsigned int bandWidth_ = 6, bool isFixedDomain_ = false,
+            bool isImplicitMesh_ = false, NodeOrdering::NodeOrdering nodeOrdering_ = NodeOrdering::ROW_MAJOR);
 
         //! Constructor.
         /*! \param width
@@ -168,9 +234,16 @@ namespace slsm
 
             \param isFixedDomain_
                 Whether the domain boundary is fixed.
+
+            \param isImplicitMesh_
+                Whether to compute the mesh topology on the fly (saves memory).
+
+            \param nodeOrdering_
+                The numbering scheme for the mesh nodes.
          */
         LevelSet(unsigned int, unsigned int, const std::vector<Hole>&, const std::vector<Coord>&,
-            double moveLimit_ = 0.5, unsigned int bandWidth_ = 6, bool isFixedDomain_ = false);
+            double moveLimit_ = 0.5, unsigned int bandWidth_ = 6, bool isFixedDomain_ = false,
+            bool isImplicitMesh_ = false, NodeOrdering::NodeOrdering nodeOrdering_ = NodeOrdering::ROW_MAJOR);
 
         //! Constructor.
         /*! \param width
@@ -193,9 +266,16 @@ namespace slsm
 
             \param isFixedDomain_
                 Whether the domain boundary is fixed.
+
+            \param isImplicitMesh_
+                Whether to compute the mesh topology on the fly (saves memory).
+
+            \param nodeOrdering_
+                The numbering scheme for the mesh nodes.
          */
         LevelSet(unsigned int, unsigned int, const std::vector<Coord>&, const std::vector<Coord>&,
-            double moveLimit_ = 0.5, unsigned int bandWidth_ = 6, bool isFixedDomain_ = false);
+            double moveLimit_ = 0.5, unsigned int bandWidth_ = 6, bool isFixedDomain_ = false,
+            bool isImplicitMesh_ = false, NodeOrdering::NodeOrdering nodeOrdering_ = NodeOrdering::ROW_MAJOR);
 
         //! Update the level set function.
         /*! \param timeStep
@@ -219,13 +299,34 @@ namespace slsm
         void mask(const std::vector<Coord>&);
 
         //! Reinitialise the level set to a signed distance function.
+        /*! The Eikonal equation is solved using the method set by eikonalSolver.
+         */
         void reinitialise();
 
+        //! Reinitialise the level set to the signed distance from a discretised boundary.
+        /*! The distance is found using the closest point transform, up to the
+            narrow band plus the three nodes beyond it that are reached by the
+            gradient stencil. Nodes further away are set to the signed cut-off
+            distance.
+
+            \param boundary
+                A reference to the boundary, discretised from the current
+                signed distance function.
+         */
+        void reinitialise(const Boundary&);
+
         //! Extend boundary point velocities to the level set nodes.
         /*! \param boundaryPoints
                 A reference to a vector of boundary points.
+
+            \param isReinitialise
+                Whether to reinitialise the signed distance function in the same
+                fast marching pass. Velocities are then extended to all nodes.
+                With any other eikonalSolver, the signed distance function is
+                reinitialised first and velocities are extended over the new
+                narrow band.
          */
-        void computeVelocities(const std::vector<BoundaryPoint>&);
+        void computeVelocities(const std::vector<BoundaryPoint>&, bool isReinitialise = false);
 
         //! Extend boundary point velocities to the level set nodes.
         /*! \param boundaryPoints
@@ -240,10 +341,18 @@ namespace slsm
             \param rng
                 A reference to the random number generator.
 
+            \param isReinitialise
+                Whether to reinitialise the signed distance function in the same
+                fast marching pass. Velocities are then extended to all nodes.
+                With any other eikonalSolver, the signed distance function is
+                reinitialised first and velocities are extended over the new
+                narrow band.
+
             \return
                 The time step scaling factor.
          */
-        double computeVelocities(std::vector<BoundaryPoint>&, double&, const double, MersenneTwister&);
+        double computeVelocities(std::vector<BoundaryPoint>&, double&, const double, MersenneTwister&,
+            bool isReinitialise = false);
 
 #ifdef PYBIND
         //! Extend boundary point velocities to the level set nodes.
@@ -259,10 +368,18 @@ namespace slsm
             \param rng
                 A reference to the random number generator.
 
+            \param isReinitialise
+                Whether to reinitialise the signed distance function in the same
+                fast marching pass. Velocities are then extended to all nodes.
+                With any other eikonalSolver, the signed distance function is
+                reinitialised first and velocities are extended over the new
+                narrow band.
+
             \return
                 The time step scaling factor.
          */
-        double computeVelocities(std::vector<BoundaryPoint>&, MutableFloat&, const double, MersenneTwister&);
+        double computeVelocities(std::vector<BoundaryPoint>&, MutableFloat&, const double, MersenneTwister&,
+            bool isReinitialise = false);
 #endif
 
         //! Compute the modulus of the gradient of the signed distance function.
@@ -277,23 +394,207 @@ namespace slsm
          */
         double computeAreaFractions(const Boundary&);
 
+        //! Compute Hamilton-Jacobi WENO gradient approximation.
+        /*! \param v1
+                The value of the function at the first stencil point.
+
+            \param v2
+                The value of the function at the second stencil point.
+
+            \param v3
+                The value of the function at the third stencil point.
+
+            \param v4
+                The value of the function at the fourth stencil point.
+
+            \param v5
+                The value of the function at the fifth stencil point.
+
+            \return
+                The smoothed function (gradient).
+         */
+        static double gradHJWENO(double, double, double, double, double);
+
+        //! Compute Hamilton-Jacobi WENO gradient approximations for an array of stencils.
+        /*! The stencils are stored in structure-of-arrays form and the approximations
+            are evaluated using SIMD instructions, where available. The results agree
+            with those of the scalar function to within floating point rounding.
+
+            \param v1
+                The value of the function at the first stencil point for each stencil.
+
+            \param v2
+                The value of the function at the second stencil point for each stencil.
+
+            \param v3
+                The value of the function at the third stencil point for each stencil.
+
+            \param v4
+                The value of the function at the fourth stencil point for each stencil.
+
+            \param v5
+                The value of the function at the fifth stencil point for each stencil.
+
+            \param grad
+                The smoothed function (gradient) for each stencil (filled by function).
+
+            \param n
+                The number of stencils.
+         */
+        static void gradHJWENO(const double*, const double*, const double*,
+            const double*, const double*, double*, unsigned int);
+
         std::vector<double> signedDistance;     //!< The nodal signed distance function (level set).
         std::vector<double> velocity;           //!< The nodal normal velocity.
         std::vector<double> gradient;           //!< The nodal gradient of the level set function (modulus).
         std::vector<double> target;             //!< Signed distance target (for shape matching).
         std::vector<unsigned int> narrowBand;   //!< Indices of nodes in the narrow band.
         std::vector<unsigned int> mines;        //!< Indices of nodes at the edge of the narrow band.
-        unsigned int nNarrowBand;               //!< The number of nodes in narrow band.
-        unsigned int nMines;                    //!< The number of mine nodes.
+        unsigned int nNarrowBand = 0;           //!< The number of nodes in narrow band.
+        unsigned int nMines = 0;                //!< The number of mine nodes.
         const double moveLimit;                 //!< The boundary movement limit (CFL condition).
 
         double area;                            //!< The total mesh area fraction enclosed by the boundary.
         Mesh mesh;                              //!< The fixed-grid mesh.
 
+        std::vector<unsigned int> activeBlocks; //!< Indices of mesh blocks intersecting the narrow band.
+        unsigned int nActiveBlocks;             //!< The number of active blocks.
+        bool isSparse = false;                  //!< Whether to restrict updates to the active blocks.
+        EikonalSolver::EikonalSolver eikonalSolver = EikonalSolver::FAST_MARCHING;  //!< The Eikonal solver.
+        bool isBandLimited = false;             //!< Whether fast marching reinitialisation stops beyond the narrow band.
+        bool isReplay = false;                  //!< Whether to replay the reinitialising march for velocity extension.
+
     private:
         unsigned int bandWidth;                 //!< The width of the narrow band region.
         bool isFixedDomain;                     //!< Whether the domain boundary is fixed.
 
+        static const unsigned int gradientBatch = 64;   //!< The number of nodes per batch for the vectorised gradient kernel.
+
+        std::vector<bool> isActiveBlock;        //!< Whether each mesh block is active.
+        std::vector<unsigned int> maskedBlocks; //!< Indices of mesh blocks containing masked nodes.
+        std::vector<unsigned int> activeElements; //!< Indices of elements in active blocks (row-major order).
+        std::vector<unsigned int> maskedElements; //!< Indices of elements with a masked node (ascending order).
+        std::vector<unsigned int> bandElements; //!< Indices of elements with a narrow band, or masked, node (ascending order).
+        bool isFarFieldCurrent = false;         //!< Whether the mesh status outside the active blocks is current.
+        bool isFarFieldAreaCurrent = false;     //!< Whether the far field area is current.
+        double farFieldArea;                    //!< The area fraction of elements outside the active blocks.
+
+        std::vector<unsigned int> tileBand;     //!< Indices of narrow band nodes, grouped by mesh tile (interior nodes first).
+        std::vector<unsigned int> tileBandOffset;   //!< The offset of the first node of each tile in tileBand.
+        std::vector<unsigned int> tileBandEdge;     //!< The offset of the first edge node of each tile in tileBand.
+        unsigned int tileBandWidth = 0;         //!< The tile width used to group the narrow band.
+        unsigned int tileBandHeight = 0;        //!< The tile height used to group the narrow band.
+
+        //! Scratch space for temporaries, reused between calls.
+        /*! Arrays are resized as needed and keep their capacity, so once the
+            problem size has settled no memory is allocated. The per-node
+            arrays are kept zeroed between calls, with only the entries that
+            were used being reset. The workspace isn't copied along with the
+            level set, since the copy allocates its own on first use.
+         */
+        struct Workspace
+        {
+            Workspace() = default;
+            Workspace(const Workspace&) {}
+            Workspace& operator=(const Workspace&) { return *this; }
+
+            /// Velocity interpolation weight of each node.
+            std::vector<double> weight;
+
+            /// Whether the velocity at each node has been set exactly (char, so tiles can write concurrently).
+            std::vector<char> isSet;
+
+            /// The node closest to each boundary point.
+            std::vector<unsigned int> closestNode;
+
+            /// The tiles that each boundary point contributes to (stride 5).
+            std::vector<unsigned int> pointTiles;
+
+            /// The number of tiles that each boundary point contributes to.
+            std::vector<unsigned int> nPointTiles;
+
+            /// The offset of the first boundary point of each tile in tilePoints.
+            std::vector<unsigned int> tilePointOffset;
+
+            /// Indices of boundary points, grouped by tile.
+            std::vector<unsigned int> tilePoints;
+
+            /// The tile that owns each narrow band node.
+            std::vector<unsigned int> bandTile;
+
+            /// Whether each narrow band node is an interior node.
+            std::vector<bool> isInterior;
+
+            /// Whether each element has been added to the band elements (char, kept zeroed).
+            std::vector<char> isBandElement;
+
+            /// Insertion offsets used when grouping data by tile.
+            std::vector<unsigned int> next;
+
+            /// Insertion offsets used when grouping edge nodes by tile.
+            std::vector<unsigned int> nextEdge;
+
+            /// Nodes in the narrow band following reinitialisation.
+            std::vector<unsigned int> band;
+
+            /// Whether the fast marching recording matches the signed distance function.
+            bool isReplayCurrent = false;
+
+            /// The fast marching method object (bound to the mesh of this level set).
+            std::unique_ptr<FastMarchingMethod> fmm;
+
+            /// The fast sweeping method object (bound to the mesh of this level set).
+            std::unique_ptr<FastSweepingMethod> fsm;
+
+            /// The fast iterative method object (bound to the mesh of this level set).
+            std::unique_ptr<FastIterativeMethod> fim;
+
+            /// The closest point transform object (bound to the mesh of this level set).
+            std::unique_ptr<ClosestPointTransform> cpt;
+
+            /// The discretised boundary used by the closest point transform.
+            Boundary boundary;
+        };
+
+        Workspace workspace;                    //!< Scratch space for temporaries.
+
+        friend class Boundary;
+
+        //! Return the fast marching method object, creating it on first use.
+        /*! \return
+                A reference to the fast marching method object.
+         */
+        FastMarchingMethod& fastMarchingMethod();
+
+        //! Return the fast sweeping method object, creating it on first use.
+        /*! \return
+                A reference to the fast sweeping method object.
+         */
+        FastSweepingMethod& fastSweepingMethod();
+
+        //! Return the fast iterative method object, creating it on first use.
+        /*! \return
+                A reference to the fast iterative method object.
+         */
+        FastIterativeMethod& fastIterativeMethod();
+
+        //! Return the closest point transform object, creating it on first use.
+        /*! \return
+                A reference to the closest point transform object.
+         */
+        ClosestPointTransform& closestPointTransform();
+
+        //! Return the distance from the zero contour at which fast marching
+        //! reinitialisation stops.
+        /*! When band limited, the march covers the narrow band plus the three
+            nodes beyond it that are reached by the gradient stencil. Nodes
+            further away are set to the signed cut-off distance.
+
+            \return
+                The cut-off distance.
+         */
+        double reinitialiseCutOff() const;
+
         //! Default initialisation of the level set function (Swiss cheese configuration).
         void initialise();
 
@@ -313,44 +614,142 @@ namespace slsm
         //! Initialises the level set function as the distance to the closest domain boundary.
         void closestDomainBoundary();
 
-        //! Initialise the narrow band region.
+        //! Initialise the narrow band region, searching the whole mesh.
         void initialiseNarrowBand();
 
+        //! Update the narrow band region from a set of candidate nodes.
+        /*! The current narrow band and mine flags are cleared, then the
+            candidates are added. The cost scales with the size of the band,
+            rather than the area of the domain. If there are many candidates
+            the whole mesh is searched instead.
+
+            \param nodes
+                Indices of the nodes that may lie in the new narrow band. These
+                are sorted so that the band is stored in index order.
+         */
+        void updateNarrowBand(std::vector<unsigned int>&);
+
+        //! Add a node to the narrow band, and mines, if it lies within them.
+        /*! \param node
+                The index of the node.
+         */
+        void addNarrowBandNode(unsigned int);
+
+        //! Find the mesh blocks and elements containing masked nodes.
+        void initialiseMaskedBlocks();
+
+        //! Initialise the active blocks from those flagged as containing narrow band nodes.
+        void initialiseActiveBlocks();
+
+        //! Find the elements with a node in the narrow band, or a masked node.
+        //! Only these elements can be cut by the zero contour.
+        void initialiseBandElements();
+
+        //! Group the narrow band nodes by the mesh tile that owns them.
+        void initialiseTileBand();
+
+        //! Map the velocity of a boundary point to the nodes owned by a tile.
+        /*! \param point
+                A reference to the boundary point.
+
+            \param node
+                The index of the node closest to the boundary point.
+
+            \param tile
+                A reference to the tile.
+
+            \param isSet
+                Whether the velocity at each node has been set.
+
+            \param weight
+                The weighting factor for each node.
+         */
+        void mapVelocity(const BoundaryPoint&, unsigned int, const Tile&, char*, double*);
+
         //! Initialise velocities for boundary nodes.
         /*! \param boundaryPoints
                 A reference to a vector of boundary points.
          */
         void initialiseVelocities(const std::vector<BoundaryPoint>&);
 
-        //! Compute the modulus of the gradient of the signed distance function at a node.
-        /*! \param node
-                The node index.
+        //! Compute the gradient at a corner node using the diagonal neighbour.
+        /*! This is used when the signed distance at the two neighbouring
+            nodes matches that of the corner node.
+
+            \param x
+                The x coordinate of the node.
+
+            \param y
+                The y coordinate of the node.
+
+            \param grad
+                The gradient at the node (filled by function).
 
             \return
-                The gradient at the node.
+                Whether the gradient was computed.
          */
-        double computeGradient(const unsigned int) const;
+        bool cornerGradient(const unsigned int, const unsigned int, double&) const;
 
-        //! Compute Hamilton-Jacobi WENO gradient approximation.
-        /*! \param v1
-                The value of the function at the first stencil point.
+        //! Gather the WENO stencil values for an interior node.
+        /*! Values are stored for the right, left, up, and down directions in
+            turn, with five stencil points per direction.
 
-            \param v2
-                The value of the function at the second stencil point.
+            \param x
+                The x coordinate of the node.
 
-            \param v3
-                The value of the function at the third stencil point.
+            \param y
+                The y coordinate of the node.
 
-            \param v4
-                The value of the function at the fourth stencil point.
+            \param v
+                The stencil values (filled by function).
 
-            \param v5
-                The value of the function at the fifth stencil point.
+            \param stride
+                The stride between consecutive stencil values.
+         */
+        void interiorStencils(const unsigned int, const unsigned int, double*, const unsigned int) const;
+
+        //! Gather the WENO stencil values for an edge node.
+        /*! Values are stored for the right, left, up, and down directions in
+            turn, with five stencil points per direction, using the precomputed
+            one-sided stencil of the node.
+
+            \param x
+                The x coordinate of the node.
+
+            \param y
+                The y coordinate of the node.
+
+            \param v
+                The stencil values (filled by function).
+
+            \param stride
+                The stride between consecutive stencil values.
+         */
+        void edgeStencils(const unsigned int, const unsigned int, double*, const unsigned int) const;
+
+        //! Compute the gradients for a batch of nodes from their WENO stencils.
+        /*! \param nodes
+                The indices of the nodes.
+
+            \param n
+                The number of nodes.
+
+            \param v
+                The stencil values for each direction and stencil point.
+         */
+        void batchGradients(const unsigned int*, const unsigned int, double (*)[gradientBatch]);
+
+        //! Compute the upwind gradient at a node from the WENO approximations.
+        /*! \param node
+                The node index.
+
+            \param weno
+                The WENO approximations for the right, left, up, and down directions.
 
             \return
-                The smoothed function (gradient).
+                The gradient at the node.
          */
-        double gradHJWENO(double, double, double, double, double) const;
+        double upwindGradient(const unsigned int, const double*) const;
 
         //! Compute the minimum distance between a point and a line segment.
         /*! \param vertex1
@@ -367,17 +766,14 @@ namespace slsm
          */
         double pointToLineDistance(const Coord&, const Coord&, const Coord&) const;
 
-        //! Test if a point lies inside a polygon.
-        /*! \param point
-                The coordinates of the point.
-
-            \param vertices
+        //! Find the nodes that lie inside a polygon.
+        /*! \param vertices
                 The vertices of the polygon (closed and ordered).
 
-            \return
-                Whether the point lies inside the polygon.
+            \param isInside
+                Whether each node lies inside the polygon (output).
          */
-        bool isInsidePolygon(const Coord&, const std::vector<Coord>&) const;
+        void insidePolygon(const std::vector<Coord>&, std::vector<char>&) const;
 
         //! Test if a point lies left, on, or right of an infinite line.
         /*! \param vertex1
@@ -398,7 +794,7 @@ namespace slsm
 
         //! Calculate the material area for an element cut by the boundary.
         /*! \param element
-                A reference to the element.
+                The element index.
 
             \param boundary
                 A reference to the discretised boundary.
@@ -406,7 +802,7 @@ namespace slsm
             \return
                 The area fraction.
          */
-        double cutArea(const Element&, const Boundary&) const;
+        double cutArea(const unsigned int, const Boundary&) const;
 
         //! Whether a point is clockwise of another. The origin point is 12 o'clock.
         /*! \param point1
@@ -15,8 +15,13 @@
   along with this program. If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
 #include <cmath>
+#include <map>
+#include <mutex>
+#include <tuple>
 
+#include "Debug.h"
 #include "Mesh.h"
 #include "MersenneTwister.h"
 
@@ -28,75 +33,160 @@ namespace slsm
 {
     Element::Element() :
         area(0),
-        nodes(4, 0),
-        boundarySegments(2, 0)
+        nodes{0, 0, 0, 0},
+        boundarySegments{0, 0},
+        nBoundarySegments(0),
+        status(ElementStatus::NONE)
     {
     }
 
     Node::Node() :
-        neighbours(4, 0),
-        elements(4, 0),
-        boundaryPoints(4, 0),
+        neighbours{0, 0, 0, 0},
+        elements{0, 0, 0, 0},
         nElements(0),
+        boundaryPoints{0, 0, 0, 0},
+        nBoundaryPoints(0),
         isActive(false),
         isDomain(false),
         isMasked(false),
-        isMine(false)
+        isMine(false),
+        status(NodeStatus::NONE)
     {
     }
 
-    Mesh::Mesh(unsigned int width_,
-               unsigned int height_) :
+    Node Mesh::NodeArray::operator[](unsigned int node) const
+    {
+        Node n;
+
+        n.coord = mesh->nodeCoord(node);
+        n.nElements = mesh->nNodeElements(node);
+        n.nBoundaryPoints = mesh->nBoundaryPoints[node];
+        n.isActive = mesh->isActive[node];
+        n.isDomain = mesh->isDomain(node);
+        n.isMasked = mesh->isMasked[node];
+        n.isMine = mesh->isMine[node];
+        n.status = mesh->nodeStatus[node];
+
+        for (unsigned int i=0;i<4;i++)
+        {
+            n.neighbours[i] = mesh->neighbour(node, i);
+            n.elements[i] = mesh->nodeElement(node, i);
+            n.boundaryPoints[i] = mesh->boundaryPoints[4*node + i];
+        }
 
-               width(width_),
-               height(height_),
-               nElements(width*height),
-               nNodes((1+width)*(1+height))
+        return n;
+    }
+
+    unsigned int Mesh::NodeArray::size() const
+    {
+        return mesh->nNodes;
+    }
+
+    Element Mesh::ElementArray::operator[](unsigned int element) const
     {
-        // Resize element and node data structures.
-        elements.resize(nElements);
-        nodes.resize(nNodes);
+        Element e;
 
-        // Resize 2D to 1D mapping vector.
-        xyToIndex.resize(width+1);
-        for (unsigned int i=0;i<width+1;i++)
-            xyToIndex[i].resize(height+1);
+        e.coord = mesh->elementCoord(element);
+        e.area = mesh->area[element];
+        e.nBoundarySegments = mesh->nBoundarySegments[element];
+        e.status = mesh->elementStatus[element];
 
-        // Calculate node nearest neighbours.
-        initialiseNodes();
+        for (unsigned int i=0;i<4;i++)
+            e.nodes[i] = mesh->elementNode(element, i);
 
-        // Initialise elements (and node to element connectivity).
-        initialiseElements();
+        for (unsigned int i=0;i<2;i++)
+            e.boundarySegments[i] = mesh->boundarySegments[2*element + i];
+
+        return e;
     }
 
-    unsigned int Mesh::getClosestNode(const Coord& point) const
+    unsigned int Mesh::ElementArray::size() const
     {
-        // Get element index.
-        unsigned int element = getElement(point);
+        return mesh->nElements;
+    }
 
-        // Work out distance relative to element centre.
-        double dx = point.x - elements[element].coord.x;
-        double dy = point.y - elements[element].coord.y;
+    const unsigned int Mesh::tileSize;
 
-        // Point lies in left half.
-        if (dx < 0)
-        {
-            // Lower left quadrant.
-            if (dy < 0) return elements[element].nodes[0];
+    Mesh::Mesh(unsigned int width_,
+               unsigned int height_,
+               bool isImplicit_,
+               NodeOrdering::NodeOrdering nodeOrdering_) :
 
-            // Upper left quadrant.
-            else return elements[element].nodes[3];
-        }
+               width(width_),
+               height(height_),
+               nElements(width*height),
+               nNodes((1+width)*(1+height)),
+               isImplicit(isImplicit_),
+               nodeOrdering(nodeOrdering_),
+               nBlocksX((width + tileSize) / tileSize),
+               nBlocksY((height + tileSize) / tileSize),
+               nBlocks(nBlocksX*nBlocksY),
+               nodes(*this),
+               elements(*this)
+    {
+        // Resize node state arrays.
+        nodeStatus.resize(nNodes, NodeStatus::NONE);
+        isActive.resize(nNodes, false);
+        isMasked.resize(nNodes, false);
+        isMine.resize(nNodes, false);
+        boundaryPoints.resize(4*nNodes, 0);
+        nBoundaryPoints.resize(nNodes, 0);
+
+        // Resize element state arrays.
+        elementStatus.resize(nElements, ElementStatus::NONE);
+        area.resize(nElements, 0);
+        boundarySegments.resize(2*nElements, 0);
+        nBoundarySegments.resize(nElements, 0);
+
+        // Find or create the topology.
+        initialiseTopology();
+
+        // Default domain decomposition.
+        initialiseTiles(64, 64);
+    }
 
-        // Point lies in right half.
-        else
-        {
-            // Lower right quadrant.
-            if (dy < 0) return elements[element].nodes[1];
+    Mesh::Mesh(const Mesh& mesh) :
+        width(mesh.width),
+        height(mesh.height),
+        nElements(mesh.nElements),
+        nNodes(mesh.nNodes),
+        isImplicit(mesh.isImplicit),
+        nodeOrdering(mesh.nodeOrdering),
+        nBlocksX(mesh.nBlocksX),
+        nBlocksY(mesh.nBlocksY),
+        nBlocks(mesh.nBlocks),
+        tiles(mesh.tiles),
+        nTiles(mesh.nTiles),
+        nTilesX(mesh.nTilesX),
+        nTilesY(mesh.nTilesY),
+        tileWidth(mesh.tileWidth),
+        tileHeight(mesh.tileHeight),
+        haloWidth(mesh.haloWidth),
+        nodes(*this),
+        elements(*this),
+        nodeStatus(mesh.nodeStatus),
+        isActive(mesh.isActive),
+        isMasked(mesh.isMasked),
+        isMine(mesh.isMine),
+        boundaryPoints(mesh.boundaryPoints),
+        nBoundaryPoints(mesh.nBoundaryPoints),
+        elementStatus(mesh.elementStatus),
+        area(mesh.area),
+        boundarySegments(mesh.boundarySegments),
+        nBoundarySegments(mesh.nBoundarySegments),
+        topology(mesh.topology)
+    {
+        setTopology(*topology);
+    }
 
-            // Upper right quadrant.
-            else return elements[element].nodes[2];
-        }
+    bool Mesh::sharesTopology(const Mesh& mesh) const
+    {
+        return (topology == mesh.topology);
+    }
+
+    unsigned int Mesh::getClosestNode(const Coord& point) const
+    {
+        return getClosestNode(point.x, point.y);
     }
 
     unsigned int Mesh::getClosestNode(double x, double y) const
@@ -105,46 +195,33 @@ namespace slsm
         unsigned int element = getElement(x, y);
 
         // Work out distance relative to element centre.
-        double dx = x - elements[element].coord.x;
-        double dy = y - elements[element].coord.y;
+        double dx = x - elementCoord(element).x;
+        double dy = y - elementCoord(element).y;
 
         // Point lies in left half.
         if (dx < 0)
         {
             // Lower left quadrant.
-            if (dy < 0) return elements[element].nodes[0];
+            if (dy < 0) return elementNode(element, 0);
 
             // Upper left quadrant.
-            else return elements[element].nodes[3];
+            else return elementNode(element, 3);
         }
 
         // Point lies in right half.
         else
         {
             // Lower right quadrant.
-            if (dy < 0) return elements[element].nodes[1];
+            if (dy < 0) return elementNode(element, 1);
 
             // Upper right quadrant.
-            else return elements[element].nodes[2];
+            else return elementNode(element, 2);
         }
     }
 
     unsigned int Mesh::getElement(const Coord& point) const
     {
-        // Subtract a small value to ensure that we round down.
-        double x = point.x - 1e-6;
-        double y = point.y - 1e-6;
-
-        // Enforce lower bound.
-        if (x < 0) x = 0;
-        if (y < 0) y = 0;
-
-        // Work out x and y element indices (cells are unit width).
-        unsigned int elementX = std::floor(x);
-        unsigned int elementY = std::floor(y);
-
-        // Return global element index.
-        return (elementY*width + elementX);
+        return getElement(point.x, point.y);
     }
 
     unsigned int Mesh::getElement(double x, double y) const
@@ -165,54 +242,179 @@ namespace slsm
         return (elementY*width + elementX);
     }
 
-    void Mesh::initialiseNodes()
+    void Mesh::initialiseTiles(unsigned int tileWidth_, unsigned int tileHeight_, unsigned int haloWidth_)
     {
-        // Coordinates of the node.
-        unsigned int x, y;
+        errno = EINVAL;
+        slsm_check(((tileWidth_ > 0) && (tileHeight_ > 0)), "Tile dimensions must be positive.");
 
-        // Loop over all nodes.
-        for (unsigned int i=0;i<nNodes;i++)
+        tileWidth = tileWidth_;
+        tileHeight = tileHeight_;
+        haloWidth = haloWidth_;
+
+        // Number of tiles in each direction (the last row and column may be truncated).
+        nTilesX = (width + tileWidth) / tileWidth;
+        nTilesY = (height + tileHeight) / tileHeight;
+        nTiles = nTilesX*nTilesY;
+
+        tiles.resize(nTiles);
+
+        for (unsigned int i=0;i<nTiles;i++)
+        {
+            Tile& tile = tiles[i];
+
+            tile.xMin = (i % nTilesX) * tileWidth;
+            tile.yMin = (i / nTilesX) * tileHeight;
+            tile.xMax = std::min(tile.xMin + tileWidth, width + 1);
+            tile.yMax = std::min(tile.yMin + tileHeight, height + 1);
+
+            tile.haloXMin = (tile.xMin > haloWidth) ? (tile.xMin - haloWidth) : 0;
+            tile.haloYMin = (tile.yMin > haloWidth) ? (tile.yMin - haloWidth) : 0;
+            tile.haloXMax = std::min(tile.xMax + haloWidth, width + 1);
+            tile.haloYMax = std::min(tile.yMax + haloWidth, height + 1);
+        }
+
+        return;
+
+    error:
+        exit(EXIT_FAILURE);
+    }
+
+    void Mesh::initialiseTopology()
+    {
+        // Topologies of existing meshes, keyed by geometry. Weak pointers are
+        // held so that a topology is freed along with the last mesh using it.
+        typedef std::tuple<unsigned int, unsigned int, bool, int> Key;
+        static std::map<Key, std::weak_ptr<const Topology> > topologies;
+        static std::mutex mutex;
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // Remove expired topologies.
+        for (std::map<Key, std::weak_ptr<const Topology> >::iterator iter=topologies.begin();iter!=topologies.end();)
+        {
+            if (iter->second.expired()) iter = topologies.erase(iter);
+            else ++iter;
+        }
+
+        Key key(width, height, isImplicit, int(nodeOrdering));
+
+        // Share an existing topology.
+        std::map<Key, std::weak_ptr<const Topology> >::iterator iter = topologies.find(key);
+        if (iter != topologies.end())
+        {
+            topology = iter->second.lock();
+            setTopology(*topology);
+
+            return;
+        }
+
+        std::shared_ptr<Topology> newTopology = std::make_shared<Topology>();
+
+        // Set up the node numbering.
+        initialiseOrdering(*newTopology);
+
+        if (!isImplicit)
+        {
+            // Resize topology arrays.
+            newTopology->nodeCoords.resize(nNodes);
+            newTopology->neighbours.resize(4*nNodes);
+            newTopology->nodeElements.resize(4*nNodes, 0);
+            newTopology->nConnectedElements.resize(nNodes, 0);
+            newTopology->isDomainNode.resize(nNodes, false);
+            newTopology->elementCoords.resize(nElements);
+            newTopology->elementNodes.resize(4*nElements);
+        }
+
+        // Point at the new data (the numbering is needed to build the remaining arrays).
+        setTopology(*newTopology);
+
+        if (!isImplicit)
+        {
+            // Calculate node nearest neighbours.
+            initialiseNodes(*newTopology);
+
+            // Initialise elements (and node to element connectivity).
+            initialiseElements(*newTopology);
+        }
+
+        // Precompute the WENO stencils of nodes near the domain edge.
+        initialiseEdgeStencils(*newTopology);
+
+        // Point at the complete data.
+        setTopology(*newTopology);
+
+        topology = newTopology;
+        topologies[key] = topology;
+    }
+
+    void Mesh::setTopology(const Topology& topology_)
+    {
+        stripHeight = topology_.stripHeight;
+        rowOffset = topology_.rowOffset.data();
+        rowStride = topology_.rowStride.data();
+        nodeCoords = topology_.nodeCoords.data();
+        neighbours = topology_.neighbours.data();
+        nodeElements = topology_.nodeElements.data();
+        nConnectedElements = topology_.nConnectedElements.data();
+        elementCoords = topology_.elementCoords.data();
+        elementNodes = topology_.elementNodes.data();
+        edgeRowOffset = topology_.edgeRowOffset.data();
+        edgeStencils = topology_.edgeStencils.data();
+    }
+
+    void Mesh::initialiseOrdering(Topology& topology_) const
+    {
+        // Row-major ordering is equivalent to strips of a single row.
+        unsigned int stripHeight = (nodeOrdering == NodeOrdering::TILED) ? tileSize : 1;
+        topology_.stripHeight = stripHeight;
+
+        topology_.rowOffset.resize(height + 1);
+        topology_.rowStride.resize(height + 1);
+
+        // Loop over all rows of nodes.
+        for (unsigned int y=0;y<=height;y++)
         {
-            // Mark node as in bulk.
-            nodes[i].isDomain = false;
+            // First row of the strip.
+            unsigned int y0 = y - (y % stripHeight);
 
-            // Mark node as unmasked.
-            nodes[i].isMasked = false;
+            // Number of rows in the strip (the top strip may be truncated).
+            unsigned int rows = std::min(stripHeight, height + 1 - y0);
 
-            // Zero number of connected elements.
-            nodes[i].nElements = 0;
+            // All strips below are full. Nodes in the strip are numbered column by column.
+            topology_.rowOffset[y] = y0*(width + 1) + (y - y0);
+            topology_.rowStride[y] = rows;
+        }
+    }
 
-            // Zero number of boundary points.
-            nodes[i].nBoundaryPoints = 0;
+    void Mesh::initialiseNodes(Topology& topology_) const
+    {
+        // Coordinates of the node.
+        unsigned int x, y;
 
+        // Loop over all nodes.
+        for (unsigned int i=0;i<nNodes;i++)
+        {
             // Work out node coordinates.
-            x = i % (width + 1);
-            y = int(i / (width + 1));
+            indexToXY(i, x, y);
 
             // Node lies on the domain boundary.
             if ((x == 0) || (x == width) || (y == 0) || (y == height))
-                nodes[i].isDomain = true;
+                topology_.isDomainNode[i] = true;
 
             // Set node coordinates.
-            nodes[i].coord.x = x;
-            nodes[i].coord.y = y;
-
-            // Add to 2D mapping vector.
-            xyToIndex[x][y] = i;
+            topology_.nodeCoords[i].x = x;
+            topology_.nodeCoords[i].y = y;
 
             // Determine nearest neighbours.
-            initialiseNeighbours(i, x, y);
+            initialiseNeighbours(topology_, i, x, y);
         }
     }
 
-    void Mesh::initialiseElements()
+    void Mesh::initialiseElements(Topology& topology_) const
     {
         // Coordinates of the element.
         unsigned int x, y;
 
-        // Number of nodes along width of mesh (number of elements plus one).
-        unsigned int w = width + 1;
-
         // Loop over all elements.
         for (unsigned int i=0;i<nElements;i++)
         {
@@ -221,57 +423,145 @@ namespace slsm
             y = int(i / width);
 
             // Store coordinates of elemente centre.
-            elements[i].coord.x = x + 0.5;
-            elements[i].coord.y = y + 0.5;
+            topology_.elementCoords[i].x = x + 0.5;
+            topology_.elementCoords[i].y = y + 0.5;
 
             // Store connectivity (element --> node)
 
             // Node on bottom left corner of element.
-            elements[i].nodes[0] = x + (y * w);
+            topology_.elementNodes[4*i] = xyToIndex(x, y);
 
             // Node on bottom right corner of element.
-            elements[i].nodes[1] = x + 1 + (y * w);
+            topology_.elementNodes[4*i + 1] = xyToIndex(x + 1, y);
 
             // Node on top right corner of element.
-            elements[i].nodes[2] = x + 1 + ((y + 1) * w);
+            topology_.elementNodes[4*i + 2] = xyToIndex(x + 1, y + 1);
 
             // Node on top right corner of element.
-            elements[i].nodes[3] = x + ((y + 1) * w);
+            topology_.elementNodes[4*i + 3] = xyToIndex(x, y + 1);
 
             // Fill reverse connectivity arrays (node --> element)
             for (unsigned int j=0;j<4;j++)
             {
-                unsigned int node = elements[i].nodes[j];
-                nodes[node].elements[nodes[node].nElements] = i;
-                nodes[node].nElements++;
+                unsigned int node = topology_.elementNodes[4*i + j];
+                topology_.nodeElements[4*node + topology_.nConnectedElements[node]] = i;
+                topology_.nConnectedElements[node]++;
             }
         }
     }
 
-    void Mesh::initialiseNeighbours(unsigned int node, unsigned int x, unsigned int y)
+    void Mesh::initialiseEdgeStencils(Topology& topology_) const
+    {
+        // Count the edge nodes in each row. Rows within three nodes of the
+        // top or bottom edge (or of a mesh that is too narrow to have any
+        // interior nodes) are entirely edge nodes, otherwise only the three
+        // nodes at either end of the row are.
+        topology_.edgeRowOffset.resize(height + 2);
+        topology_.edgeRowOffset[0] = 0;
+        for (unsigned int y=0;y<=height;y++)
+        {
+            bool isEdgeRow = (y < 3) || (y + 3 > height) || (width < 6);
+            topology_.edgeRowOffset[y + 1] = topology_.edgeRowOffset[y] + (isEdgeRow ? (width + 1) : 6);
+        }
+
+        topology_.edgeStencils.resize(40*topology_.edgeRowOffset[height + 1]);
+
+        // The offset of the first node of each difference in the stencil,
+        // relative to the node, for forward (right, up) and backward (left,
+        // down) directions. The second node is one before the first.
+        const int offsets[2][5] = {{3, 2, 1, 0, -1}, {-2, -1, 0, 1, 2}};
+
+        for (unsigned int y=0;y<=height;y++)
+        {
+            for (unsigned int x=0;x<=width;x++)
+            {
+                if (isInteriorNode(x, y)) continue;
+
+                // Pointer to the stencil of this node.
+                unsigned int offset = topology_.edgeRowOffset[y];
+                if (topology_.edgeRowOffset[y + 1] - offset == width + 1) offset += x;
+                else offset += (x < 3) ? x : (x + 6 - (width + 1));
+                unsigned int* stencil = &topology_.edgeStencils[40*offset];
+
+                // Loop over the right, left, up, and down directions.
+                for (unsigned int i=0;i<4;i++)
+                {
+                    // Coordinate along the direction, and its maximum.
+                    int c = (i < 2) ? x : y;
+                    int n = (i < 2) ? width : height;
+
+                    // Whether each difference lies inside the domain.
+                    bool isInside[5];
+                    for (unsigned int j=0;j<5;j++)
+                        isInside[j] = ((c + offsets[i % 2][j] - 1) >= 0) && ((c + offsets[i % 2][j]) <= n);
+
+                    for (unsigned int j=0;j<5;j++)
+                    {
+                        // Find the nearest difference inside the domain.
+                        int k = -1;
+                        for (int d=0;d<5;d++)
+                        {
+                            if ((int(j) - d >= 0) && isInside[j - d]) { k = j - d; break; }
+                            if ((j + d < 5) && isInside[j + d]) { k = j + d; break; }
+                        }
+
+                        unsigned int* pair = &stencil[10*i + 2*j];
+
+                        // The mesh is too small for the stencil, use a zero difference.
+                        if (k < 0)
+                        {
+                            pair[0] = xyToIndex(x, y);
+                            pair[1] = pair[0];
+                        }
+                        else
+                        {
+                            int first = c + offsets[i % 2][k];
+
+                            if (i < 2)
+                            {
+                                pair[0] = xyToIndex(first, y);
+                                pair[1] = xyToIndex(first - 1, y);
+                            }
+                            else
+                            {
+                                pair[0] = xyToIndex(x, first);
+                                pair[1] = xyToIndex(x, first - 1);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void Mesh::initialiseNeighbours(Topology& topology_, unsigned int node,
+        unsigned int x, unsigned int y) const
     {
         // Number of nodes along width and height of mesh (number of elements plus one).
         unsigned int w = width + 1;
         unsigned int h = height + 1;
 
+        // Pointer to the neighbours of this node.
+        unsigned int* n = &topology_.neighbours[4*node];
+
         // First assume the mesh is periodic (in case we add this feature).
 
         // Neighbours to left and right.
-        nodes[node].neighbours[0] = (x - 1 + w) % w + (y * w);
-        nodes[node].neighbours[1] = (x + 1 + w) % w + (y * w);
+        n[0] = xyToIndex((x - 1 + w) % w, y);
+        n[1] = xyToIndex((x + 1 + w) % w, y);
 
         // Neighbours below and above.
-        nodes[node].neighbours[2] = x + (w * ((y - 1 + h) % h));
-        nodes[node].neighbours[3] = x + (w * ((y + 1 + h) % h));
+        n[2] = xyToIndex(x, (y - 1 + h) % h);
+        n[3] = xyToIndex(x, (y + 1 + h) % h);
 
         // Now flag out of bounds neighbours (the mesh isn't periodic).
 
         // Node is on first or last row.
-        if (x == 0) nodes[node].neighbours[0] = nNodes;
-        else if (x == width) nodes[node].neighbours[1] = nNodes;
+        if (x == 0) n[0] = nNodes;
+        else if (x == width) n[1] = nNodes;
 
         // Node is on first or last column.
-        if (y == 0) nodes[node].neighbours[2] = nNodes;
-        else if (y == height) nodes[node].neighbours[3] = nNodes;
+        if (y == 0) n[2] = nNodes;
+        else if (y == height) n[3] = nNodes;
     }
 }
@@ -18,6 +18,7 @@
 #ifndef _MESH_H
 #define _MESH_H
 
+#include <memory>
 #include <vector>
 
 #include "Common.h"
@@ -69,7 +70,22 @@ namespace slsm
         };
     }
 
-    //! Structure containing attributes for an individual grid element.
+    //! The numbering scheme used for the mesh nodes.
+    namespace NodeOrdering
+    {
+        enum NodeOrdering
+        {
+            ROW_MAJOR       = 0,                    //!< Nodes are numbered row by row.
+            TILED           = 1,                    //!< Nodes are numbered in strips of rows (cache blocked).
+        };
+    }
+
+    //! A snapshot of the attributes of an individual grid element.
+    /*! Element data is held by the Mesh in flat, contiguous arrays. An Element
+        is a lightweight, read-only copy of that data for a single element, as
+        returned by Mesh::elements. Element state should be modified through
+        the corresponding Mesh arrays.
+     */
     struct Element
     {
         //! Constructor.
@@ -77,23 +93,28 @@ namespace slsm
 
         Coord coord;                                //!< Element coordinate (centre).
         double area;                                //!< Material area fraction.
-        std::vector<unsigned int> nodes;            //!< Indices for nodes of the element.
-        std::vector<unsigned int> boundarySegments; //!< Indices for boundary segments associated with the element.
+        unsigned int nodes[4];                      //!< Indices for nodes of the element.
+        unsigned int boundarySegments[2];           //!< Indices for boundary segments associated with the element.
         unsigned int nBoundarySegments;             //!< The number of boundary segments associated with the element.
         ElementStatus::ElementStatus status;        //!< Whether the element (or its centre) lies inside or outside the structure.
     };
 
-    //! Structure containing attributes for an individual grid node.
+    //! A snapshot of the attributes of an individual grid node.
+    /*! Node data is held by the Mesh in flat, contiguous arrays. A Node is a
+        lightweight, read-only copy of that data for a single node, as returned
+        by Mesh::nodes. Node state should be modified through the corresponding
+        Mesh arrays.
+     */
     struct Node
     {
         //! Constructor.
         Node();
 
         Coord coord;                                //!< Node coordinate.
-        std::vector<unsigned int> neighbours;       //!< Indices of nearest neighbour nodes.
-        std::vector<unsigned int> elements;         //!< Indices of elements the node is connected to.
+        unsigned int neighbours[4];                 //!< Indices of nearest neighbour nodes.
+        unsigned int elements[4];                   //!< Indices of elements the node is connected to.
         unsigned int nElements;                     //!< Number of elements that the node is connected to.
-        std::vector<unsigned int> boundaryPoints;   //!< Indices of boundary points associated with the node.
+        unsigned int boundaryPoints[4];             //!< Indices of boundary points associated with the node.
         unsigned int nBoundaryPoints;               //!< The number of boundary points associated with the node.
         bool isActive;                              //!< Whether the node is active (part of narrow band, and not fixed).
         bool isDomain;                              //!< Whether the node lies on the domain boundary.
@@ -102,6 +123,55 @@ namespace slsm
         NodeStatus::NodeStatus status;              //!< Whether node is outside, inside, or on the boundary.
     };
 
+    //! A rectangular tile of mesh nodes, used for domain decomposition.
+    /*! Each node is owned by exactly one tile. The halo extends the tile by
+        a fixed number of nodes in each direction (truncated at the edge of the
+        mesh) and covers the nodes that are read by stencils centred on the
+        nodes of the tile. Coordinate ranges include the minimum and exclude
+        the maximum.
+     */
+    struct Tile
+    {
+        //! Whether a node is owned by the tile.
+        /*! \param x
+                The x coordinate of the node.
+
+            \param y
+                The y coordinate of the node.
+
+            \return
+                Whether the node lies in the tile.
+         */
+        bool contains(unsigned int x, unsigned int y) const
+        {
+            return ((x >= xMin) && (x < xMax) && (y >= yMin) && (y < yMax));
+        }
+
+        //! Whether a node lies within the tile, or its halo.
+        /*! \param x
+                The x coordinate of the node.
+
+            \param y
+                The y coordinate of the node.
+
+            \return
+                Whether the node lies in the tile or halo.
+         */
+        bool haloContains(unsigned int x, unsigned int y) const
+        {
+            return ((x >= haloXMin) && (x < haloXMax) && (y >= haloYMin) && (y < haloYMax));
+        }
+
+        unsigned int xMin;                          //!< The minimum x coordinate of the tile.
+        unsigned int yMin;                          //!< The minimum y coordinate of the tile.
+        unsigned int xMax;                          //!< One past the maximum x coordinate of the tile.
+        unsigned int yMax;                          //!< One past the maximum y coordinate of the tile.
+        unsigned int haloXMin;                      //!< The minimum x coordinate of the halo.
+        unsigned int haloYMin;                      //!< The minimum y coordinate of the halo.
+        unsigned int haloXMax;                      //!< One past the maximum x coordinate of the halo.
+        unsigned int haloYMax;                      //!< One past the maximum y coordinate of the halo.
+    };
+
     // MAIN CLASS
 
     /*! \brief A class for the level-set domain fixed-grid mesh.
@@ -117,7 +187,7 @@ namespace slsm
         Diagonal neighbours can be accessed by looking at neighbours of neighbours,
         e.g. for the lower left diagonal of node i
 
-        node = nodes[nodes[i].neighbours[0]].neighbours[2];
+        node = neighbour(neighbour(i, 0), 2);
 
         Note that diagonal nodes can be accessed in multiple ways, e.g.
         for the lower left diagonal of node i we could go left then down,
@@ -127,6 +197,64 @@ namespace slsm
         given the value nNodes, i.e. one past the end of the node array, which
         runs from 0 to nNodes - 1.
 
+        All data is stored in flat, structure-of-arrays form, so that building
+        the mesh requires only a handful of allocations, and kernels that sweep
+        over the nodes stream through contiguous memory. The static topology
+        (coordinates, connectivity, and domain flags) is accessed through inline
+        member functions, e.g. neighbour(node, direction). The mutable state of
+        the nodes and elements is stored in public arrays indexed by node or
+        element, e.g. isActive[node]. Per-node and per-element lists are stored
+        with a fixed stride, e.g. the jth boundary point of a node is
+        boundaryPoints[4*node + j].
+
+        The nodes and elements members provide read-only Node and Element
+        snapshots, e.g. nodes[i].coord, for convenience in non-critical code.
+
+        Since the grid is regular, the topology is pure arithmetic on the (x, y)
+        position of a node or element. When constructed in implicit mode the
+        topology arrays are never allocated and the accessors compute their
+        result on the fly, reducing the memory footprint of the mesh to its
+        state arrays. This allows very large domains to be used at the cost of
+        a small amount of extra arithmetic per lookup.
+
+        By default nodes are numbered in row-major order. Alternatively, nodes
+        can be numbered in tiled order, where the mesh is decomposed into
+        horizontal strips of tileSize rows (the top strip may be shorter) that
+        are numbered from the bottom up. Within each strip, nodes are numbered
+        column by column, i.e. each tile is a single column of the strip. Nodes
+        above and below one another are then adjacent in memory and the left and
+        right neighbours are only tileSize entries away, rather than a full row,
+        which improves locality for the vertical stencils on wide meshes. Both
+        orderings are described by the offset and stride of each row of nodes,
+        so that xyToIndex is branch free. The numbering is compact, i.e. it runs
+        from 0 to nNodes - 1, and is transparent to code that maps between
+        coordinates and indices using xyToIndex, nodeCoord, and the neighbour
+        accessors. Elements are always numbered in row-major order.
+
+        The topology is immutable and is shared between all meshes with the
+        same dimensions, node ordering, and implicit flag, e.g. the meshes of
+        an ensemble of level sets, so it is only built and stored once. Only
+        the state arrays are owned by each mesh.
+
+        For sparse, band-limited processing the nodes are also grouped into
+        square blocks of tileSize x tileSize nodes (truncated at the top and
+        right edges), numbered in row-major order. Each element belongs to the
+        block containing its bottom left node.
+
+        For multi-threaded kernels the nodes are partitioned into rectangular
+        tiles (see Tile) with a halo that is wide enough for the stencils of the
+        kernels, by default three nodes for the WENO gradient stencil. Kernels
+        loop over the tiles in parallel, each thread only writing data for the
+        nodes that its tile owns, so that results don't depend on the number of
+        threads. The partition can be changed with initialiseTiles.
+
+        The fifth order WENO gradient stencil of a node spans three nodes in
+        each direction. For interior nodes, i.e. those at least three nodes
+        from the domain edge, the stencil nodes are found by simple offsets
+        (see interiorStencil). For the remaining edge nodes, the topology holds
+        a table of precomputed one-sided stencils (see edgeStencil), so that
+        gradient calculations never need to test the position of a node.
+
         Note that this mesh is store information related to the nodes and
         elements of the level-set domain and is not related to the mesh used
         in finite element calculations (which may be a different geometry or
@@ -135,14 +263,94 @@ namespace slsm
     class Mesh
     {
     public:
+        //! Indexable, read-only view of the mesh nodes.
+        class NodeArray
+        {
+        public:
+            //! Constructor.
+            /*! \param mesh_
+                    A reference to the mesh.
+             */
+            NodeArray(const Mesh& mesh_) : mesh(&mesh_) {}
+
+            //! Return a snapshot of a node.
+            /*! \param node
+                    The node index.
+
+                \return
+                    The node data.
+             */
+            Node operator[](unsigned int node) const;
+
+            //! Return the number of nodes.
+            unsigned int size() const;
+
+        private:
+            friend class Mesh;
+
+            /// A pointer to the parent mesh.
+            const Mesh* mesh;
+        };
+
+        //! Indexable, read-only view of the mesh elements.
+        class ElementArray
+        {
+        public:
+            //! Constructor.
+            /*! \param mesh_
+                    A reference to the mesh.
+             */
+            ElementArray(const Mesh& mesh_) : mesh(&mesh_) {}
+
+            //! Return a snapshot of an element.
+            /*! \param element
+                    The element index.
+
+                \return
+                    The element data.
+             */
+            Element operator[](unsigned int element) const;
+
+            //! Return the number of elements.
+            unsigned int size() const;
+
+        private:
+            friend class Mesh;
+
+            /// A pointer to the parent mesh.
+            const Mesh* mesh;
+        };
+
         //! Constructor.
         /*! \param width_
                 The width of the mesh.
 
             \param height_
                 The height of the mesh.
+
+            \param isImplicit_
+                Whether to compute the mesh topology on the fly (optional).
+
+            \param nodeOrdering_
+                The numbering scheme for the mesh nodes (optional).
+         */
+        Mesh(unsigned int, unsigned int, bool isImplicit_ = false,
+            NodeOrdering::NodeOrdering nodeOrdering_ = NodeOrdering::ROW_MAJOR);
+
+        //! Copy constructor.
+        /*! \param mesh
+                The mesh to copy.
+         */
+        Mesh(const Mesh&);
+
+        //! Whether the mesh shares its topology with another mesh.
+        /*! \param mesh
+                The other mesh.
+
+            \return
+                Whether the topology is shared.
          */
-        Mesh(unsigned int, unsigned int);
+        bool sharesTopology(const Mesh&) const;
 
         //! For a given x-y coordinate, find the index of the closest node.
         /*! \param point
@@ -186,26 +394,465 @@ namespace slsm
          */
         unsigned int getElement(double, double) const;
 
-        std::vector<Element> elements;  //!< Fixed-grid elements (cells).
-        std::vector<Node> nodes;        //!< Fixed-grid nodes.
+        //! Mapping between (x, y) coordinates and one dimensional node indices.
+        /*! \param x
+                The x coordinate of the node.
+
+            \param y
+                The y coordinate of the node.
+
+            \return
+                The index of the node.
+         */
+        unsigned int xyToIndex(unsigned int x, unsigned int y) const
+        {
+            return rowOffset[y] + x*rowStride[y];
+        }
+
+        //! Mapping between one dimensional node indices and (x, y) coordinates.
+        /*! \param node
+                The index of the node.
+
+            \param x
+                The x coordinate of the node (filled by function).
+
+            \param y
+                The y coordinate of the node (filled by function).
+         */
+        void indexToXY(unsigned int node, unsigned int& x, unsigned int& y) const
+        {
+            // Strip of rows containing the node (all preceding strips are full).
+            unsigned int strip = node / (stripHeight*(width + 1));
+
+            // Position of the node within the strip.
+            node -= strip*stripHeight*(width + 1);
+
+            x = node / rowStride[strip*stripHeight];
+            y = strip*stripHeight + node % rowStride[strip*stripHeight];
+        }
+
+        //! Return the index of the block containing a node.
+        /*! \param x
+                The x coordinate of the node.
+
+            \param y
+                The y coordinate of the node.
+
+            \return
+                The index of the block.
+         */
+        unsigned int xyToBlock(unsigned int x, unsigned int y) const
+        {
+            return (x / tileSize) + (y / tileSize)*nBlocksX;
+        }
+
+        //! Return the range of node coordinates spanned by a block.
+        /*! \param block
+                The index of the block.
+
+            \param xMin
+                The minimum x coordinate (filled by function).
+
+            \param yMin
+                The minimum y coordinate (filled by function).
+
+            \param xMax
+                One past the maximum x coordinate (filled by function).
+
+            \param yMax
+                One past the maximum y coordinate (filled by function).
+         */
+        void blockBounds(unsigned int block, unsigned int& xMin, unsigned int& yMin,
+            unsigned int& xMax, unsigned int& yMax) const
+        {
+            xMin = (block % nBlocksX) * tileSize;
+            yMin = (block / nBlocksX) * tileSize;
+            xMax = (xMin + tileSize > width + 1) ? (width + 1) : (xMin + tileSize);
+            yMax = (yMin + tileSize > height + 1) ? (height + 1) : (yMin + tileSize);
+        }
+
+        //! Partition the nodes into tiles.
+        /*! \param tileWidth_
+                The width of each tile (in nodes).
+
+            \param tileHeight_
+                The height of each tile (in nodes).
+
+            \param haloWidth_
+                The width of the halo around each tile (in nodes).
+         */
+        void initialiseTiles(unsigned int, unsigned int, unsigned int haloWidth_ = 3);
+
+        //! Return the index of the tile that owns a node.
+        /*! \param x
+                The x coordinate of the node.
+
+            \param y
+                The y coordinate of the node.
+
+            \return
+                The index of the tile.
+         */
+        unsigned int xyToTile(unsigned int x, unsigned int y) const
+        {
+            return (x / tileWidth) + (y / tileHeight)*nTilesX;
+        }
+
+        //! Whether the WENO stencil of a node lies entirely within the domain.
+        /*! \param x
+                The x coordinate of the node.
+
+            \param y
+                The y coordinate of the node.
+
+            \return
+                Whether the node is an interior node.
+         */
+        bool isInteriorNode(unsigned int x, unsigned int y) const
+        {
+            return ((x >= 3) && (x + 3 <= width) && (y >= 3) && (y + 3 <= height));
+        }
+
+        //! Return the indices of the nodes in the WENO stencil of an interior node.
+        /*! \param x
+                The x coordinate of the node.
+
+            \param y
+                The y coordinate of the node.
+
+            \param row
+                The nodes from (x-3, y) to (x+3, y) (filled by function).
+
+            \param column
+                The nodes from (x, y-3) to (x, y+3) (filled by function).
+         */
+        void interiorStencil(unsigned int x, unsigned int y, unsigned int* row, unsigned int* column) const
+        {
+            unsigned int stride = rowStride[y];
+            unsigned int first = xyToIndex(x, y) - 3*stride;
+
+            for (unsigned int i=0;i<7;i++)
+            {
+                row[i] = first + i*stride;
+                column[i] = xyToIndex(x, y + i - 3);
+            }
+        }
+
+        //! Return the WENO stencil of an edge node.
+        /*! The stencil holds five finite differences for each of the right,
+            left, up, and down directions, in turn. Each difference is stored
+            as a pair of node indices, (a, b), for which the difference is the
+            value at a minus the value at b. Where a difference would reach
+            outside of the domain, the nearest difference inside is repeated.
+
+            \param x
+                The x coordinate of the node.
+
+            \param y
+                The y coordinate of the node.
+
+            \return
+                A pointer to the node index pairs (stride 2, forty entries).
+         */
+        const unsigned int* edgeStencil(unsigned int x, unsigned int y) const
+        {
+            unsigned int offset = edgeRowOffset[y];
+
+            // Every node in the row is an edge node.
+            if (edgeRowOffset[y + 1] - offset == width + 1)
+                return &edgeStencils[40*(offset + x)];
+
+            // Only the three nodes at either end of the row are edge nodes.
+            return &edgeStencils[40*(offset + ((x < 3) ? x : (x + 6 - (width + 1))))];
+        }
+
+        //! Return the index of a nearest neighbour of a node.
+        /*! \param node
+                The node index.
+
+            \param direction
+                The neighbour direction (left, right, down, up).
+
+            \return
+                The index of the neighbour (nNodes if out of bounds).
+         */
+        unsigned int neighbour(unsigned int node, unsigned int direction) const
+        {
+            if (!isImplicit) return neighbours[4*node + direction];
+
+            unsigned int x, y;
+            indexToXY(node, x, y);
+
+            switch (direction)
+            {
+                case 0:  return (x == 0) ? nNodes : xyToIndex(x - 1, y);
+                case 1:  return (x == width) ? nNodes : xyToIndex(x + 1, y);
+                case 2:  return (y == 0) ? nNodes : xyToIndex(x, y - 1);
+                default: return (y == height) ? nNodes : xyToIndex(x, y + 1);
+            }
+        }
+
+        //! Return the coordinates of a node.
+        /*! \param node
+                The node index.
+
+            \return
+                The node coordinates.
+         */
+        Coord nodeCoord(unsigned int node) const
+        {
+            if (!isImplicit) return nodeCoords[node];
+
+            unsigned int x, y;
+            indexToXY(node, x, y);
+
+            return Coord(x, y);
+        }
+
+        //! Whether a node lies on the domain boundary.
+        /*! \param node
+                The node index.
+
+            \return
+                Whether the node is on the domain boundary.
+         */
+        bool isDomain(unsigned int node) const
+        {
+            if (!isImplicit) return topology->isDomainNode[node];
+
+            unsigned int x, y;
+            indexToXY(node, x, y);
+
+            return ((x == 0) || (x == width) || (y == 0) || (y == height));
+        }
+
+        //! Return the index of an element connected to a node.
+        /*! \param node
+                The node index.
+
+            \param index
+                The index of the element in the node's element list.
+
+            \return
+                The element index.
+         */
+        unsigned int nodeElement(unsigned int node, unsigned int index) const
+        {
+            if (!isImplicit) return nodeElements[4*node + index];
+
+            unsigned int x, y;
+            indexToXY(node, x, y);
+
+            // Candidate elements in ascending index order: lower left,
+            // lower right, upper left, upper right.
+            for (unsigned int i=0;i<4;i++)
+            {
+                unsigned int dx = i & 1;
+                unsigned int dy = i >> 1;
+
+                if ((x + dx > 0) && (x + dx <= width) && (y + dy > 0) && (y + dy <= height))
+                {
+                    if (index == 0) return (x + dx - 1) + (y + dy - 1)*width;
+                    index--;
+                }
+            }
+
+            return nElements;
+        }
+
+        //! Return the number of elements connected to a node.
+        /*! \param node
+                The node index.
+
+            \return
+                The number of connected elements.
+         */
+        unsigned int nNodeElements(unsigned int node) const
+        {
+            if (!isImplicit) return nConnectedElements[node];
+
+            unsigned int x, y;
+            indexToXY(node, x, y);
+
+            return (1 + (x > 0 && x < width)) * (1 + (y > 0 && y < height));
+        }
+
+        //! Return the index of a node of an element.
+        /*! \param element
+                The element index.
+
+            \param corner
+                The corner of the element (anticlockwise from bottom left).
+
+            \return
+                The node index.
+         */
+        unsigned int elementNode(unsigned int element, unsigned int corner) const
+        {
+            if (!isImplicit) return elementNodes[4*element + corner];
+
+            unsigned int x = element % width;
+            unsigned int y = element / width;
+
+            // Offsets for corners, anticlockwise from the bottom left.
+            return xyToIndex(x + ((corner == 1) || (corner == 2)), y + (corner >> 1));
+        }
+
+        //! Return the coordinates of an element centre.
+        /*! \param element
+                The element index.
+
+            \return
+                The element coordinates.
+         */
+        Coord elementCoord(unsigned int element) const
+        {
+            if (!isImplicit) return elementCoords[element];
+
+            return Coord((element % width) + 0.5, (element / width) + 0.5);
+        }
 
         const unsigned int width;       //!< The grid width (number of elements in x).
         const unsigned int height;      //!< The grid height (number of elements in y).
         const unsigned int nElements;   //!< The total number of grid elements.
         const unsigned int nNodes;      //!< The total number of nodes.
+        const bool isImplicit;          //!< Whether the topology is computed on the fly.
+
+        const NodeOrdering::NodeOrdering nodeOrdering;  //!< The numbering scheme for the nodes.
+
+        static const unsigned int tileSize = 16;        //!< The strip height for tiled ordering and the block size (in nodes).
+
+        const unsigned int nBlocksX;    //!< The number of blocks in x.
+        const unsigned int nBlocksY;    //!< The number of blocks in y.
+        const unsigned int nBlocks;     //!< The total number of blocks.
+
+        std::vector<Tile> tiles;        //!< The tiles used for domain decomposition.
+        unsigned int nTiles;            //!< The total number of tiles.
+        unsigned int nTilesX;           //!< The number of tiles in x.
+        unsigned int nTilesY;           //!< The number of tiles in y.
+        unsigned int tileWidth;         //!< The width of each tile (in nodes).
+        unsigned int tileHeight;        //!< The height of each tile (in nodes).
+        unsigned int haloWidth;         //!< The width of the tile halo (in nodes).
+
+        NodeArray nodes;                //!< Read-only node snapshots.
+        ElementArray elements;          //!< Read-only element snapshots.
 
-        /// Mapping between (x, y) coordinates and one dimensional nodes indices.
-        std::vector<std::vector<unsigned int> > xyToIndex;
+        // Node state.
+
+        std::vector<NodeStatus::NodeStatus> nodeStatus;     //!< Whether each node is outside, inside, or on the boundary.
+        std::vector<bool> isActive;                         //!< Whether each node is active (part of narrow band, and not fixed).
+        std::vector<bool> isMasked;                         //!< Whether each node lies in a masked region.
+        std::vector<bool> isMine;                           //!< Whether each node lies on the edge of the narrow band.
+        std::vector<unsigned int> boundaryPoints;           //!< Indices of boundary points associated with each node (stride 4).
+        std::vector<unsigned int> nBoundaryPoints;          //!< The number of boundary points associated with each node.
+
+        // Element state.
+
+        std::vector<ElementStatus::ElementStatus> elementStatus;    //!< Whether each element (or its centre) lies inside or outside the structure.
+        std::vector<double> area;                                   //!< Material area fraction of each element.
+        std::vector<unsigned int> boundarySegments;                 //!< Indices for boundary segments associated with each element (stride 2).
+        std::vector<unsigned int> nBoundarySegments;                //!< The number of boundary segments associated with each element.
 
     private:
+        //! The static topology of the mesh.
+        /*! The topology depends only on the mesh dimensions, node ordering,
+            and whether the mesh is implicit, so it is shared (read-only)
+            between all meshes with the same geometry.
+         */
+        struct Topology
+        {
+            /// The number of rows of nodes in each strip.
+            unsigned int stripHeight;
+
+            /// The index of the first node in each row.
+            std::vector<unsigned int> rowOffset;
+
+            /// The index stride between neighbouring nodes in each row.
+            std::vector<unsigned int> rowStride;
+
+            /// Node coordinates.
+            std::vector<Coord> nodeCoords;
+
+            /// Indices of nearest neighbour nodes (stride 4).
+            std::vector<unsigned int> neighbours;
+
+            /// Indices of elements connected to each node (stride 4).
+            std::vector<unsigned int> nodeElements;
+
+            /// Number of elements connected to each node.
+            std::vector<unsigned int> nConnectedElements;
+
+            /// Whether each node lies on the domain boundary.
+            std::vector<bool> isDomainNode;
+
+            /// Element centre coordinates.
+            std::vector<Coord> elementCoords;
+
+            /// Indices for nodes of each element (stride 4).
+            std::vector<unsigned int> elementNodes;
+
+            /// The index of the first edge node in each row.
+            std::vector<unsigned int> edgeRowOffset;
+
+            /// The WENO stencils of the edge nodes (stride 40).
+            std::vector<unsigned int> edgeStencils;
+        };
+
+        /// The shared topology.
+        std::shared_ptr<const Topology> topology;
+
+        // Direct pointers to the topology data, for fast access.
+
+        unsigned int stripHeight;                   //!< The number of rows of nodes in each strip.
+        const unsigned int* rowOffset;              //!< The index of the first node in each row.
+        const unsigned int* rowStride;              //!< The index stride between neighbouring nodes in each row.
+        const Coord* nodeCoords;                    //!< Node coordinates.
+        const unsigned int* neighbours;             //!< Indices of nearest neighbour nodes (stride 4).
+        const unsigned int* nodeElements;           //!< Indices of elements connected to each node (stride 4).
+        const unsigned int* nConnectedElements;     //!< Number of elements connected to each node.
+        const Coord* elementCoords;                 //!< Element centre coordinates.
+        const unsigned int* elementNodes;           //!< Indices for nodes of each element (stride 4).
+        const unsigned int* edgeRowOffset;          //!< The index of the first edge node in each row.
+        const unsigned int* edgeStencils;           //!< The WENO stencils of the edge nodes (stride 40).
+
+        //! Find the shared topology for the mesh geometry, creating it if needed.
+        void initialiseTopology();
+
+        //! Point the direct pointers at the topology data.
+        /*! \param topology
+                The topology.
+         */
+        void setTopology(const Topology&);
+
+        //! Initialise the node numbering.
+        /*! \param topology
+                The topology under construction.
+         */
+        void initialiseOrdering(Topology&) const;
+
         //! Initialise mesh nodes.
-        void initialiseNodes();
+        /*! \param topology
+                The topology under construction.
+         */
+        void initialiseNodes(Topology&) const;
 
         //! Initialise mesh elements.
-        void initialiseElements();
+        /*! \param topology
+                The topology under construction.
+         */
+        void initialiseElements(Topology&) const;
+
+        //! Initialise the WENO stencils of the edge nodes.
+        /*! \param topology
+                The topology under construction.
+         */
+        void initialiseEdgeStencils(Topology&) const;
 
         //! Compute the nearest neighbours of a node.
-        /*! \param node
+        /*! \param topology
+                The topology under construction.
+
+            \param node
                 The node index.
 
             \param x
@@ -214,7 +861,7 @@ namespace slsm
             \param y
                 The y coordinate of the node.
          */
-        void initialiseNeighbours(unsigned int, unsigned int, unsigned int);
+        void initialiseNeighbours(Topology&, unsigned int, unsigned int, unsigned int) const;
     };
 }
 
@@ -35,7 +35,7 @@ namespace slsm
         return reinterpret_cast<Optimise*>(wrapperData->callback)->callback(lambda, gradient, wrapperData->index);
     }
 
-    Optimise::Optimise(std::vector<BoundaryPoint>& boundaryPoints_,
+    Optimise::Optimise(Boundary& boundary_,
                        std::vector<double> constraintDistances_,
                        std::vector<double>& lambdas_,
                        double& timeStep_,
@@ -43,7 +43,8 @@ namespace slsm
                        bool isMax_,
                        const std::vector<bool>& isEquality_,
 					   nlopt::algorithm algorithm_) :
-                       boundaryPoints(boundaryPoints_),
+                       boundary(boundary_),
+                       boundaryPoints(boundary_.points),
                        constraintDistances(constraintDistances_),
                        lambdas(lambdas_),
                        timeStep(timeStep_),
@@ -65,6 +66,10 @@ namespace slsm
         slsm_check(!((nConstraints > 0) && constraintDistances.empty()), "Empty constraint distance vector.");
         slsm_check(nConstraints == constraintDistances.size(), "Incorrect number of constraints.");
 
+        // Check that the boundary has a sensitivity for each function.
+        slsm_check(boundary.nFunctions > nConstraints,
+            "Too few boundary point sensitivities, see Boundary::nFunctions.");
+
         // Resize data structures.
         negativeLambdaLimits.resize(nConstraints + 1);
         positiveLambdaLimits.resize(nConstraints + 1);
@@ -83,14 +88,15 @@ namespace slsm
     }
 
 #ifdef PYBIND
-    Optimise::Optimise(std::vector<BoundaryPoint>& boundaryPoints_,
+    Optimise::Optimise(Boundary& boundary_,
                        std::vector<double> constraintDistances_,
                        std::vector<double>& lambdas_,
                        MutableFloat& timeStep_,
                        double maxDisplacement_,
                        bool isMax_,
                        const std::vector<bool>& isEquality_) :
-                       boundaryPoints(boundaryPoints_),
+                       boundary(boundary_),
+                       boundaryPoints(boundary_.points),
                        constraintDistances(constraintDistances_),
                        lambdas(lambdas_),
                        timeStep(timeStep_.value),
@@ -112,6 +118,10 @@ namespace slsm
         slsm_check(!((nConstraints > 0) && constraintDistances.empty()), "Empty constraint distance vector.");
         slsm_check(nConstraints == constraintDistances.size(), "Incorrect number of constraints.");
 
+        // Check that the boundary has a sensitivity for each function.
+        slsm_check(boundary.nFunctions > nConstraints,
+            "Too few boundary point sensitivities, see Boundary::nFunctions.");
+
         // Resize data structures.
         negativeLambdaLimits.resize(nConstraints + 1);
         positiveLambdaLimits.resize(nConstraints + 1);
@@ -176,13 +186,10 @@ namespace slsm
         // Calculate and store the gradient for each function.
         for (unsigned int i=0;i<nConstraints+1;i++)
         {
-            std::vector<double> gradient(nConstraints + 1);
-
-            // Calculate the gradient.
-            computeGradients(gradient, i);
+            gradients[i].resize(nConstraints + 1);
 
-            // Store the gradient.
-            gradients[i] = gradient;
+            // Calculate the gradient (in place).
+            computeGradients(gradients[i], i);
         }
 
         // Create wrapper for objective.
@@ -191,7 +198,7 @@ namespace slsm
         objectiveWrapper.callback = this;
 
         // Create wrappers for constraints.
-        NLoptWrapper constraintWrappers[nConstraints];
+        std::vector<NLoptWrapper> constraintWrappers(nConstraints);
         for (unsigned int i=0;i<nConstraints;i++)
         {
             constraintWrappers[i].index = i + 1;
@@ -341,7 +348,7 @@ namespace slsm
                 if (!boundaryPoints[j].isFixed)
                 {
                     // Test whether sensitivity magnitude is current maximum.
-                    double sens = std::abs(boundaryPoints[j].sensitivities[i]);
+                    double sens = std::abs(boundary.sensitivity(j, i));
                     if (sens > maxSens) maxSens = sens;
                 }
             }
@@ -432,21 +439,21 @@ namespace slsm
          * Evaluate the constraint change at each vertex to deduce limits.
          *****************************************************************/
 
+        // Vector to hold all possible constraint changes.
+        std::vector<double> constraintChanges(nVertices);
+
+        // Lambda vector.
+        std::vector<double> lambda(nDim);
+
         // Loop over all constraints.
         for (unsigned int i=0;i<nCurrentConstraints;i++)
         {
             // Flag constraint as active.
             isActive[i] = true;
 
-            // Vector to hold all possible constraint changes.
-            std::vector<double> constraintChanges(nVertices);
-
             // Loop over all vertices.
             for (unsigned int j=0;j<nVertices;j++)
             {
-                // Lambda vector.
-                std::vector<double> lambda(nDim);
-
                 // Populate the lambda vector.
                 for (unsigned int k=0;k<nDim;k++)
                 {
@@ -466,7 +473,7 @@ namespace slsm
                     if(!boundaryPoints[k].isFixed)
                     {
                         constraintChange += displacements[k]
-                                          * boundaryPoints[k].sensitivities[indexMap[i+1]]
+                                          * boundary.sensitivity(k, indexMap[i+1])
                                           * boundaryPoints[k].length;
                     }
                 }
@@ -598,7 +605,7 @@ namespace slsm
                 if (!boundaryPoints[j].isFixed)
                 {
                     // Take absolute sensitivity.
-                    double sens = std::abs(boundaryPoints[j].sensitivities[k]);
+                    double sens = std::abs(boundary.sensitivity(j, k));
 
                     // Check max sensitivity.
                     if (sens > maxSens) maxSens = sens;
@@ -634,7 +641,7 @@ namespace slsm
             if (!boundaryPoints[i].isFixed)
             {
                 // Initialise component for objective.
-                displacements[i] = scaleFactors[0] * lambda[0] * boundaryPoints[i].sensitivities[0];
+                displacements[i] = scaleFactors[0] * lambda[0] * boundary.sensitivity(i, 0);
 
                 // Add components for active constraints.
                 for (unsigned int j=1;j<nConstraints+1;j++)
@@ -643,7 +650,7 @@ namespace slsm
                     unsigned int k = indexMap[j];
 
                     // Update displacement vector.
-                    displacements[i] += scaleFactors[j] * lambda[j] * boundaryPoints[i].sensitivities[k];
+                    displacements[i] += scaleFactors[j] * lambda[j] * boundary.sensitivity(i, k);
                 }
 
                 // Check side limits if point lies close to domain boundary.
@@ -672,7 +679,7 @@ namespace slsm
         {
             // Don't consider fixed points.
             if (!boundaryPoints[i].isFixed)
-                func += (scaleFactors[index] * displacements[i] * boundaryPoints[i].sensitivities[j] * boundaryPoints[i].length);
+                func += (scaleFactors[index] * displacements[i] * boundary.sensitivity(i, j) * boundaryPoints[i].length);
         }
 
         if (index == 0) return func;
@@ -711,8 +718,8 @@ namespace slsm
                     // Scale factor.
                     double scaleFactor = scaleFactors[index] * scaleFactors[j];
 
-                    gradient[k] += (boundaryPoints[i].sensitivities[indexMap[index]]
-                                 *  boundaryPoints[i].sensitivities[k]
+                    gradient[k] += (boundary.sensitivity(i, indexMap[index])
+                                 *  boundary.sensitivity(i, k)
                                  *  boundaryPoints[i].length
                                  *  scaleFactor);
                 }
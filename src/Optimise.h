@@ -28,6 +28,7 @@ namespace slsm
 {
     // FORWARD DECLARATIONS
 
+    class Boundary;
     struct BoundaryPoint;
 
     // ASSOCIATED DATA TYPES
@@ -80,8 +81,10 @@ namespace slsm
     {
     public:
         //! Constructor.
-        /*! \param boundaryPoints_
-                A reference to a vector of boundary points.
+        /*! \param boundary_
+                A reference to the discretised boundary. The boundary must have
+                a sensitivity for the objective and every constraint at each point,
+                see Boundary::nFunctions.
 
             \param constraintDistances_
                 Distance from each constraint (negative values indicate that the
@@ -111,14 +114,16 @@ namespace slsm
             \param algorithm_
                 (Optional) The NLopt algorithm (default = LD_SLSQP).
          */
-        Optimise(std::vector<BoundaryPoint>&, std::vector<double>, std::vector<double>&,
+        Optimise(Boundary&, std::vector<double>, std::vector<double>&,
             double&, double maxDisplacement_ = 0.5, bool isMax_ = false,
             const std::vector<bool>& isEquality_ = {}, nlopt::algorithm algorithm_ = nlopt::LD_SLSQP);
 
 #ifdef PYBIND
         //! Constructor.
-        /*! \param boundaryPoints_
-                A reference to a vector of boundary points.
+        /*! \param boundary_
+                A reference to the discretised boundary. The boundary must have
+                a sensitivity for the objective and every constraint at each point,
+                see Boundary::nFunctions.
 
             \param constraintDistances_
                 Distance from each constraint (negative values indicate that the
@@ -145,7 +150,7 @@ namespace slsm
             \param isEquality_
                 (Optional) Whether each constraint is an equality (default = inequality).
          */
-        Optimise(std::vector<BoundaryPoint>&, std::vector<double>, std::vector<double>&,
+        Optimise(Boundary&, std::vector<double>, std::vector<double>&,
             MutableFloat&, double maxDisplacement_ = 0.5, bool isMax_ = false,
             const std::vector<bool>& isEquality_ = {});
 #endif
@@ -181,7 +186,10 @@ namespace slsm
         /// The number of initial constraints.
         unsigned int nConstraintsInitial;
 
-        /// A reference to a vector of boundary points.
+        /// A reference to the discretised boundary.
+        Boundary& boundary;
+
+        /// A reference to the vector of boundary points.
         std::vector<BoundaryPoint>& boundaryPoints;
 
         /// A vector of distances from the constraint manifold.
@@ -0,0 +1,138 @@
+/*
+  Copyright (c) 2015-2017 Lester Hedges <lester.hedges+slsm@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "Quadtree.h"
+
+/*! \file Quadtree.cpp
+    \brief An adaptive quadtree decomposition of the level set domain.
+ */
+
+namespace slsm
+{
+    QuadtreeCell::QuadtreeCell() :
+        x(0),
+        y(0),
+        size(0),
+        isRefined(false),
+        status(ElementStatus::NONE)
+    {
+    }
+
+    Quadtree::Quadtree() :
+        nCells(0),
+        nRefined(0),
+        rootSize(0),
+        width(0),
+        height(0)
+    {
+    }
+
+    Quadtree::Quadtree(const Mesh& mesh, const std::vector<double>& signedDistance)
+    {
+        build(mesh, signedDistance);
+    }
+
+    void Quadtree::build(const Mesh& mesh, const std::vector<double>& signedDistance)
+    {
+        width = mesh.width;
+        height = mesh.height;
+
+        // Find the smallest power of two that covers the mesh.
+        rootSize = 1;
+        while ((rootSize < width) || (rootSize < height)) rootSize *= 2;
+
+        // Build the tree.
+        cells.clear();
+        unsorted.clear();
+        subdivide(mesh, signedDistance, 0, 0, rootSize);
+        nCells = cells.size();
+        nRefined = unsorted.size();
+
+        // The elements were found in Z-order, which is ascending in x within
+        // each row, so a stable counting sort by row puts them in ascending order.
+        rowOffset.assign(height + 1, 0);
+        for (unsigned int i=0;i<nRefined;i++)
+            rowOffset[unsorted[i] / width + 1]++;
+
+        for (unsigned int i=0;i<height;i++)
+            rowOffset[i + 1] += rowOffset[i];
+
+        elements.resize(nRefined);
+        for (unsigned int i=0;i<nRefined;i++)
+            elements[rowOffset[unsorted[i] / width]++] = unsorted[i];
+    }
+
+    void Quadtree::subdivide(const Mesh& mesh, const std::vector<double>& signedDistance,
+        unsigned int x, unsigned int y, unsigned int size)
+    {
+        // The cell lies outside of the mesh.
+        if ((x >= width) || (y >= height)) return;
+
+        QuadtreeCell cell;
+        cell.x = x;
+        cell.y = y;
+        cell.size = size;
+
+        if (size > 1)
+        {
+            // The node at the centre of the cell (truncated to the mesh).
+            unsigned int xCentre = std::min(x + size/2, width);
+            unsigned int yCentre = std::min(y + size/2, height);
+
+            double sd = signedDistance[mesh.xyToIndex(xCentre, yCentre)];
+
+            // Every point in the (truncated) cell lies within half a diagonal of
+            // the centre node. Allow a 50% error in the signed distance, plus one
+            // grid spacing, since reinitialisation is only first order accurate.
+            double radius = 1.5*size/std::sqrt(2.0) + 1;
+
+            // Nodes on the edge of the domain may be pinned to the zero contour,
+            // e.g. when the domain boundary is fixed, without being a distance
+            // from the nodes inside, so cells on the edge are always refined.
+            bool isEdge = ((x == 0) || (y == 0) || ((x + size) >= width) || ((y + size) >= height));
+
+            // The cell may be cut by the boundary, refine it.
+            if (isEdge || (std::abs(sd) <= radius))
+            {
+                unsigned int half = size / 2;
+
+                subdivide(mesh, signedDistance, x, y, half);
+                subdivide(mesh, signedDistance, x + half, y, half);
+                subdivide(mesh, signedDistance, x, y + half, half);
+                subdivide(mesh, signedDistance, x + half, y + half, half);
+
+                return;
+            }
+
+            // The cell lies entirely on one side of the boundary.
+            if (sd < 0) cell.status = ElementStatus::OUTSIDE;
+            else cell.status = ElementStatus::INSIDE;
+        }
+
+        // The cell is a mesh element close to the boundary.
+        else
+        {
+            cell.isRefined = true;
+            unsorted.push_back(x + y*width);
+        }
+
+        cells.push_back(cell);
+    }
+}
@@ -0,0 +1,132 @@
+/*
+  Copyright (c) 2015-2017 Lester Hedges <lester.hedges+slsm@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _QUADTREE_H
+#define _QUADTREE_H
+
+#include <vector>
+
+#include "Mesh.h"
+
+/*! \file Quadtree.h
+    \brief An adaptive quadtree decomposition of the level set domain.
+ */
+
+namespace slsm
+{
+    // ASSOCIATED DATA TYPES
+
+    //! \brief A container for storing information associated with a quadtree cell.
+    class QuadtreeCell
+    {
+    public:
+        //! Constructor.
+        QuadtreeCell();
+
+        unsigned int x;                         //!< The x coordinate of the bottom left node.
+        unsigned int y;                         //!< The y coordinate of the bottom left node.
+        unsigned int size;                      //!< The edge length of the cell (in mesh units).
+        bool isRefined;                         //!< Whether the cell is a mesh element that may be cut by the boundary.
+        ElementStatus::ElementStatus status;    //!< The status of the cell (NONE for refined cells).
+    };
+
+    // MAIN CLASS
+
+    /*! \brief An adaptive quadtree decomposition of the level set domain.
+
+        The domain is recursively subdivided into square cells, starting from a
+        root cell whose edge length is the smallest power of two that covers
+        the mesh. Cells that extend beyond the top or right edge of the mesh
+        are truncated. Cells are refined down to individual mesh elements
+        around the zero contour of a signed distance function, while regions
+        far from the zero contour are represented by large cells that lie
+        entirely inside or outside of the structure.
+
+        Since the magnitude of a signed distance function is the distance to
+        the zero contour, a cell can't be cut by the boundary if the magnitude
+        at its centre node exceeds half the length of its diagonal. This test is
+        padded to allow for the error of the fast marching method, so the
+        refined cells are a superset of the elements that are cut by the
+        boundary. Cells on the edge of the domain are always refined. Only the
+        cells that are visited by the subdivision are tested, so the cost of
+        construction scales with the length of the boundary and the perimeter
+        of the domain, rather than its area.
+
+        The leaves are stored in Z-order. The indices of the refined elements
+        are also stored in ascending order, so that they can be visited in the
+        same order as a sweep over the whole mesh.
+     */
+    class Quadtree
+    {
+    public:
+        //! Default constructor.
+        Quadtree();
+
+        //! Constructor.
+        /*! \param mesh
+                A reference to the fixed-grid mesh.
+
+            \param signedDistance
+                A reference to the signed distance function vector.
+         */
+        Quadtree(const Mesh&, const std::vector<double>&);
+
+        //! Rebuild the quadtree, e.g. following reinitialisation.
+        /*! \param mesh
+                A reference to the fixed-grid mesh.
+
+            \param signedDistance
+                A reference to the signed distance function vector.
+         */
+        void build(const Mesh&, const std::vector<double>&);
+
+        std::vector<QuadtreeCell> cells;        //!< The leaf cells of the quadtree.
+        std::vector<unsigned int> elements;     //!< Indices of the refined elements (in ascending order).
+        unsigned int nCells;                    //!< The number of leaf cells.
+        unsigned int nRefined;                  //!< The number of refined (element-sized) cells.
+        unsigned int rootSize;                  //!< The edge length of the root cell.
+        unsigned int width;                     //!< The width of the mesh.
+        unsigned int height;                    //!< The height of the mesh.
+
+    private:
+        /// Indices of the refined elements in Z-order, reused between calls.
+        std::vector<unsigned int> unsorted;
+
+        /// The offset of the first refined element in each row, reused between calls.
+        std::vector<unsigned int> rowOffset;
+
+        //! Recursively subdivide a cell.
+        /*! \param mesh
+                A reference to the fixed-grid mesh.
+
+            \param signedDistance
+                A reference to the signed distance function vector.
+
+            \param x
+                The x coordinate of the bottom left corner of the cell.
+
+            \param y
+                The y coordinate of the bottom left corner of the cell.
+
+            \param size
+                The edge length of the cell.
+         */
+        void subdivide(const Mesh&, const std::vector<double>&, unsigned int, unsigned int, unsigned int);
+    };
+}
+
+#endif  /* _QUADTREE_H */
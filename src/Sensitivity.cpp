@@ -94,7 +94,7 @@ namespace slsm
             double curvature = computeSensitivity(boundary.points[i], callback);
 
             // Correct the objective sensitivity.
-            boundary.points[i].sensitivities[0] -= (temperature * curvature) / (2.0 * boundary.points[i].length);
+            boundary.sensitivity(i, 0) -= (temperature * curvature) / (2.0 * boundary.points[i].length);
         }
     }
 }
@@ -0,0 +1,225 @@
+/*
+  Copyright (c) 2015-2017 Lester Hedges <lester.hedges+slsm@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <limits>
+
+#include "Debug.h"
+#include "UntidyQueue.h"
+
+/*! \file UntidyQueue.cpp
+    \brief An implementation of an untidy (bucketed) priority queue.
+ */
+
+namespace slsm
+{
+    // Null entry flag, used to terminate the linked lists.
+    static const unsigned int nullEntry = std::numeric_limits<unsigned int>::max();
+
+    UntidyQueue::UntidyQueue(unsigned int maxLength_, double bucketWidth_) :
+        maxLength(maxLength_),
+        bucketWidth(bucketWidth_)
+    {
+        // Check that the bucket width is valid.
+        errno = 0;
+        slsm_check(bucketWidth > 0, "Bucket width must be positive.");
+
+        // Initialise empty queue.
+        queueLength = 0;
+        listLength = 0;
+        currentBucket = 0;
+        maxBucket = 0;
+
+        // Resize data structures.
+        distance.resize(maxLength);
+        address.resize(maxLength);
+        bucket.resize(maxLength);
+        next.resize(maxLength);
+        previous.resize(maxLength);
+
+        // Start with a single empty bucket. More are added as required.
+        head.resize(1, nullEntry);
+        tail.resize(1, nullEntry);
+
+        return;
+
+    error:
+        exit(EXIT_FAILURE);
+    }
+
+    unsigned int UntidyQueue::push(unsigned int address_, double value)
+    {
+        // Make sure the queue isn't full.
+        errno = 0;
+        slsm_check(listLength < maxLength, "push: Queue is full!");
+
+        // Add entry to the list.
+        address[listLength]  = address_;
+        distance[listLength] = value;
+
+        // Add entry to its bucket.
+        link(listLength);
+
+        // Increment queue size.
+        queueLength++;
+
+        // Increment list size.
+        listLength++;
+
+        return listLength - 1;
+
+    error:
+        exit(EXIT_FAILURE);
+    }
+
+    void UntidyQueue::pop(unsigned int& address_, double& value)
+    {
+        // Make sure the queue isn't empty.
+        errno = 0;
+        slsm_check(queueLength != 0, "pop: Queue is empty!");
+
+        // Find the lowest non-empty bucket.
+        advance();
+
+        // Remove the first entry in the bucket.
+        {
+            unsigned int index = head[currentBucket];
+
+            address_ = address[index];
+            value    = distance[index];
+
+            unlink(index);
+        }
+
+        // Decrement queue size.
+        queueLength--;
+
+        return;
+
+    error:
+        exit(EXIT_FAILURE);
+    }
+
+    void UntidyQueue::set(unsigned int index, double newDistance)
+    {
+        // Update distance.
+        distance[index] = newDistance;
+
+        // Only move the entry if its bucket has changed, so that the
+        // first-in, first-out order within a bucket is preserved.
+        if (bucketIndex(newDistance) != bucket[index])
+        {
+            unlink(index);
+            link(index);
+        }
+    }
+
+    void UntidyQueue::clear()
+    {
+        // Empty all buckets that have been used.
+        for (unsigned int i=0;i<=maxBucket;i++)
+        {
+            head[i] = nullEntry;
+            tail[i] = nullEntry;
+        }
+
+        queueLength = 0;
+        listLength = 0;
+        currentBucket = 0;
+        maxBucket = 0;
+    }
+
+    bool UntidyQueue::empty() const
+    {
+        return (queueLength == 0) ? true : false;
+    }
+
+    const double& UntidyQueue::peek() const
+    {
+        // Make sure the queue isn't empty.
+        errno = 0;
+        slsm_check(queueLength != 0, "peek: Queue is empty!");
+
+        // Find the lowest non-empty bucket.
+        advance();
+
+        return distance[head[currentBucket]];
+
+    error:
+        exit(EXIT_FAILURE);
+    }
+
+    const unsigned int& UntidyQueue::size() const
+    {
+        return queueLength;
+    }
+
+    unsigned int UntidyQueue::bucketIndex(double value) const
+    {
+        // Negative values are placed in the first bucket.
+        if (value <= 0) return 0;
+
+        return (unsigned int)(value / bucketWidth);
+    }
+
+    void UntidyQueue::link(unsigned int index)
+    {
+        unsigned int b = bucketIndex(distance[index]);
+
+        // Add more buckets.
+        if (b >= head.size())
+        {
+            unsigned int newSize = 2*head.size();
+            if (newSize <= b) newSize = b + 1;
+
+            head.resize(newSize, nullEntry);
+            tail.resize(newSize, nullEntry);
+        }
+
+        if (b > maxBucket) maxBucket = b;
+
+        // The entry lies below the current bucket.
+        if (b < currentBucket) currentBucket = b;
+
+        // Append entry to the end of the bucket.
+        bucket[index]   = b;
+        next[index]     = nullEntry;
+        previous[index] = tail[b];
+
+        if (tail[b] == nullEntry) head[b] = index;
+        else next[tail[b]] = index;
+
+        tail[b] = index;
+    }
+
+    void UntidyQueue::unlink(unsigned int index)
+    {
+        unsigned int b = bucket[index];
+
+        if (previous[index] == nullEntry) head[b] = next[index];
+        else next[previous[index]] = next[index];
+
+        if (next[index] == nullEntry) tail[b] = previous[index];
+        else previous[next[index]] = previous[index];
+    }
+
+    void UntidyQueue::advance() const
+    {
+        // All entries lie in, or above, the current bucket and the queue is
+        // non-empty, so there is always a non-empty bucket to be found.
+        while (head[currentBucket] == nullEntry) currentBucket++;
+    }
+}
@@ -0,0 +1,177 @@
+/*
+  Copyright (c) 2015-2017 Lester Hedges <lester.hedges+slsm@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _UNTIDYQUEUE_H
+#define _UNTIDYQUEUE_H
+
+#include <vector>
+
+/*! \file UntidyQueue.h
+    \brief An implementation of an untidy (bucketed) priority queue.
+ */
+
+namespace slsm
+{
+    /*! \brief An implementation of an untidy (bucketed) priority queue.
+
+        Entries are placed in buckets of fixed width according to their
+        distance from the zero iso-contour of the level set. Each bucket is
+        a doubly linked list of entries, so that push, pop, and set are all
+        O(1) operations. Entries are popped in first-in, first-out order from
+        the lowest non-empty bucket, i.e. the order within a bucket is not
+        sorted, hence the name.
+
+        Used in place of the Heap, the fast marching method becomes O(N), with
+        an additional error that is proportional to the bucket width. See:
+
+            L. Yatziv, A. Bartesaghi, and G. Sapiro, "O(N) implementation of
+            the fast marching algorithm", J. Comput. Phys. 212, 393-399 (2006).
+
+        The interface is the same as that of the Heap. Values must be
+        non-negative. Buckets are created as needed, so the range of values
+        doesn't need to be known in advance.
+     */
+    class UntidyQueue
+    {
+    public:
+        //! Constructor.
+        /*! \param maxLength_
+                The maximum number of entries in the queue.
+
+            \param bucketWidth_
+                The width of each bucket (optional).
+         */
+        UntidyQueue(unsigned int, double bucketWidth_ = 0.05);
+
+        //! Push a value onto the queue.
+        /*! \param address_
+                The address of the element to push (its array index).
+
+            \param value
+                The value of the element.
+
+            \return
+                The index of the value in the queue.
+         */
+        unsigned int push(unsigned int, double);
+
+        //! Pop the first entry from the lowest non-empty bucket.
+        /*! \param address_
+                The address (index) of the entry.
+
+            \param value
+                The value of the entry.
+         */
+        void pop(unsigned int&, double&);
+
+        //! Set a specific queue entry.
+        /*! \param index
+                The index in the queue.
+
+            \param newDistance
+                The new distance value.
+         */
+        void set(unsigned int, double);
+
+        //! Remove all entries from the queue, keeping its storage for reuse.
+        void clear();
+
+        //! Test whether the queue is empty.
+        /*! \return
+                Whether the queue is empty (true) or contains entries (false).
+         */
+        bool empty() const;
+
+        //! Return the value of the entry that would be popped next.
+        /*! \return
+                The value of the next entry.
+         */
+        const double& peek() const;
+
+        //! Return the current size of the queue.
+        /*! \return
+                The current size of the queue.
+         */
+        const unsigned int& size() const;
+
+    private:
+        /// The maximum number of entries in the queue.
+        unsigned int maxLength;
+
+        /// The width of each bucket.
+        double bucketWidth;
+
+        /// The current size of the queue.
+        unsigned int queueLength;
+
+        /// The current size of the list.
+        unsigned int listLength;
+
+        /// The lowest bucket that may be non-empty. No entry lies below it.
+        mutable unsigned int currentBucket;
+
+        /// The highest bucket that has been used since the queue was cleared.
+        unsigned int maxBucket;
+
+        /// The unsigned distance from the zero level set iso-contour.
+        std::vector<double> distance;
+
+        /// The (original) grid address of each entry.
+        std::vector<unsigned int> address;
+
+        /// The bucket holding each entry.
+        std::vector<unsigned int> bucket;
+
+        /// The next entry in the same bucket.
+        std::vector<unsigned int> next;
+
+        /// The previous entry in the same bucket.
+        std::vector<unsigned int> previous;
+
+        /// The first entry in each bucket.
+        std::vector<unsigned int> head;
+
+        /// The last entry in each bucket.
+        std::vector<unsigned int> tail;
+
+        //! Return the bucket for a value.
+        /*! \param value
+                The value of an entry.
+
+            \return
+                The index of the bucket.
+         */
+        unsigned int bucketIndex(double) const;
+
+        //! Append an entry to the end of its bucket.
+        /*! \param index
+                The index in the queue.
+         */
+        void link(unsigned int);
+
+        //! Remove an entry from its bucket.
+        /*! \param index
+                The index in the queue.
+         */
+        void unlink(unsigned int);
+
+        //! Advance to the lowest non-empty bucket.
+        void advance() const;
+    };
+}
+
+#endif  /* _UNTIDYQUEUE_H */
@@ -17,6 +17,50 @@
 
 #include "slsm.h"
 
+// Push the holes used by the multi-iteration tests into a vector container.
+std::vector<slsm::Hole> initialiseHoles()
+{
+    std::vector<slsm::Hole> holes;
+    holes.push_back(slsm::Hole(50, 50, 10));
+    holes.push_back(slsm::Hole(120, 80, 15));
+    holes.push_back(slsm::Hole(90, 150, 8));
+
+    return holes;
+}
+
+// Grow the holes by moving the boundary outwards with a constant velocity.
+void growHoles(slsm::LevelSet& levelSet, slsm::Boundary& boundary)
+{
+    for (unsigned int i=0;i<boundary.nPoints;i++)
+        boundary.points[i].velocity = -1;
+
+    levelSet.computeVelocities(boundary.points);
+    levelSet.computeGradients();
+    levelSet.update(0.5);
+}
+
+// Check whether two discretisations have identical points and segments.
+bool isSameBoundary(const slsm::Boundary& boundary1, const slsm::Boundary& boundary2)
+{
+    if (boundary1.nPoints != boundary2.nPoints) return false;
+    if (boundary1.nSegments != boundary2.nSegments) return false;
+
+    for (unsigned int i=0;i<boundary1.nPoints;i++)
+    {
+        if (boundary1.points[i].coord.x != boundary2.points[i].coord.x) return false;
+        if (boundary1.points[i].coord.y != boundary2.points[i].coord.y) return false;
+    }
+
+    for (unsigned int i=0;i<boundary1.nSegments;i++)
+    {
+        if (boundary1.segments[i].start != boundary2.segments[i].start) return false;
+        if (boundary1.segments[i].end != boundary2.segments[i].end) return false;
+        if (boundary1.segments[i].element != boundary2.segments[i].element) return false;
+    }
+
+    return true;
+}
+
 int testBoundaryPoints()
 {
     // Tests for the correct assignent of boundary points.
@@ -551,6 +595,413 @@ error:
     return 1;
 }
 
+int testSparseBlocks()
+{
+    // A test that restricting updates to the active mesh blocks gives the
+    // same boundary and area fraction as a full update of the mesh, and
+    // that the boundary lies within the active blocks.
+
+    // Push a small hole into a vector container.
+    std::vector<slsm::Hole> holes;
+    holes.push_back(slsm::Hole(100, 100, 10));
+
+    // Initialise two 200x200 level set domains with a fixed domain boundary.
+    slsm::LevelSet levelSet(200, 200, holes, 0.5, 6, true);
+    slsm::LevelSet sparseLevelSet(200, 200, holes, 0.5, 6, true);
+
+    // Restrict updates to the active blocks.
+    sparseLevelSet.isSparse = true;
+
+    // Initialise the boundary objects.
+    slsm::Boundary boundary;
+    slsm::Boundary sparseBoundary;
+
+    // Set error number.
+    errno = 0;
+
+    // Check that only the blocks around the hole are active.
+    slsm_check((sparseLevelSet.nActiveBlocks > 0), "No active blocks!");
+    slsm_check((sparseLevelSet.nActiveBlocks < sparseLevelSet.mesh.nBlocks), "All blocks are active!");
+
+    // Grow the hole over several iterations, which includes reinitialisation
+    // of the signed distance function and the narrow band.
+    for (unsigned int i=0;i<20;i++)
+    {
+        boundary.discretise(levelSet);
+        sparseBoundary.discretise(sparseLevelSet);
+
+        levelSet.computeAreaFractions(boundary);
+        sparseLevelSet.computeAreaFractions(sparseBoundary);
+
+        // Check that the boundaries and areas match.
+        slsm_check(isSameBoundary(boundary, sparseBoundary), "Boundary mismatch!");
+        slsm_check((std::abs(boundary.length - sparseBoundary.length) < 1e-10), "Boundary length mismatch!");
+        slsm_check((std::abs(levelSet.area - sparseLevelSet.area) < 1e-8), "Area fraction mismatch!");
+
+        // Whether each block is active.
+        std::vector<bool> isActiveBlock(sparseLevelSet.mesh.nBlocks, false);
+        for (unsigned int j=0;j<sparseLevelSet.nActiveBlocks;j++)
+            isActiveBlock[sparseLevelSet.activeBlocks[j]] = true;
+
+        // Check that every element cut by the boundary is in an active block.
+        for (unsigned int j=0;j<sparseBoundary.nSegments;j++)
+        {
+            unsigned int element = sparseBoundary.segments[j].element;
+            slsm::Coord coord = sparseLevelSet.mesh.nodeCoord(sparseLevelSet.mesh.elementNode(element, 0));
+            unsigned int block = sparseLevelSet.mesh.xyToBlock(coord.x, coord.y);
+
+            slsm_check(isActiveBlock[block], "Boundary segment lies outside of the active blocks!");
+        }
+
+        growHoles(levelSet, boundary);
+        growHoles(sparseLevelSet, sparseBoundary);
+    }
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int testBandElements()
+{
+    // A test that restricting the discretisation to the elements around the
+    // narrow band gives the same boundary as a target discretisation (which
+    // finds the elements close to the boundary using a quadtree), while
+    // visiting only a fraction of the mesh.
+
+    // Initialise a 200x200 level set domain. The domain boundary is free, so
+    // that the target discretisation finds no additional points along the edges.
+    slsm::LevelSet levelSet(200, 200, initialiseHoles());
+
+    // Initialise the boundary objects.
+    slsm::Boundary boundary;
+    slsm::Boundary targetBoundary;
+
+    // Set error number.
+    errno = 0;
+
+    // Grow the holes over several iterations.
+    for (unsigned int i=0;i<10;i++)
+    {
+        // Reinitialise, so that the signed distance function is also a valid target.
+        levelSet.reinitialise();
+
+        boundary.discretise(levelSet);
+
+        // Discretise the same function as a target, independently of the narrow band.
+        levelSet.target = levelSet.signedDistance;
+        targetBoundary.discretise(levelSet, true);
+
+        // Check that the boundaries match.
+        slsm_check(isSameBoundary(boundary, targetBoundary), "Boundary mismatch!");
+
+        // Count the elements with a narrow band node.
+        unsigned int nBandElements = 0;
+        for (unsigned int j=0;j<levelSet.mesh.nElements;j++)
+        {
+            bool isBand = false;
+            for (unsigned int k=0;k<4;k++)
+                if (levelSet.mesh.isActive[levelSet.mesh.elementNode(j, k)]) isBand = true;
+
+            if (isBand) nBandElements++;
+        }
+
+        // Check that only a fraction of the mesh needs to be visited.
+        slsm_check((2*nBandElements < levelSet.mesh.nElements), "Narrow band covers most of the mesh!");
+
+        // Check that every element cut by the boundary has a narrow band node.
+        for (unsigned int j=0;j<boundary.nSegments;j++)
+        {
+            unsigned int element = boundary.segments[j].element;
+
+            bool isBand = false;
+            for (unsigned int k=0;k<4;k++)
+                if (levelSet.mesh.isActive[levelSet.mesh.elementNode(element, k)]) isBand = true;
+
+            slsm_check(isBand, "Boundary segment lies outside of the narrow band!");
+        }
+
+        growHoles(levelSet, boundary);
+    }
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int testStrips()
+{
+    // A test that discretising the boundary in strips of elements, which are
+    // then merged, gives the same result as a single pass over the elements.
+
+    // Initialise two 200x200 level set domains with a fixed domain boundary.
+    slsm::LevelSet levelSet(200, 200, initialiseHoles(), 0.5, 6, true);
+    slsm::LevelSet stripLevelSet(200, 200, initialiseHoles(), 0.5, 6, true);
+
+    // A single tile spanning the mesh, so that the elements are discretised
+    // in one strip, i.e. serially.
+    levelSet.mesh.initialiseTiles(levelSet.mesh.width + 1, levelSet.mesh.height + 1);
+
+    // Use thin tiles, so that many boundary points lie on the rows of nodes
+    // that are shared by neighbouring strips.
+    stripLevelSet.mesh.initialiseTiles(64, 3);
+
+    // Initialise the boundary objects.
+    slsm::Boundary boundary;
+    slsm::Boundary stripBoundary;
+
+    // Set error number.
+    errno = 0;
+
+    // Grow the holes over several iterations.
+    for (unsigned int i=0;i<10;i++)
+    {
+        boundary.discretise(levelSet);
+        stripBoundary.discretise(stripLevelSet);
+
+        // Check that the boundaries match.
+        slsm_check(isSameBoundary(boundary, stripBoundary), "Boundary mismatch!");
+        slsm_check((boundary.length == stripBoundary.length), "Boundary length mismatch!");
+
+        // Check the node to boundary point lookup, which is merged across
+        // the rows of nodes shared by neighbouring strips.
+        for (unsigned int j=0;j<levelSet.mesh.nNodes;j++)
+        {
+            if (levelSet.mesh.isActive[j])
+            {
+                slsm_check((levelSet.mesh.nBoundaryPoints[j] == stripLevelSet.mesh.nBoundaryPoints[j]),
+                    "Number of node boundary points mismatch!");
+
+                for (unsigned int k=0;k<levelSet.mesh.nBoundaryPoints[j];k++)
+                {
+                    slsm_check((levelSet.mesh.boundaryPoints[4*j + k] == stripLevelSet.mesh.boundaryPoints[4*j + k]),
+                        "Node boundary point mismatch!");
+                }
+            }
+        }
+
+        // Check the element to boundary segment lookup.
+        for (unsigned int j=0;j<levelSet.mesh.nElements;j++)
+        {
+            slsm_check((levelSet.mesh.nBoundarySegments[j] == stripLevelSet.mesh.nBoundarySegments[j]),
+                "Number of element boundary segments mismatch!");
+
+            for (unsigned int k=0;k<levelSet.mesh.nBoundarySegments[j];k++)
+            {
+                slsm_check((levelSet.mesh.boundarySegments[2*j + k] == stripLevelSet.mesh.boundarySegments[2*j + k]),
+                    "Element boundary segment mismatch!");
+            }
+        }
+
+        growHoles(levelSet, boundary);
+        growHoles(stripLevelSet, stripBoundary);
+    }
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int testGridLine()
+{
+    // A test for a zero contour that runs along a grid line, with material
+    // on both sides. The segment on each edge of the line is found by the
+    // elements on both sides, so the points on the line belong to four
+    // segments.
+
+    // Push a hole into a vector container.
+    std::vector<slsm::Hole> holes;
+    holes.push_back(slsm::Hole(10, 10, 3));
+
+    // Initialise a 20x20 level set domain.
+    slsm::LevelSet levelSet(20, 20, holes);
+
+    // Initialise the boundary object.
+    slsm::Boundary boundary;
+
+    // Set error number.
+    errno = 0;
+
+    // Place the zero contour along the horizontal line y = 10.
+    for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
+        levelSet.signedDistance[i] = std::abs(10 - levelSet.mesh.nodeCoord(i).y);
+
+    // Update the narrow band.
+    levelSet.reinitialise();
+
+    // Discretise the boundary.
+    boundary.discretise(levelSet);
+
+    // Check the number of points.
+    slsm_check((boundary.nPoints == 21), "The number of boundary points is incorrect!");
+
+    // Check the point to segment and neighbour lookups.
+    for (unsigned int i=0;i<boundary.nPoints;i++)
+    {
+        // Points at either end of the line lie on the domain boundary.
+        unsigned int nExpected = boundary.points[i].isDomain ? 2 : 4;
+
+        slsm_check((std::abs(boundary.points[i].coord.y - 10) < 1e-6), "Position of boundary point is incorrect!");
+        slsm_check((boundary.points[i].nSegments == nExpected), "The number of point segments is incorrect!");
+        slsm_check((boundary.points[i].nNeighbours == nExpected), "The number of point neighbours is incorrect!");
+
+        for (unsigned int j=0;j<boundary.points[i].nSegments;j++)
+        {
+            const slsm::BoundarySegment& segment = boundary.segments[boundary.points[i].segments[j]];
+            slsm_check(((segment.start == i) || (segment.end == i)), "Point segment lookup is incorrect!");
+        }
+    }
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int testEdges()
+{
+    // A test that no two boundary points share a mesh node or edge once the
+    // strips have been merged, and that each point lies on the node or edge
+    // that it is keyed by.
+
+    // Initialise a 200x200 level set domain with a fixed domain boundary.
+    slsm::LevelSet levelSet(200, 200, initialiseHoles(), 0.5, 6, true);
+
+    // Use thin tiles, so that many keys lie on the rows of nodes that are
+    // shared by neighbouring strips.
+    levelSet.mesh.initialiseTiles(64, 3);
+
+    // Initialise the boundary object.
+    slsm::Boundary boundary;
+
+    // Set error number.
+    errno = 0;
+
+    // Grow the holes over several iterations, reusing the lookup table.
+    for (unsigned int i=0;i<10;i++)
+    {
+        boundary.discretise(levelSet);
+
+        // Whether each key has been used.
+        std::vector<bool> isUsed(3*levelSet.mesh.nNodes, false);
+
+        // The number of points on the rows of nodes shared by two strips.
+        unsigned int nShared = 0;
+
+        for (unsigned int j=0;j<boundary.nPoints;j++)
+        {
+            unsigned int key = boundary.points[j].edge;
+
+            slsm_check((key < 3*levelSet.mesh.nNodes), "Boundary point key is out of range!");
+            slsm_check(!isUsed[key], "Boundary point key is repeated!");
+            isUsed[key] = true;
+
+            // Position of the node.
+            slsm::Coord coord = levelSet.mesh.nodeCoord(key / 3);
+
+            // Offset of the point from the node.
+            double dx = boundary.points[j].coord.x - coord.x;
+            double dy = boundary.points[j].coord.y - coord.y;
+
+            // Whether the point lies on its node or edge.
+            bool isOnEdge;
+
+            // Point lies on the node.
+            if ((key % 3) == 0)
+                isOnEdge = (std::abs(dx) < 1e-6) && (std::abs(dy) < 1e-6);
+
+            // Point lies on the horizontal edge to the right of the node.
+            else if ((key % 3) == 1)
+                isOnEdge = (dx >= 0) && (dx <= 1) && (std::abs(dy) < 1e-6);
+
+            // Point lies on the vertical edge above the node.
+            else
+                isOnEdge = (dy >= 0) && (dy <= 1) && (std::abs(dx) < 1e-6);
+
+            slsm_check(isOnEdge, "Boundary point isn't on its node or edge!");
+
+            // Point is found by the strips on both sides of the row.
+            unsigned int y = coord.y;
+            if (((key % 3) != 2) && (y > 0) && (y < levelSet.mesh.height) && ((y % 3) == 0)) nShared++;
+        }
+
+        // Check that the merge has been exercised.
+        slsm_check((nShared > 0), "No boundary points on shared rows!");
+
+        growHoles(levelSet, boundary);
+    }
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int testSensitivities()
+{
+    // A test that boundary point sensitivities are stored in a matrix sized
+    // by the number of functions, and that copies of the boundary have
+    // their own sensitivities.
+
+    // Initialise a 200x200 level set domain.
+    slsm::LevelSet levelSet(200, 200, initialiseHoles());
+
+    // Initialise a boundary with an objective and three constraints.
+    slsm::Boundary boundary(4);
+
+    // Set error number.
+    errno = 0;
+
+    slsm_check((boundary.nFunctions == 4), "Number of functions is incorrect!");
+
+    for (unsigned int i=0;i<2;i++)
+    {
+        boundary.discretise(levelSet);
+
+        // Check the size of the sensitivity matrix.
+        slsm_check((boundary.nPoints > 0), "There are no boundary points!");
+        slsm_check((boundary.sensitivities.size() == 4*boundary.nPoints), "Sensitivity matrix size is incorrect!");
+
+        for (unsigned int j=0;j<boundary.nPoints;j++)
+        {
+            // Sensitivities are zeroed by each discretisation.
+            for (unsigned int k=0;k<4;k++)
+            {
+                slsm_check((&boundary.sensitivity(j, k) == &boundary.sensitivities[4*j + k]),
+                    "Point sensitivity isn't an entry of the matrix!");
+                slsm_check((boundary.sensitivity(j, k) == 0), "Point sensitivity isn't zeroed!");
+                boundary.sensitivity(j, k) = j + 0.25*k;
+            }
+        }
+    }
+
+    {
+        // Copy the boundary and modify the sensitivities of the copy.
+        slsm::Boundary copy(boundary);
+
+        slsm_check((copy.nFunctions == 4), "Copied number of functions is incorrect!");
+
+        for (unsigned int j=0;j<copy.nPoints;j++)
+        {
+            slsm_check((copy.sensitivity(j, 3) == j + 0.75), "Copied point sensitivity is incorrect!");
+            copy.sensitivity(j, 3) = -1;
+        }
+
+        // Check that the original is unchanged.
+        const slsm::Boundary& original = boundary;
+        for (unsigned int j=0;j<original.nPoints;j++)
+            slsm_check((original.sensitivity(j, 3) == j + 0.75), "Original point sensitivity has changed!");
+    }
+
+    return 0;
+
+error:
+    return 1;
+}
+
 int all_tests()
 {
     mu_suite_start();
@@ -560,6 +1011,12 @@ int all_tests()
     mu_run_test(testBoundarySymmetry);
     mu_run_test(testConnectivity);
     mu_run_test(testAreaFraction);
+    mu_run_test(testSparseBlocks);
+    mu_run_test(testBandElements);
+    mu_run_test(testStrips);
+    mu_run_test(testGridLine);
+    mu_run_test(testEdges);
+    mu_run_test(testSensitivities);
 
     return 0;
 }
@@ -0,0 +1,142 @@
+/*
+  Copyright (c) 2015-2017 Lester Hedges <lester.hedges+slsm@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "slsm.h"
+
+int testCircle()
+{
+    // A test that the closest point transform is more accurate than the
+    // fast marching method for a circular interface.
+
+    // Create an empty vector of holes (just to pass to constructor).
+    std::vector<slsm::Hole> holes;
+
+    // Initialise a 100x80 level set domain.
+    slsm::LevelSet levelSet(100, 80, holes);
+
+    // Set a scaled signed distance function for a circular structure.
+    std::vector<double> exact(levelSet.mesh.nNodes);
+    for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
+    {
+        double dx = levelSet.mesh.nodeCoord(i).x - 50.3;
+        double dy = levelSet.mesh.nodeCoord(i).y - 40.1;
+        exact[i] = 20.2 - sqrt(dx*dx + dy*dy);
+        levelSet.signedDistance[i] = exact[i];
+    }
+
+    // Initialise the narrow band, which restricts the boundary discretisation.
+    levelSet.reinitialise();
+
+    // Scale the signed distance function so that reinitialisation changes it.
+    for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
+        levelSet.signedDistance[i] = 1.5*exact[i];
+
+    // The cut-off distance.
+    double cutOff = 9;
+
+    // Reinitialise using the fast marching method.
+    std::vector<double> marching = levelSet.signedDistance;
+    slsm::FastMarchingMethod(levelSet.mesh).march(marching);
+
+    // Discretise the boundary and compute the closest point transform.
+    slsm::Boundary boundary;
+    boundary.discretise(levelSet);
+    slsm::ClosestPointTransform cpt(levelSet.mesh);
+    cpt.transform(boundary, levelSet.signedDistance, cutOff);
+
+    // Set error number.
+    errno = 0;
+
+    // Compare the solutions within the cut-off.
+    double transformError = 0;
+    double marchingError = 0;
+    unsigned int nBand = 0;
+    for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
+    {
+        if (std::abs(exact[i]) < (cutOff - 1))
+        {
+            double error = std::abs(levelSet.signedDistance[i] - exact[i]);
+            slsm_check((error < 0.05), "Signed distance mismatch!");
+            transformError += error;
+            marchingError += std::abs(marching[i] - exact[i]);
+            nBand++;
+        }
+
+        // Nodes beyond the cut-off are assigned the signed cut-off distance.
+        else if (std::abs(exact[i]) > (cutOff + 1))
+        {
+            slsm_check((levelSet.signedDistance[i] == ((exact[i] < 0) ? -cutOff : cutOff)), "Far field mismatch!");
+        }
+    }
+    transformError /= nBand;
+    marchingError /= nBand;
+
+    slsm_check((transformError < marchingError), "Closest point transform is less accurate!");
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int testNarrowBand()
+{
+    // A test that the narrow band is rebuilt when reinitialising the level
+    // set using the closest point transform.
+
+    // Initialise a 100x80 level set domain.
+    slsm::LevelSet levelSet(100, 80);
+    levelSet.eikonalSolver = slsm::EikonalSolver::CLOSEST_POINT;
+
+    // Perturb the signed distance function and reinitialise.
+    std::vector<double> signedDistance = levelSet.signedDistance;
+    for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
+        levelSet.signedDistance[i] *= 1.5;
+    levelSet.reinitialise();
+
+    // Set error number.
+    errno = 0;
+
+    // Check that the narrow band contains exactly the nodes within the band
+    // width, and that the sign of the level set is unchanged.
+    unsigned int nNarrowBand = 0;
+    for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
+    {
+        bool isInBand = (std::abs(levelSet.signedDistance[i]) < 6);
+        slsm_check((levelSet.mesh.isActive[i] == isInBand), "Narrow band mismatch!");
+        slsm_check(((levelSet.signedDistance[i] * signedDistance[i]) >= 0), "Sign mismatch!");
+        if (isInBand) nNarrowBand++;
+    }
+
+    slsm_check((levelSet.nNarrowBand == nNarrowBand), "Incorrect narrow band size!");
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(testCircle);
+    mu_run_test(testNarrowBand);
+
+    return 0;
+}
+
+RUN_TESTS(all_tests);
@@ -0,0 +1,217 @@
+/*
+  Copyright (c) 2015-2017 Lester Hedges <lester.hedges+slsm@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "slsm.h"
+
+int testPlanarInterface()
+{
+    // A test that the fast iterative method is exact for a planar interface
+    // aligned with the grid, for both reinitialisation and velocity extension.
+
+    // Create an empty vector of holes (just to pass to constructor).
+    std::vector<slsm::Hole> holes;
+
+    // Initialise a 40x30 level set domain.
+    slsm::LevelSet levelSet(40, 30, holes);
+    levelSet.eikonalSolver = slsm::EikonalSolver::FAST_ITERATIVE;
+
+    // Set a scaled planar signed distance function.
+    for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
+        levelSet.signedDistance[i] = 1.5*(levelSet.mesh.nodeCoord(i).x - 10.25);
+
+    // Reinitialise the signed distance function.
+    levelSet.reinitialise();
+
+    // Initialise the fast iterative method object.
+    slsm::FastIterativeMethod fim(levelSet.mesh);
+
+    // Set error number.
+    errno = 0;
+
+    // Check signed distance against expected values.
+    for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
+    {
+        double expected = levelSet.mesh.nodeCoord(i).x - 10.25;
+        slsm_check((std::abs(levelSet.signedDistance[i] - expected) < 1e-12), "Signed distance mismatch!");
+    }
+
+    // Set velocities that vary along the interface at the nodes either side of it.
+    for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
+    {
+        slsm::Coord coord = levelSet.mesh.nodeCoord(i);
+
+        if ((coord.x == 10) || (coord.x == 11)) levelSet.velocity[i] = sin(0.2*coord.y);
+        else levelSet.velocity[i] = 0;
+    }
+
+    // Extend the velocities.
+    fim.march(levelSet.signedDistance, levelSet.velocity);
+
+    // Velocities should be constant along the normal to the interface.
+    for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
+    {
+        if (levelSet.mesh.isActive[i])
+        {
+            double expected = sin(0.2*levelSet.mesh.nodeCoord(i).y);
+            slsm_check((std::abs(levelSet.velocity[i] - expected) < 1e-12), "Velocity mismatch!");
+        }
+    }
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int testFastMarching()
+{
+    // A test that the fast iterative method is close to the fast marching method.
+
+    // Initialise a 100x80 level set domain.
+    slsm::LevelSet levelSet(100, 80);
+
+    // Initialise the boundary object.
+    slsm::Boundary boundary;
+    boundary.discretise(levelSet);
+
+    // Assign a spatially varying velocity to the boundary points and map
+    // the velocities to the nodes.
+    for (unsigned int i=0;i<boundary.nPoints;i++)
+        boundary.points[i].velocity = sin(0.1*boundary.points[i].coord.x);
+    levelSet.computeVelocities(boundary.points);
+
+    // Perturb the signed distance function so that reinitialisation
+    // changes it.
+    std::vector<double> marching = levelSet.signedDistance;
+    for (unsigned int i=0;i<marching.size();i++)
+        marching[i] *= 1.5;
+    std::vector<double> iterative = marching;
+
+    // Reinitialise using each method.
+    slsm::FastMarchingMethod fmm(levelSet.mesh);
+    slsm::FastIterativeMethod fim(levelSet.mesh);
+    fmm.march(marching);
+    fim.march(iterative);
+
+    // Extend velocities using each method.
+    std::vector<double> marchingVelocity = levelSet.velocity;
+    std::vector<double> iterativeVelocity = levelSet.velocity;
+    std::vector<double> signedDistance = levelSet.signedDistance;
+    fmm.march(levelSet.signedDistance, marchingVelocity);
+    fim.march(levelSet.signedDistance, iterativeVelocity);
+
+    double meanDiff = 0;
+    double meanVelocityDiff = 0;
+    unsigned int nBand = 0;
+
+    // Set error number.
+    errno = 0;
+
+    // Check that the signed distance function is unchanged by velocity extension.
+    for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
+        slsm_check((levelSet.signedDistance[i] == signedDistance[i]), "Signed distance modified!");
+
+    // Compare the solutions within the narrow band. The fast iterative method
+    // is first order, so differences are largest where characteristics meet.
+    for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
+    {
+        if (levelSet.mesh.isActive[i])
+        {
+            double diff = std::abs(iterative[i] - marching[i]);
+            slsm_check((diff < 1), "Signed distance mismatch!");
+            meanDiff += diff;
+
+            // Velocities are discontinuous where characteristics meet, so
+            // only the mean difference is checked.
+            meanVelocityDiff += std::abs(iterativeVelocity[i] - marchingVelocity[i]);
+
+            nBand++;
+        }
+    }
+    meanDiff /= nBand;
+    meanVelocityDiff /= nBand;
+
+    slsm_check((meanDiff < 0.1), "Mean signed distance mismatch!");
+    slsm_check((meanVelocityDiff < 0.01), "Mean velocity mismatch!");
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int testNarrowBand()
+{
+    // A test that the narrow band is rebuilt when the level set is
+    // reinitialised using the fast iterative method along with velocity
+    // extension.
+
+    // Initialise a 100x80 level set domain.
+    slsm::LevelSet levelSet(100, 80);
+    levelSet.eikonalSolver = slsm::EikonalSolver::FAST_ITERATIVE;
+
+    // Initialise the boundary object.
+    slsm::Boundary boundary;
+    boundary.discretise(levelSet);
+
+    // Assign a unit velocity to all boundary points.
+    for (unsigned int i=0;i<boundary.nPoints;i++)
+        boundary.points[i].velocity = 1;
+
+    // Perturb the signed distance function, then reinitialise and extend velocities.
+    for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
+        levelSet.signedDistance[i] *= 1.5;
+    levelSet.computeVelocities(boundary.points, true);
+
+    // Set error number.
+    errno = 0;
+
+    // Check that the narrow band contains exactly the nodes within the band
+    // width and that the velocity has been extended to it.
+    unsigned int nNarrowBand = 0;
+    for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
+    {
+        bool isInBand = (std::abs(levelSet.signedDistance[i]) < 6);
+        slsm_check((levelSet.mesh.isActive[i] == isInBand), "Narrow band mismatch!");
+
+        if (isInBand)
+        {
+            slsm_check((std::abs(levelSet.velocity[i] - 1) < 1e-12), "Velocity mismatch!");
+            nNarrowBand++;
+        }
+    }
+
+    slsm_check((levelSet.nNarrowBand == nNarrowBand), "Incorrect narrow band size!");
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(testPlanarInterface);
+    mu_run_test(testFastMarching);
+    mu_run_test(testNarrowBand);
+
+    return 0;
+}
+
+RUN_TESTS(all_tests);
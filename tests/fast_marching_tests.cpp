@@ -60,11 +60,255 @@ error:
     return 1;
 }
 
+int testReuse()
+{
+    // A test that reusing a fast marching method object gives the same
+    // results as constructing a new object for each march.
+
+    // Initialise a 100x80 level set domain.
+    slsm::LevelSet levelSet(100, 80);
+
+    // Initialise the boundary object.
+    slsm::Boundary boundary;
+    boundary.discretise(levelSet);
+
+    // Assign a spatially varying velocity to the boundary points and map
+    // the velocities to the nodes.
+    for (unsigned int i=0;i<boundary.nPoints;i++)
+        boundary.points[i].velocity = sin(0.1*boundary.points[i].coord.x);
+    levelSet.computeVelocities(boundary.points);
+
+    // Perturb the signed distance function so that reinitialisation
+    // changes it.
+    std::vector<double> signedDistance = levelSet.signedDistance;
+    for (unsigned int i=0;i<signedDistance.size();i++)
+        signedDistance[i] *= 1.5;
+
+    // Initialise the reused fast marching method object.
+    slsm::FastMarchingMethod fmm(levelSet.mesh);
+
+    // Set error number.
+    errno = 0;
+
+    for (unsigned int i=0;i<3;i++)
+    {
+        // Reinitialisation.
+        std::vector<double> reused = signedDistance;
+        std::vector<double> fresh = signedDistance;
+        fmm.march(reused);
+        slsm::FastMarchingMethod(levelSet.mesh).march(fresh);
+
+        for (unsigned int j=0;j<levelSet.mesh.nNodes;j++)
+            slsm_check((reused[j] == fresh[j]), "Signed distance mismatch!");
+
+        // Velocity extension.
+        std::vector<double> reusedVelocity = levelSet.velocity;
+        std::vector<double> freshVelocity = levelSet.velocity;
+        fmm.march(levelSet.signedDistance, reusedVelocity);
+        slsm::FastMarchingMethod(levelSet.mesh).march(levelSet.signedDistance, freshVelocity);
+
+        for (unsigned int j=0;j<levelSet.mesh.nNodes;j++)
+            slsm_check((reusedVelocity[j] == freshVelocity[j]), "Velocity mismatch!");
+    }
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int testUntidyQueue()
+{
+    // A test that the untidy priority queue gives a solution close to that
+    // found using the heap.
+
+    // Initialise a 100x80 level set domain.
+    slsm::LevelSet levelSet(100, 80);
+
+    // Perturb the signed distance function so that reinitialisation
+    // changes it.
+    std::vector<double> heap = levelSet.signedDistance;
+    for (unsigned int i=0;i<heap.size();i++)
+        heap[i] *= 1.5;
+    std::vector<double> untidy = heap;
+
+    // Reinitialise using each priority queue.
+    slsm::FastMarchingMethod(levelSet.mesh).march(heap);
+    slsm::FastMarchingMethod(levelSet.mesh, false, slsm::FMM_QueueType::UNTIDY, 0.05).march(untidy);
+
+    // Set error number.
+    errno = 0;
+
+    // Check that the signed distance functions are close.
+    double meanDiff = 0;
+    for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
+    {
+        double diff = std::abs(untidy[i] - heap[i]);
+        slsm_check((diff < 0.1), "Signed distance mismatch!");
+        meanDiff += diff;
+    }
+    meanDiff /= levelSet.mesh.nNodes;
+
+    slsm_check((meanDiff < 1e-2), "Mean signed distance mismatch!");
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int testCutOff()
+{
+    // A test that a march stopped at a cut-off distance gives the same
+    // solution as a march over the whole mesh within the cut-off.
+
+    // Initialise a 100x80 level set domain.
+    slsm::LevelSet levelSet(100, 80);
+
+    // Perturb the signed distance function so that reinitialisation
+    // changes it.
+    std::vector<double> signedDistance = levelSet.signedDistance;
+    for (unsigned int i=0;i<signedDistance.size();i++)
+        signedDistance[i] *= 1.5;
+
+    // The cut-off distance.
+    double cutOff = 5;
+
+    // Initialise the fast marching method object.
+    slsm::FastMarchingMethod fmm(levelSet.mesh);
+
+    // Reinitialise over the whole mesh, and up to the cut-off distance.
+    std::vector<double> full = signedDistance;
+    std::vector<double> limited = signedDistance;
+    std::vector<unsigned int> fullBand, limitedBand;
+    fmm.march(full, 3, fullBand);
+    fmm.march(limited, 3, limitedBand, cutOff);
+
+    // Reinitialise over the whole mesh again, to check that the object
+    // has been reset.
+    std::vector<double> reused = signedDistance;
+    fmm.march(reused);
+
+    // Set error number.
+    errno = 0;
+
+    for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
+    {
+        // Nodes within the cut-off are unchanged, those beyond are set to
+        // the signed cut-off distance.
+        if (std::abs(full[i]) <= cutOff)
+        {
+            slsm_check((limited[i] == full[i]), "Signed distance mismatch!");
+        }
+        else
+        {
+            slsm_check((limited[i] == ((full[i] < 0) ? -cutOff : cutOff)), "Far field mismatch!");
+        }
+
+        slsm_check((reused[i] == full[i]), "Reused signed distance mismatch!");
+    }
+
+    // The narrow band is the same.
+    slsm_check((limitedBand == fullBand), "Narrow band mismatch!");
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int testReplay()
+{
+    // A test that replaying the upwind dependencies recorded during
+    // reinitialisation gives the same velocities as reinitialising and
+    // extending velocities in a single pass.
+
+    // Initialise a 100x80 level set domain.
+    slsm::LevelSet levelSet(100, 80);
+
+    // Perturb the signed distance function so that reinitialisation
+    // changes it.
+    std::vector<double> signedDistance = levelSet.signedDistance;
+    for (unsigned int i=0;i<signedDistance.size();i++)
+        signedDistance[i] *= 1.5;
+
+    // Set the velocity of every node to a smoothly varying value.
+    std::vector<double> velocity(levelSet.mesh.nNodes);
+    for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
+        velocity[i] = sin(0.1*levelSet.mesh.nodeCoord(i).x) + cos(0.07*levelSet.mesh.nodeCoord(i).y);
+
+    // The width of the narrow band.
+    double bandWidth = 6;
+
+    // Initialise the fast marching method object.
+    slsm::FastMarchingMethod fmm(levelSet.mesh);
+
+    // Reinitialise and extend velocities in a single pass.
+    std::vector<double> fused = signedDistance;
+    std::vector<double> fusedVelocity = velocity;
+    std::vector<unsigned int> fusedBand;
+    fmm.march(fused, fusedVelocity, bandWidth, fusedBand);
+
+    // Reinitialise, recording the upwind dependencies, then replay them.
+    std::vector<double> recorded = signedDistance;
+    std::vector<double> replayedVelocity = velocity;
+    std::vector<unsigned int> recordedBand;
+    fmm.march(recorded, bandWidth, recordedBand, std::numeric_limits<double>::max(), true);
+    fmm.replay(replayedVelocity);
+
+    // Whether each node lies in the narrow band, away from the boundary.
+    std::vector<bool> isInterior(levelSet.mesh.nNodes, false);
+    for (unsigned int i=0;i<recordedBand.size();i++)
+    {
+        unsigned int node = recordedBand[i];
+        isInterior[node] = true;
+
+        // Nodes adjacent to the zero contour are frozen at the outset.
+        for (unsigned int j=0;j<4;j++)
+        {
+            unsigned int neighbour = levelSet.mesh.neighbour(node, j);
+
+            if ((neighbour != levelSet.mesh.nNodes) && ((signedDistance[node] * signedDistance[neighbour]) <= 0))
+                isInterior[node] = false;
+        }
+    }
+
+    // Set error number.
+    errno = 0;
+
+    // The signed distance function and narrow band are the same.
+    slsm_check((recorded == fused), "Signed distance mismatch!");
+    slsm_check((recordedBand == fusedBand), "Narrow band mismatch!");
+
+    for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
+    {
+        // Replayed velocities match those of the single pass, other nodes
+        // are unchanged.
+        if (isInterior[i])
+        {
+            slsm_check((replayedVelocity[i] == fusedVelocity[i]), "Velocity mismatch!");
+        }
+        else if (std::abs(fused[i]) >= bandWidth)
+        {
+            slsm_check((replayedVelocity[i] == velocity[i]), "Far field velocity changed!");
+        }
+    }
+
+    return 0;
+
+error:
+    return 1;
+}
+
 int all_tests()
 {
     mu_suite_start();
 
     mu_run_test(testUpwindFiniteDifference);
+    mu_run_test(testReuse);
+    mu_run_test(testUntidyQueue);
+    mu_run_test(testCutOff);
+    mu_run_test(testReplay);
 
     return 0;
 }
@@ -0,0 +1,149 @@
+/*
+  Copyright (c) 2015-2017 Lester Hedges <lester.hedges+slsm@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "slsm.h"
+
+int testPlanarInterface()
+{
+    // A test that the fast sweeping method is exact for a planar interface
+    // aligned with the grid.
+
+    // Create an empty vector of holes (just to pass to constructor).
+    std::vector<slsm::Hole> holes;
+
+    // Initialise a 40x30 level set domain.
+    slsm::LevelSet levelSet(40, 30, holes);
+
+    // Set a scaled planar signed distance function.
+    for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
+        levelSet.signedDistance[i] = 1.5*(levelSet.mesh.nodeCoord(i).x - 10.25);
+
+    // Reinitialise the signed distance function.
+    slsm::FastSweepingMethod fsm(levelSet.mesh);
+    unsigned int nCycles = fsm.march(levelSet.signedDistance);
+
+    // Set error number.
+    errno = 0;
+
+    // Check signed distance against expected values.
+    for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
+    {
+        double expected = levelSet.mesh.nodeCoord(i).x - 10.25;
+        slsm_check((std::abs(levelSet.signedDistance[i] - expected) < 1e-12), "Signed distance mismatch!");
+    }
+
+    // A single cycle finds the solution, the second confirms convergence.
+    slsm_check((nCycles == 2), "Incorrect number of cycles!");
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int testFastMarching()
+{
+    // A test that the fast sweeping method is close to the fast marching method.
+
+    // Initialise a 100x80 level set domain.
+    slsm::LevelSet levelSet(100, 80);
+
+    // Perturb the signed distance function so that reinitialisation
+    // changes it.
+    std::vector<double> marching = levelSet.signedDistance;
+    for (unsigned int i=0;i<marching.size();i++)
+        marching[i] *= 1.5;
+    std::vector<double> sweeping = marching;
+
+    // Reinitialise using each method.
+    slsm::FastMarchingMethod(levelSet.mesh).march(marching);
+    slsm::FastSweepingMethod(levelSet.mesh).march(sweeping);
+
+    // Set error number.
+    errno = 0;
+
+    // Compare the solutions within the narrow band. The fast sweeping method
+    // is first order, so differences are largest where characteristics meet.
+    double meanDiff = 0;
+    unsigned int nBand = 0;
+    for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
+    {
+        if (std::abs(marching[i]) < 6)
+        {
+            double diff = std::abs(sweeping[i] - marching[i]);
+            slsm_check((diff < 1), "Signed distance mismatch!");
+            slsm_check(((sweeping[i] * marching[i]) >= 0), "Sign mismatch!");
+            meanDiff += diff;
+            nBand++;
+        }
+    }
+    meanDiff /= nBand;
+
+    slsm_check((meanDiff < 0.05), "Mean signed distance mismatch!");
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int testNarrowBand()
+{
+    // A test that the narrow band is rebuilt when reinitialising the level
+    // set using the fast sweeping method.
+
+    // Initialise a 100x80 level set domain.
+    slsm::LevelSet levelSet(100, 80);
+    levelSet.eikonalSolver = slsm::EikonalSolver::FAST_SWEEPING;
+
+    // Perturb the signed distance function and reinitialise.
+    for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
+        levelSet.signedDistance[i] *= 1.5;
+    levelSet.reinitialise();
+
+    // Set error number.
+    errno = 0;
+
+    // Check that the narrow band contains exactly the nodes within the band width.
+    unsigned int nNarrowBand = 0;
+    for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
+    {
+        bool isInBand = (std::abs(levelSet.signedDistance[i]) < 6);
+        slsm_check((levelSet.mesh.isActive[i] == isInBand), "Narrow band mismatch!");
+        if (isInBand) nNarrowBand++;
+    }
+
+    slsm_check((levelSet.nNarrowBand == nNarrowBand), "Incorrect narrow band size!");
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(testPlanarInterface);
+    mu_run_test(testFastMarching);
+    mu_run_test(testNarrowBand);
+
+    return 0;
+}
+
+RUN_TESTS(all_tests);
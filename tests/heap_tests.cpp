@@ -148,6 +148,40 @@ error:
     return 1;
 }
 
+int testClear()
+{
+    // Initialise heap.
+    slsm::Heap heap(10, true);
+
+    // Set error number.
+    errno = 0;
+
+    // Fill and empty the heap several times.
+    for (int i=0;i<3;i++)
+    {
+        for (int j=0;j<10;j++)
+            heap.push(j, 10 - j);
+
+        // Remove all entries from the heap.
+        heap.clear();
+
+        // Check that the heap is empty.
+        slsm_check(heap.empty(), "Heap clear: heap is not empty!");
+    }
+
+    // Check that the heap still works.
+    for (int i=0;i<10;i++)
+        heap.push(i, i + 1);
+
+    slsm_check(heap.size() == 10, "Heap clear: incorrect heap size!");
+    slsm_check(heap.peek() == 1, "Heap clear: incorrect value at top of heap!");
+
+    return 0;
+
+error:
+    return 1;
+}
+
 int all_tests()
 {
     mu_suite_start();
@@ -155,6 +189,7 @@ int all_tests()
     mu_run_test(testPush);
     mu_run_test(testPop);
     mu_run_test(testSet);
+    mu_run_test(testClear);
 
     return 0;
 }
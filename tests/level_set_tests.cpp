@@ -88,11 +88,442 @@ error:
     return 1;
 }
 
+int testTileDecomposition()
+{
+    // A test that the velocities and gradients don't depend on how the
+    // mesh is partitioned into tiles.
+
+    // Initialise two 150x100 level set domains.
+    slsm::LevelSet levelSet(150, 100);
+    slsm::LevelSet tiledLevelSet(150, 100);
+
+    // Partition the second mesh into small, non-square tiles.
+    tiledLevelSet.mesh.initialiseTiles(7, 5);
+
+    // Initialise the boundary objects.
+    slsm::Boundary boundary;
+    slsm::Boundary tiledBoundary;
+
+    boundary.discretise(levelSet);
+    tiledBoundary.discretise(tiledLevelSet);
+
+    // Assign a spatially varying velocity to the boundary points.
+    for (unsigned int i=0;i<boundary.nPoints;i++)
+    {
+        boundary.points[i].velocity = sin(0.1*boundary.points[i].coord.x) + cos(0.2*boundary.points[i].coord.y);
+        tiledBoundary.points[i].velocity = boundary.points[i].velocity;
+    }
+
+    levelSet.computeVelocities(boundary.points);
+    tiledLevelSet.computeVelocities(tiledBoundary.points);
+
+    levelSet.computeGradients();
+    tiledLevelSet.computeGradients();
+
+    levelSet.update(0.5);
+    tiledLevelSet.update(0.5);
+
+    // Set error number.
+    errno = 0;
+
+    // Check that the results are identical.
+    for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
+    {
+        slsm_check((levelSet.velocity[i] == tiledLevelSet.velocity[i]), "Velocity mismatch!");
+        slsm_check((levelSet.gradient[i] == tiledLevelSet.gradient[i]), "Gradient mismatch!");
+        slsm_check((levelSet.signedDistance[i] == tiledLevelSet.signedDistance[i]), "Signed distance mismatch!");
+    }
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int testVectorisedGradient()
+{
+    // A test that the vectorised WENO gradient kernel agrees with the scalar one.
+
+    // Number of stencils.
+    const unsigned int n = 1000;
+
+    // Stencil values, stored by stencil point.
+    std::vector<std::vector<double> > v(5, std::vector<double>(n));
+
+    // Vectorised gradient approximations.
+    std::vector<double> grad(n);
+
+    // Initialise random number generator.
+    slsm::MersenneTwister rng;
+
+    // Generate random stencils. Use an offset linear ramp for every fourth
+    // stencil so that the smooth, equally weighted case is also tested.
+    for (unsigned int i=0;i<n;i++)
+    {
+        for (unsigned int j=0;j<5;j++)
+        {
+            if (i % 4 == 0) v[j][i] = 0.5*i + j;
+            else v[j][i] = 6*rng() - 3;
+        }
+    }
+
+    slsm::LevelSet::gradHJWENO(&v[0][0], &v[1][0], &v[2][0], &v[3][0], &v[4][0], &grad[0], n);
+
+    // Set error number.
+    errno = 0;
+
+    // Check that the results agree to within floating point tolerance, since
+    // the compiler is allowed to contract operations when vectorising.
+    for (unsigned int i=0;i<n;i++)
+    {
+        double scalar = slsm::LevelSet::gradHJWENO(v[0][i], v[1][i], v[2][i], v[3][i], v[4][i]);
+        slsm_check((std::abs(grad[i] - scalar) < 1e-12*(1 + std::abs(scalar))), "Gradient mismatch!");
+    }
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int testWorkspaceReuse()
+{
+    // A test that the scratch space reused between velocity calculations
+    // doesn't leak state from one call to the next.
+
+    // Initialise two 150x100 level set domains.
+    slsm::LevelSet levelSet(150, 100);
+    slsm::LevelSet freshLevelSet(150, 100);
+
+    // Initialise the boundary object.
+    slsm::Boundary boundary;
+    boundary.discretise(levelSet);
+
+    // Compute velocities for a uniform boundary velocity.
+    for (unsigned int i=0;i<boundary.nPoints;i++)
+        boundary.points[i].velocity = 1.0;
+    levelSet.computeVelocities(boundary.points);
+
+    // Now assign a spatially varying velocity to the boundary points.
+    for (unsigned int i=0;i<boundary.nPoints;i++)
+        boundary.points[i].velocity = sin(0.1*boundary.points[i].coord.x) + cos(0.2*boundary.points[i].coord.y);
+
+    levelSet.computeVelocities(boundary.points);
+    freshLevelSet.computeVelocities(boundary.points);
+
+    // Set error number.
+    errno = 0;
+
+    // Check that the results are identical.
+    for (unsigned int i=0;i<levelSet.mesh.nNodes;i++)
+        slsm_check((levelSet.velocity[i] == freshLevelSet.velocity[i]), "Velocity mismatch!");
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int testNarrowBandUpdate()
+{
+    // A test that the narrow band, which is updated from the nodes frozen
+    // during reinitialisation, matches a search of the whole mesh.
+
+    // Place a single hole in the centre of the mesh, so that the narrow
+    // band is a small fraction of the domain.
+    std::vector<slsm::Hole> holes;
+    holes.push_back(slsm::Hole(200, 200, 50));
+
+    // Initialise a 400x400 level set domain with a narrow band of width 6.
+    slsm::LevelSet levelSet(400, 400, holes, 0.5, 6);
+
+    // Initialise the boundary object.
+    slsm::Boundary boundary;
+
+    // Set error number.
+    errno = 0;
+
+    for (unsigned int i=0;i<5;i++)
+    {
+        // Move the boundary outwards.
+        boundary.discretise(levelSet);
+        for (unsigned int j=0;j<boundary.nPoints;j++)
+            boundary.points[j].velocity = 1.0;
+
+        levelSet.computeVelocities(boundary.points);
+        levelSet.computeGradients();
+        levelSet.update(1.0);
+
+        // Rebuild the narrow band.
+        levelSet.reinitialise();
+
+        // The number of narrow band nodes and mines.
+        unsigned int nNarrowBand = 0;
+        unsigned int nMines = 0;
+
+        // Search the whole mesh.
+        for (unsigned int j=0;j<levelSet.mesh.nNodes;j++)
+        {
+            double absoluteSignedDistance = std::abs(levelSet.signedDistance[j]);
+
+            bool isActive = (absoluteSignedDistance < 6);
+            bool isMine = isActive && (absoluteSignedDistance > 5);
+
+            slsm_check((levelSet.mesh.isActive[j] == isActive), "Narrow band mismatch!");
+            slsm_check((levelSet.mesh.isMine[j] == isMine), "Mine mismatch!");
+
+            // The bands are stored in index order.
+            if (isActive)
+            {
+                slsm_check((levelSet.narrowBand[nNarrowBand] == j), "Narrow band mismatch!");
+                nNarrowBand++;
+            }
+            if (isMine)
+            {
+                slsm_check((levelSet.mines[nMines] == j), "Mine mismatch!");
+                nMines++;
+            }
+        }
+
+        slsm_check((levelSet.nNarrowBand == nNarrowBand), "Narrow band size mismatch!");
+        slsm_check((levelSet.nMines == nMines), "Number of mines mismatch!");
+    }
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int testHoleInitialisation()
+{
+    // A test that the spatially binned hole initialisation and masking
+    // agree with a brute-force search over all holes.
+
+    // Initialise random number generator.
+    slsm::MersenneTwister rng;
+
+    // Generate a random arrangement of holes of varying size, some of
+    // which overlap each other or the domain boundary.
+    std::vector<slsm::Hole> holes;
+    for (unsigned int i=0;i<300;i++)
+        holes.push_back(slsm::Hole(-10 + 220*rng(), -10 + 170*rng(), 1 + 8*rng()));
+
+    // Set error number.
+    errno = 0;
+
+    for (unsigned int i=0;i<2;i++)
+    {
+        slsm::NodeOrdering::NodeOrdering ordering =
+            (i == 0) ? slsm::NodeOrdering::ROW_MAJOR : slsm::NodeOrdering::TILED;
+
+        // Initialise a 200x150 level set domain.
+        slsm::LevelSet levelSet(200, 150, holes, 0.5, 6, false, false, ordering);
+
+        // Mask off the first ten holes.
+        std::vector<slsm::Hole> maskHoles(holes.begin(), holes.begin() + 10);
+        slsm::LevelSet maskedLevelSet(200, 150, 0.5, 6, false, false, ordering);
+        maskedLevelSet.mask(maskHoles);
+
+        for (unsigned int j=0;j<levelSet.mesh.nNodes;j++)
+        {
+            slsm::Coord coord = levelSet.mesh.nodeCoord(j);
+
+            // Distance to the closest domain boundary.
+            double signedDistance = std::min(std::min(coord.x, 200 - coord.x),
+                                             std::min(coord.y, 150 - coord.y));
+
+            // Test the node against every hole.
+            for (unsigned int k=0;k<holes.size();k++)
+            {
+                double dx = holes[k].coord.x - coord.x;
+                double dy = holes[k].coord.y - coord.y;
+                double dist = sqrt(dx*dx + dy*dy) - holes[k].r;
+
+                if (dist < signedDistance) signedDistance = dist;
+            }
+
+            slsm_check((levelSet.signedDistance[j] == signedDistance), "Signed distance mismatch!");
+
+            // Test the node against every masking hole.
+            bool isMasked = false;
+            for (unsigned int k=0;k<maskHoles.size();k++)
+            {
+                double dx = maskHoles[k].coord.x - coord.x;
+                double dy = maskHoles[k].coord.y - coord.y;
+
+                if (sqrt(dx*dx + dy*dy) < maskHoles[k].r) isMasked = true;
+            }
+
+            slsm_check((maskedLevelSet.mesh.isMasked[j] == isMasked), "Masked node mismatch!");
+        }
+    }
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int testPolygonInitialisation()
+{
+    // A test that the polygon initialisation and masking, which use a
+    // segment hierarchy and scan conversion, agree with testing every node
+    // against every segment.
+
+    // Initialise random number generator.
+    slsm::MersenneTwister rng;
+
+    // Generate a random star shaped polygon, which is closed and ordered.
+    // Some vertices lie exactly on rows of nodes, or outside the domain.
+    std::vector<slsm::Coord> points;
+    for (unsigned int i=0;i<500;i++)
+    {
+        double theta = 2*M_PI*i / 500;
+        double r = 20 + 70*rng();
+
+        if (i % 10 == 0)
+            points.push_back(slsm::Coord(100 + r*cos(theta), std::round(80 + r*sin(theta))));
+        else
+            points.push_back(slsm::Coord(100 + r*cos(theta), 80 + r*sin(theta)));
+    }
+    points.push_back(points[0]);
+
+    // Set error number.
+    errno = 0;
+
+    for (unsigned int i=0;i<2;i++)
+    {
+        slsm::NodeOrdering::NodeOrdering ordering =
+            (i == 0) ? slsm::NodeOrdering::ROW_MAJOR : slsm::NodeOrdering::TILED;
+
+        // Initialise a 200x150 level set domain.
+        slsm::LevelSet levelSet(200, 150, points, 0.5, 6, false, false, ordering);
+
+        // Mask off the polygon.
+        slsm::LevelSet maskedLevelSet(200, 150, 0.5, 6, false, false, ordering);
+        maskedLevelSet.mask(points);
+
+        for (unsigned int j=0;j<levelSet.mesh.nNodes;j++)
+        {
+            slsm::Coord coord = levelSet.mesh.nodeCoord(j);
+
+            // Distance to the closest domain boundary.
+            double signedDistance = std::min(std::min(coord.x, 200 - coord.x),
+                                             std::min(coord.y, 150 - coord.y));
+
+            // Winding number of the node.
+            int windingNumber = 0;
+
+            // Test the node against every segment.
+            for (unsigned int k=0;k<points.size()-1;k++)
+            {
+                const slsm::Coord& v1 = points[k];
+                const slsm::Coord& v2 = points[k+1];
+
+                double dx = v2.x - v1.x;
+                double dy = v2.y - v1.y;
+                double t = ((coord.x - v1.x)*dx + (coord.y - v1.y)*dy) / (dx*dx + dy*dy);
+                t = std::max(0.0, std::min(1.0, t));
+
+                double x = v1.x + t*dx - coord.x;
+                double y = v1.y + t*dy - coord.y;
+                double dist = sqrt(x*x + y*y);
+
+                if (dist < signedDistance) signedDistance = dist;
+
+                int isLeft = (v2.x - v1.x)*(coord.y - v1.y) - (coord.x - v1.x)*(v2.y - v1.y);
+
+                if ((v1.y <= coord.y) && (v2.y > coord.y) && (isLeft > 0)) windingNumber++;
+                if ((v1.y > coord.y) && (v2.y <= coord.y) && (isLeft < 0)) windingNumber--;
+            }
+
+            if (windingNumber != 0) signedDistance *= -1;
+
+            slsm_check((levelSet.signedDistance[j] == signedDistance), "Signed distance mismatch!");
+            slsm_check((maskedLevelSet.mesh.isMasked[j] == (windingNumber != 0)), "Masked node mismatch!");
+        }
+    }
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int testFusedReinitialisation()
+{
+    // A test that reinitialising the signed distance function during
+    // velocity extension gives the same result as separate passes.
+
+    // Initialise two 150x100 level set domains.
+    slsm::LevelSet levelSet(150, 100);
+    slsm::LevelSet fusedLevelSet(150, 100);
+
+    // Initialise the boundary object.
+    slsm::Boundary boundary;
+
+    // Set error number.
+    errno = 0;
+
+    for (unsigned int i=0;i<3;i++)
+    {
+        boundary.discretise(levelSet);
+
+        // Assign a spatially varying velocity to the boundary points.
+        for (unsigned int j=0;j<boundary.nPoints;j++)
+            boundary.points[j].velocity = sin(0.1*boundary.points[j].coord.x) + cos(0.2*boundary.points[j].coord.y);
+
+        // Separate velocity extension and reinitialisation.
+        levelSet.computeVelocities(boundary.points);
+        std::vector<double> velocity = levelSet.velocity;
+        levelSet.reinitialise();
+
+        // Combined velocity extension and reinitialisation.
+        fusedLevelSet.computeVelocities(boundary.points, true);
+
+        // The signed distance function must be identical.
+        for (unsigned int j=0;j<levelSet.mesh.nNodes;j++)
+            slsm_check((levelSet.signedDistance[j] == fusedLevelSet.signedDistance[j]), "Signed distance mismatch!");
+
+        // As must the narrow band.
+        slsm_check((levelSet.nNarrowBand == fusedLevelSet.nNarrowBand), "Narrow band size mismatch!");
+        for (unsigned int j=0;j<levelSet.nNarrowBand;j++)
+            slsm_check((levelSet.narrowBand[j] == fusedLevelSet.narrowBand[j]), "Narrow band mismatch!");
+
+        // Velocities can only differ towards the edge of the narrow band,
+        // where the separate velocity extension pass stops.
+        for (unsigned int j=0;j<levelSet.mesh.nNodes;j++)
+        {
+            if (std::abs(levelSet.signedDistance[j]) < 4)
+                slsm_check((std::abs(velocity[j] - fusedLevelSet.velocity[j]) < 1e-10), "Velocity mismatch!");
+        }
+
+        // Move the boundary.
+        levelSet.computeGradients();
+        levelSet.update(0.5);
+        fusedLevelSet.computeGradients();
+        fusedLevelSet.update(0.5);
+    }
+
+    return 0;
+
+error:
+    return 1;
+}
+
 int all_tests()
 {
     mu_suite_start();
 
     mu_run_test(testSignedDistance);
+    mu_run_test(testTileDecomposition);
+    mu_run_test(testVectorisedGradient);
+    mu_run_test(testWorkspaceReuse);
+    mu_run_test(testNarrowBandUpdate);
+    mu_run_test(testHoleInitialisation);
+    mu_run_test(testPolygonInitialisation);
+    mu_run_test(testFusedReinitialisation);
 
     return 0;
 }
@@ -232,6 +232,308 @@ error:
     return 1;
 }
 
+int testImplicitConnectivity()
+{
+    // Initialise a 3x4 mesh with stored connectivity.
+    slsm::Mesh mesh(3, 4);
+
+    // Initialise a 3x4 mesh with implicit connectivity.
+    slsm::Mesh imMesh(3, 4, true);
+
+    // Set error number.
+    errno = 0;
+
+    // Check that all node data matches.
+    for (unsigned int i=0;i<mesh.nNodes;i++)
+    {
+        slsm_check(imMesh.nodeCoord(i).x == mesh.nodeCoord(i).x, "Implicit mesh: Node x coordinate is incorrect!");
+        slsm_check(imMesh.nodeCoord(i).y == mesh.nodeCoord(i).y, "Implicit mesh: Node y coordinate is incorrect!");
+        slsm_check(imMesh.isDomain(i) == mesh.isDomain(i), "Implicit mesh: Domain flag is incorrect!");
+        slsm_check(imMesh.nNodeElements(i) == mesh.nNodeElements(i), "Implicit mesh: Number of node elements is incorrect!");
+
+        for (unsigned int j=0;j<4;j++)
+            slsm_check(imMesh.neighbour(i, j) == mesh.neighbour(i, j), "Implicit mesh: Neighbour is incorrect!");
+
+        for (unsigned int j=0;j<mesh.nNodeElements(i);j++)
+            slsm_check(imMesh.nodeElement(i, j) == mesh.nodeElement(i, j), "Implicit mesh: Node element is incorrect!");
+    }
+
+    // Check that all element data matches.
+    for (unsigned int i=0;i<mesh.nElements;i++)
+    {
+        slsm_check(imMesh.elementCoord(i).x == mesh.elementCoord(i).x, "Implicit mesh: Element x coordinate is incorrect!");
+        slsm_check(imMesh.elementCoord(i).y == mesh.elementCoord(i).y, "Implicit mesh: Element y coordinate is incorrect!");
+
+        for (unsigned int j=0;j<4;j++)
+            slsm_check(imMesh.elementNode(i, j) == mesh.elementNode(i, j), "Implicit mesh: Element node is incorrect!");
+    }
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int testTiledOrdering()
+{
+    // Initialise a 40x20 mesh with row-major ordering.
+    slsm::Mesh mesh(40, 20);
+
+    // Initialise 40x20 meshes with tiled ordering (partial tiles at the edges).
+    slsm::Mesh tiledMesh(40, 20, false, slsm::NodeOrdering::TILED);
+    slsm::Mesh imTiledMesh(40, 20, true, slsm::NodeOrdering::TILED);
+
+    // Whether each node index has been visited.
+    std::vector<bool> isVisited(mesh.nNodes, false);
+
+    // Set error number.
+    errno = 0;
+
+    // Check that the tiled numbering is a permutation of the node indices.
+    for (unsigned int y=0;y<=mesh.height;y++)
+    {
+        for (unsigned int x=0;x<=mesh.width;x++)
+        {
+            unsigned int node = tiledMesh.xyToIndex(x, y);
+
+            slsm_check(node < mesh.nNodes, "Tiled mesh: Node index is out of range!");
+            slsm_check(!isVisited[node], "Tiled mesh: Node index is repeated!");
+            isVisited[node] = true;
+
+            unsigned int xx, yy;
+            tiledMesh.indexToXY(node, xx, yy);
+            slsm_check((xx == x) && (yy == y), "Tiled mesh: Inverse mapping is incorrect!");
+        }
+    }
+
+    // Check that the topology matches the row-major mesh.
+    for (unsigned int i=0;i<mesh.nNodes;i++)
+    {
+        unsigned int x = mesh.nodeCoord(i).x;
+        unsigned int y = mesh.nodeCoord(i).y;
+        unsigned int node = tiledMesh.xyToIndex(x, y);
+
+        slsm_check(tiledMesh.nodeCoord(node).x == x, "Tiled mesh: Node x coordinate is incorrect!");
+        slsm_check(tiledMesh.nodeCoord(node).y == y, "Tiled mesh: Node y coordinate is incorrect!");
+        slsm_check(tiledMesh.isDomain(node) == mesh.isDomain(i), "Tiled mesh: Domain flag is incorrect!");
+        slsm_check(tiledMesh.nNodeElements(node) == mesh.nNodeElements(i), "Tiled mesh: Number of node elements is incorrect!");
+
+        for (unsigned int j=0;j<4;j++)
+        {
+            unsigned int neighbour = mesh.neighbour(i, j);
+            unsigned int expected = (neighbour == mesh.nNodes) ? mesh.nNodes :
+                tiledMesh.xyToIndex(mesh.nodeCoord(neighbour).x, mesh.nodeCoord(neighbour).y);
+
+            slsm_check(tiledMesh.neighbour(node, j) == expected, "Tiled mesh: Neighbour is incorrect!");
+            slsm_check(imTiledMesh.neighbour(node, j) == expected, "Implicit tiled mesh: Neighbour is incorrect!");
+        }
+
+        for (unsigned int j=0;j<mesh.nNodeElements(i);j++)
+        {
+            slsm_check(tiledMesh.nodeElement(node, j) == mesh.nodeElement(i, j), "Tiled mesh: Node element is incorrect!");
+            slsm_check(imTiledMesh.nodeElement(node, j) == mesh.nodeElement(i, j), "Implicit tiled mesh: Node element is incorrect!");
+        }
+    }
+
+    // Check the element to node connectivity.
+    for (unsigned int i=0;i<mesh.nElements;i++)
+    {
+        for (unsigned int j=0;j<4;j++)
+        {
+            unsigned int node = tiledMesh.elementNode(i, j);
+
+            slsm_check(tiledMesh.nodeCoord(node).x == mesh.nodeCoord(mesh.elementNode(i, j)).x,
+                "Tiled mesh: Element node is incorrect!");
+            slsm_check(tiledMesh.nodeCoord(node).y == mesh.nodeCoord(mesh.elementNode(i, j)).y,
+                "Tiled mesh: Element node is incorrect!");
+            slsm_check(imTiledMesh.elementNode(i, j) == node, "Implicit tiled mesh: Element node is incorrect!");
+        }
+    }
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int testSharedTopology()
+{
+    // A test that the topology is shared between meshes of the same geometry,
+    // while the state of each mesh is independent.
+
+    // Initialise a pair of 100x100 meshes.
+    slsm::Mesh mesh1(100, 100);
+    slsm::Mesh mesh2(100, 100);
+
+    // Initialise meshes with different geometry.
+    slsm::Mesh tiledMesh(100, 100, false, slsm::NodeOrdering::TILED);
+    slsm::Mesh wideMesh(120, 100);
+
+    // Set error number.
+    errno = 0;
+
+    // Check that the topology is shared.
+    slsm_check(mesh1.sharesTopology(mesh2), "Topology is not shared!");
+    slsm_check(!mesh1.sharesTopology(tiledMesh), "Topology is shared across node orderings!");
+    slsm_check(!mesh1.sharesTopology(wideMesh), "Topology is shared across mesh sizes!");
+
+    {
+        // Copies of a level set share the topology too.
+        slsm::LevelSet levelSet(100, 100);
+        slsm::LevelSet levelSetCopy(levelSet);
+        slsm_check(levelSet.mesh.sharesTopology(mesh1), "Level set topology is not shared!");
+        slsm_check(levelSetCopy.mesh.sharesTopology(mesh1), "Level set topology is not shared!");
+    }
+
+    // Check that the state is independent.
+    mesh1.isMasked[5] = true;
+    mesh1.area[3] = 0.5;
+    slsm_check(!mesh2.isMasked[5], "Node state is shared!");
+    slsm_check(mesh2.area[3] == 0, "Element state is shared!");
+
+    // Check that the shared connectivity is correct.
+    for (unsigned int i=0;i<mesh1.nNodes;i++)
+    {
+        for (unsigned int j=0;j<4;j++)
+            slsm_check(mesh1.neighbour(i, j) == mesh2.neighbour(i, j), "Neighbour mismatch!");
+    }
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int testTiles()
+{
+    // A test that the tiles partition the mesh nodes, with correct halos.
+
+    // Initialise a 20x11 mesh.
+    slsm::Mesh mesh(20, 11);
+
+    // Partition the mesh into 6x4 tiles with a halo of width 2.
+    mesh.initialiseTiles(6, 4, 2);
+
+    // The number of tiles that own each node.
+    std::vector<unsigned int> nOwners(mesh.nNodes, 0);
+
+    // Set error number.
+    errno = 0;
+
+    // Check the number of tiles (nodes run from 0 to 20 in x, and 0 to 11 in y).
+    slsm_check(mesh.nTilesX == 4, "Incorrect number of tiles in x!");
+    slsm_check(mesh.nTilesY == 3, "Incorrect number of tiles in y!");
+    slsm_check(mesh.nTiles == 12, "Incorrect number of tiles!");
+
+    for (unsigned int i=0;i<mesh.nTiles;i++)
+    {
+        const slsm::Tile& tile = mesh.tiles[i];
+
+        // Check the halo.
+        slsm_check(tile.haloXMin == ((tile.xMin > 2) ? (tile.xMin - 2) : 0), "Incorrect halo!");
+        slsm_check(tile.haloYMin == ((tile.yMin > 2) ? (tile.yMin - 2) : 0), "Incorrect halo!");
+        slsm_check(tile.haloXMax == std::min(tile.xMax + 2, mesh.width + 1), "Incorrect halo!");
+        slsm_check(tile.haloYMax == std::min(tile.yMax + 2, mesh.height + 1), "Incorrect halo!");
+
+        for (unsigned int y=tile.yMin;y<tile.yMax;y++)
+        {
+            for (unsigned int x=tile.xMin;x<tile.xMax;x++)
+            {
+                slsm_check(mesh.xyToTile(x, y) == i, "Incorrect tile index!");
+                nOwners[mesh.xyToIndex(x, y)]++;
+            }
+        }
+    }
+
+    // Check that each node is owned by exactly one tile.
+    for (unsigned int i=0;i<mesh.nNodes;i++)
+        slsm_check(nOwners[i] == 1, "Node %d is owned by %d tiles!", i, nOwners[i]);
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int testGradientStencils()
+{
+    // A test that the WENO stencils of interior and edge nodes are correct.
+
+    // Initialise a 20x11 mesh with tiled ordering.
+    slsm::Mesh mesh(20, 11, false, slsm::NodeOrdering::TILED);
+
+    // Offsets of the first node of each difference relative to the node,
+    // for the right and left directions (the same holds for up and down).
+    int offsets[2][5] = {{3, 2, 1, 0, -1}, {-2, -1, 0, 1, 2}};
+
+    // Set error number.
+    errno = 0;
+
+    for (unsigned int y=0;y<=mesh.height;y++)
+    {
+        for (unsigned int x=0;x<=mesh.width;x++)
+        {
+            bool isInterior = (x >= 3) && (x <= mesh.width - 3) && (y >= 3) && (y <= mesh.height - 3);
+            slsm_check(mesh.isInteriorNode(x, y) == isInterior, "Incorrect interior node!");
+
+            if (isInterior)
+            {
+                unsigned int row[7], column[7];
+                mesh.interiorStencil(x, y, row, column);
+
+                for (unsigned int i=0;i<7;i++)
+                {
+                    slsm_check(row[i] == mesh.xyToIndex(x + i - 3, y), "Incorrect interior stencil!");
+                    slsm_check(column[i] == mesh.xyToIndex(x, y + i - 3), "Incorrect interior stencil!");
+                }
+            }
+            else
+            {
+                const unsigned int* pairs = mesh.edgeStencil(x, y);
+
+                for (unsigned int i=0;i<4;i++)
+                {
+                    // Coordinate along the direction, and its maximum.
+                    int c = (i < 2) ? x : y;
+                    int n = (i < 2) ? mesh.width : mesh.height;
+
+                    for (unsigned int j=0;j<5;j++)
+                    {
+                        slsm::Coord first = mesh.nodeCoord(pairs[10*i + 2*j]);
+                        slsm::Coord second = mesh.nodeCoord(pairs[10*i + 2*j + 1]);
+
+                        // Each difference is between neighbouring nodes in the
+                        // row or column through the node.
+                        if (i < 2)
+                        {
+                            slsm_check(first.y == y && second.y == y, "Incorrect edge stencil!");
+                            slsm_check(first.x == second.x + 1, "Incorrect edge stencil!");
+                        }
+                        else
+                        {
+                            slsm_check(first.x == x && second.x == x, "Incorrect edge stencil!");
+                            slsm_check(first.y == second.y + 1, "Incorrect edge stencil!");
+                        }
+
+                        // Differences inside the domain are the standard ones.
+                        int position = c + offsets[i % 2][j];
+                        if ((position >= 1) && (position <= n))
+                        {
+                            double coord = (i < 2) ? first.x : first.y;
+                            slsm_check(coord == position, "Incorrect edge stencil!");
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return 0;
+
+error:
+    return 1;
+}
+
 int all_tests()
 {
     mu_suite_start();
@@ -243,6 +545,11 @@ int all_tests()
     mu_run_test(testElementNodeConnectivity);
     mu_run_test(testNodeElementConnectivity);
     mu_run_test(testCoordinateMapping);
+    mu_run_test(testImplicitConnectivity);
+    mu_run_test(testTiledOrdering);
+    mu_run_test(testSharedTopology);
+    mu_run_test(testTiles);
+    mu_run_test(testGradientStencils);
 
     return 0;
 }
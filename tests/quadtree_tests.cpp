@@ -0,0 +1,163 @@
+/*
+  Copyright (c) 2015-2017 Lester Hedges <lester.hedges+slsm@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "slsm.h"
+
+int testDecomposition()
+{
+    // A test that the quadtree leaves tile the mesh, are refined around the
+    // zero contour, and that the coarse leaves lie on one side of the boundary.
+
+    // Push holes into vector containers.
+    std::vector<slsm::Hole> initialHoles;
+    std::vector<slsm::Hole> targetHoles;
+    initialHoles.push_back(slsm::Hole(150, 60, 15));
+    targetHoles.push_back(slsm::Hole(60, 60, 20.3));
+    targetHoles.push_back(slsm::Hole(140, 50, 12.7));
+
+    // Initialise a 200x120 level set domain.
+    slsm::LevelSet levelSet(200, 120, initialHoles, targetHoles);
+
+    // Build the quadtree for the target signed distance function.
+    slsm::Quadtree quadtree(levelSet.mesh, levelSet.target);
+
+    // The number of times that each element is covered by a leaf.
+    std::vector<unsigned int> nCovered(levelSet.mesh.nElements, 0);
+
+    // Whether each element is refined.
+    std::vector<bool> isRefined(levelSet.mesh.nElements, false);
+
+    // Set error number.
+    errno = 0;
+
+    // Check the size of the root cell.
+    slsm_check((quadtree.rootSize == 256), "Incorrect root cell size!");
+
+    // Check that the tree is coarsened away from the boundary.
+    slsm_check((quadtree.nCells < levelSet.mesh.nElements/2), "Quadtree is not coarsened!");
+    slsm_check((quadtree.nRefined == quadtree.elements.size()), "Incorrect number of refined elements!");
+
+    for (unsigned int i=0;i<quadtree.nCells;i++)
+    {
+        const slsm::QuadtreeCell& cell = quadtree.cells[i];
+
+        if (cell.isRefined)
+            slsm_check((cell.size == 1), "Refined cell is not an element!");
+
+        for (unsigned int y=cell.y;y<std::min(cell.y + cell.size, levelSet.mesh.height);y++)
+        {
+            for (unsigned int x=cell.x;x<std::min(cell.x + cell.size, levelSet.mesh.width);x++)
+            {
+                unsigned int element = x + y*levelSet.mesh.width;
+
+                nCovered[element]++;
+                isRefined[element] = cell.isRefined;
+
+                if (!cell.isRefined)
+                {
+                    // Check that the nodes of the element lie on the same side of the boundary.
+                    for (unsigned int j=0;j<4;j++)
+                    {
+                        double sd = levelSet.target[levelSet.mesh.elementNode(element, j)];
+
+                        slsm_check((std::abs(sd) > 1e-6), "Coarse cell contains a boundary node!");
+                        slsm_check(((sd > 0) == (cell.status == slsm::ElementStatus::INSIDE)),
+                            "Coarse cell status mismatch!");
+                    }
+                }
+            }
+        }
+    }
+
+    // Check that every element is covered exactly once.
+    for (unsigned int i=0;i<levelSet.mesh.nElements;i++)
+        slsm_check((nCovered[i] == 1), "Element %d is covered by %d cells!", i, nCovered[i]);
+
+    // Check that the refined elements are sorted.
+    for (unsigned int i=0;i<quadtree.nRefined;i++)
+    {
+        slsm_check(isRefined[quadtree.elements[i]], "Element %d isn't refined!", quadtree.elements[i]);
+
+        if (i > 0)
+            slsm_check((quadtree.elements[i] > quadtree.elements[i-1]), "Refined elements aren't sorted!");
+    }
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int testTargetBoundary()
+{
+    // A test that discretising the target signed distance function using the
+    // quadtree finds the same boundary as the current signed distance function
+    // when the initial and target interfaces are the same.
+
+    // Push holes into a vector container.
+    std::vector<slsm::Hole> holes;
+    holes.push_back(slsm::Hole(60, 60, 20.3));
+    holes.push_back(slsm::Hole(140, 50, 12.7));
+
+    // Initialise a 200x120 level set domain.
+    slsm::LevelSet levelSet(200, 120, holes, holes);
+
+    // Reinitialise, so the signed distance function matches the target.
+    levelSet.reinitialise();
+
+    // Initialise the boundary objects.
+    slsm::Boundary boundary, target;
+
+    // Set error number.
+    errno = 0;
+
+    target.discretise(levelSet, true);
+    boundary.discretise(levelSet);
+
+    slsm_check((boundary.nPoints > 0), "There are no boundary points!");
+    slsm_check((target.nPoints == boundary.nPoints), "Number of boundary points doesn't match!");
+    slsm_check((target.nSegments == boundary.nSegments), "Number of boundary segments doesn't match!");
+
+    for (unsigned int i=0;i<boundary.nPoints;i++)
+    {
+        slsm_check((target.points[i].coord.x == boundary.points[i].coord.x) &&
+                   (target.points[i].coord.y == boundary.points[i].coord.y), "Boundary point mismatch!");
+    }
+
+    for (unsigned int i=0;i<boundary.nSegments;i++)
+    {
+        slsm_check((target.segments[i].start == boundary.segments[i].start) &&
+                   (target.segments[i].end == boundary.segments[i].end), "Boundary segment mismatch!");
+    }
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(testDecomposition);
+    mu_run_test(testTargetBoundary);
+
+    return 0;
+}
+
+RUN_TESTS(all_tests);
@@ -0,0 +1,208 @@
+/*
+  Copyright (c) 2015-2017 Lester Hedges <lester.hedges+slsm@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+
+#include "slsm.h"
+
+/* N.B.
+    Entries in the untidy queue are only ordered by bucket, so values
+    should be popped in ascending order to within the bucket width.
+ */
+
+int testPush()
+{
+    // Initialise queue.
+    slsm::UntidyQueue queue(10, 1);
+
+    // Set error number.
+    errno = 0;
+
+    // Add entries to the queue, each in a lower bucket than the last.
+    for (int i=0;i<10;i++)
+    {
+        double value = 10 - i;
+
+        // Push onto the queue.
+        queue.push(i, value);
+
+        // Check that queue size is correct.
+        slsm_check(queue.size() == unsigned(i + 1), "Queue push: incorrect queue size!");
+
+        // Check that the new value is at the front of the queue.
+        slsm_check(queue.peek() == value, "Queue push: incorrect value at front of queue!");
+    }
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int testPop()
+{
+    // Initialise random number generator.
+    slsm::MersenneTwister rng;
+
+    // The bucket width.
+    double width = 0.05;
+
+    // Initialise vector of doubles.
+    std::vector<double> vec(1000);
+
+    // Fill vector with random numbers.
+    for (unsigned int i=0;i<vec.size();i++)
+        vec[i] = rng();
+
+    // Initialise queue.
+    slsm::UntidyQueue queue(vec.size(), width);
+
+    // Push values onto the queue.
+    for (unsigned int i=0;i<vec.size();i++)
+        queue.push(i, vec[i]);
+
+    // Set error number.
+    errno = 0;
+
+    // Now pop off values.
+    double maxValue = 0;
+    for (unsigned int i=0;i<vec.size();i++)
+    {
+        unsigned int addr;
+        double value;
+
+        queue.pop(addr, value);
+
+        // Make sure that the address matches the value.
+        slsm_check(value == vec[addr], "Queue pop: incorrect address!");
+
+        // Make sure that values are in ascending order (to within a bucket).
+        slsm_check(value > maxValue - width, "Queue pop: incorrect order!");
+
+        maxValue = std::max(maxValue, value);
+    }
+
+    slsm_check(queue.empty(), "Queue pop: queue is not empty!");
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int testSet()
+{
+    // Initialise random number generator.
+    slsm::MersenneTwister rng;
+
+    // Initialise vector of doubles.
+    std::vector<double> vec(10);
+
+    // Fill vector with random numbers.
+    for (unsigned int i=0;i<vec.size();i++)
+        vec[i] = 1 + rng();
+
+    // Initialise queue.
+    slsm::UntidyQueue queue(vec.size(), 0.1);
+
+    // Initialise back pointer array.
+    std::vector<unsigned int> queuePtr(vec.size());
+
+    // Push values onto the queue.
+    for (unsigned int i=0;i<vec.size();i++)
+        queuePtr[i] = queue.push(i, vec[i]);
+
+    // Set 5th value to a smaller number.
+    queue.set(queuePtr[4], 0.5);
+
+    // Set error number.
+    errno = 0;
+
+    // Check that front entry is correct.
+    slsm_check(queue.peek() == 0.5, "Queue set: incorrect value!");
+
+    // Pop the entry and move another below the current bucket.
+    {
+        unsigned int addr;
+        double value;
+
+        queue.pop(addr, value);
+        slsm_check(addr == 4, "Queue set: incorrect address!");
+
+        queue.set(queuePtr[7], 0.1);
+        queue.pop(addr, value);
+        slsm_check((addr == 7) && (value == 0.1), "Queue set: incorrect entry!");
+    }
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int testClear()
+{
+    // Initialise queue.
+    slsm::UntidyQueue queue(10, 0.1);
+
+    // Set error number.
+    errno = 0;
+
+    // Fill and empty the queue several times.
+    for (int i=0;i<3;i++)
+    {
+        for (int j=0;j<10;j++)
+            queue.push(j, 10 - j);
+
+        // Pop a value so that the current bucket moves.
+        unsigned int addr;
+        double value;
+        queue.pop(addr, value);
+
+        // Remove all entries from the queue.
+        queue.clear();
+
+        // Check that the queue is empty.
+        slsm_check(queue.empty(), "Queue clear: queue is not empty!");
+    }
+
+    // Check that the queue still works.
+    for (int i=0;i<10;i++)
+        queue.push(i, i + 1);
+
+    slsm_check(queue.size() == 10, "Queue clear: incorrect queue size!");
+    slsm_check(queue.peek() == 1, "Queue clear: incorrect value at front of queue!");
+
+    return 0;
+
+error:
+    return 1;
+}
+
+int all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(testPush);
+    mu_run_test(testPop);
+    mu_run_test(testSet);
+    mu_run_test(testClear);
+
+    return 0;
+}
+
+RUN_TESTS(all_tests);